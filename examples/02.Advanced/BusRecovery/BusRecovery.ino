@@ -0,0 +1,51 @@
+/**
+ * This example contains a simple application that keeps running when a device holds the I2C bus.
+ * A device that browns out in the middle of a transaction can hold SDA low. Before every transaction the I2C
+ * functions check the lines, a stuck bus is clocked free and Wire is started again. The next Flush() writes all
+ * registers of the device again, so it continues with the current colors.
+ */
+
+#include "LP50XX.h"
+
+#define ENABLE_PIN 2
+
+LP50XX device(RGB, ENABLE_PIN);
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz available
+  Wire.setClock(400000UL);
+
+  // The pins of Wire, they are only driven while the bus is recovered. Wire is started again at 400kHz
+  LP50XXBusRecovery::Default().SetPins(SDA, SCL);
+  LP50XXBusRecovery::Default().SetClock(400000UL);
+
+  device.Begin();
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  static uint8_t step = 0;
+  static uint32_t recoveries = 0;
+
+  device.StageLEDColor(0, step, 255 - step, 0);
+  device.StageLEDColor(1, 0, step, 255 - step);
+  device.StageLEDColor(2, 255 - step, 0, step);
+  device.Flush();
+  step += 4;
+
+  LP50XXBusRecovery &recovery = LP50XXBusRecovery::Default();
+  if (recovery.GetRecoveries() != recoveries) {
+    recoveries = recovery.GetRecoveries();
+    Serial.print("Bus recovered with ");
+    Serial.print(recovery.GetLastPulses());
+    Serial.print(" clocks in ");
+    Serial.print(recovery.GetLastDuration());
+    Serial.println(" us");
+  }
+
+  delay(20);
+}
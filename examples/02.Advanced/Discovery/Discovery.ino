@@ -0,0 +1,46 @@
+/**
+ * This example contains a simple application to find the LP5009/LP5012 on the bus
+ * All devices found are combined in a chain and a pixel runs through all of them
+ */
+
+#include "LP50XX.h"
+#include "LP50XX_Chain.h"
+#include "LP50XX_Discovery.h"
+
+LP50XX devices[LP50XX_ADDRESS_COUNT];
+LP50XXDeviceInfo found[LP50XX_ADDRESS_COUNT];
+LP50XXChain chain;
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz available
+  Wire.setClock(400000UL);
+
+  uint8_t count = LP50XXDiscovery::Scan(NULL, found, LP50XX_ADDRESS_COUNT);
+  Serial.print("Found "); Serial.print(count); Serial.println(" devices");
+
+  for (uint8_t i = 0; i < count; i++) {
+    Serial.print("0x"); Serial.print(found[i].address, HEX);
+    switch (found[i].variant) {
+      case VariantLP5009: Serial.println(": LP5009"); break;
+      case VariantLP5012: Serial.println(": LP5012"); break;
+      default: Serial.println(": unknown variant"); break;
+    }
+    devices[i].SetVariant((EVariant)found[i].variant);
+    chain.Add(devices[i], found[i].address);
+  }
+  chain.Begin();
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  for (uint16_t pixel = 0; pixel < chain.GetPixelCount(); pixel++) {
+    chain.Fill(0, 0, 0);
+    chain.SetPixel(pixel, 0, 0, 255);
+    chain.Flush();
+    delay(200);
+  }
+}
@@ -0,0 +1,56 @@
+/**
+ * This example contains a simple application to set the LEDs of the LP5009/LP5012 from an interrupt.
+ * The interrupt only pushes a command into a ring, the loop applies the commands and writes them to the device.
+ */
+
+#include "LP50XX.h"
+#include "LP50XX_CommandRing.h"
+
+#define ENABLE_PIN 2
+#define BUTTON_PIN 3
+
+LP50XX device(RGB, ENABLE_PIN);
+LP50XX *devices[] = { &device };
+
+// One ring per producer: one for the interrupt, one for the loop
+LP50XXCommandRing buttonRing;
+LP50XXCommandRing loopRing;
+
+volatile uint8_t presses = 0;
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz available
+  Wire.setClock(400000UL);
+
+  device.Begin();
+
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), ButtonPressed, FALLING);
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  static uint8_t brightness = 0;
+  loopRing.PushLEDBrightness(0, 1, brightness++);
+
+  // Only this context touches the bus
+  buttonRing.Drain(devices, 1);
+  loopRing.Drain(devices, 1);
+  device.Flush();
+
+  delay(10);
+}
+
+void ButtonPressed() {
+  presses++;
+  // Toggle LED 0 between red and blue on every press
+  if (presses & 1) {
+    buttonRing.PushLEDColor(0, 0, 255, 0, 0);
+  } else {
+    buttonRing.PushLEDColor(0, 0, 0, 0, 255);
+  }
+}
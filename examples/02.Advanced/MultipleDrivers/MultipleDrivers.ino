@@ -1,8 +1,10 @@
 /**
  * This example contains a simple application to pulse output 0 of multiple LP5009/LP5012
+ * The drivers are combined in a chain, which numbers the outputs of all drivers consecutively
  */
 
 #include "LP50XX.h"
+#include "LP50XX_Chain.h"
 
 #define ENABLE_PIN_1 2
 #define ENABLE_PIN_2 3
@@ -16,6 +18,8 @@ LP50XX device2(ENABLE_PIN_2);
 // Use this if you don't have an enable pin
 // LP50XX device;
 
+LP50XXChain chain;
+
 void setup() {
   // put your setup code here, to run once:
   Serial.begin(115200);
@@ -24,20 +28,24 @@ void setup() {
   // Support for 400kHz available
   Wire.setClock(400000UL);
 
-  device.Begin(I2C_Address_1);
-  device2.Begin(I2C_Address_2);
+  chain.Add(device, I2C_Address_1);
+  chain.Add(device2, I2C_Address_2);
+  chain.Begin();
 }
 
 void loop() {
   // put your main code here, to run repeatedly:
+  // Output 0 of the second driver is output 12 of the chain
   for (int i = 0; i <= 255; i++) {
-    device.SetOutputColor(0, i);
-    device2.SetOutputColor(0, i);
+    chain.SetOutput(0, i);
+    chain.SetOutput(12, i);
+    chain.Flush();
     delay(10);
   }
   for (int i = 255; i >= 0; i--) {
-    device.SetOutputColor(0, i);
-    device2.SetOutputColor(0, i);
+    chain.SetOutput(0, i);
+    chain.SetOutput(12, i);
+    chain.Flush();
     delay(10);
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,37 @@
+/**
+ * This example contains a simple application to stream frames from a computer to multiple LP5009/LP5012 over the serial port.
+ * Frames are sent with the protocol described in LP50XX_Serial.h, e.g. with extras/tools/lp50xx_serial_send
+ */
+
+#include "LP50XX.h"
+#include "LP50XX_Serial.h"
+
+#define ENABLE_PIN_1 2
+#define ENABLE_PIN_2 3
+
+#define I2C_Address_1 0x14
+#define I2C_Address_2 0x15
+
+LP50XX device(ENABLE_PIN_1);
+LP50XX device2(ENABLE_PIN_2);
+LP50XX *devices[] = { &device, &device2 };
+
+LP50XXSerialReceiver receiver(devices, 2);
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz available
+  Wire.setClock(400000UL);
+
+  device.Begin(I2C_Address_1);
+  device2.Begin(I2C_Address_2);
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  // Stages all received bytes, flushes the devices after every frame and answers with an ACK
+  receiver.Poll(Serial);
+}
@@ -0,0 +1,133 @@
+/**
+ * This example benchmarks the compressed animation stream of the LP5009/LP5012.
+ * Sample animations for 2 drivers are encoded frame by frame and decoded straight into the shadow image of the drivers,
+ * every decoded frame is flushed to the drivers. It reports the compression ratio and the decode time per frame, the flush is not included.
+ *
+ * Precomputed animations can be encoded on a computer with extras/tools/lp50xx_anim_encode and stored in PROGMEM
+ */
+
+#include "LP50XX.h"
+#include "LP50XX_Animation.h"
+
+#define ENABLE_PIN_1 2
+#define ENABLE_PIN_2 3
+
+#define I2C_Address_1 0x14
+#define I2C_Address_2 0x15
+
+#define DEVICES 2
+#define FIRST_REGISTER LED0_BRIGHTNESS
+#define REGISTERS (OUT11_COLOR - LED0_BRIGHTNESS + 1)
+#define FRAMES 200
+#define FRAME_MS 10
+
+LP50XX device0(ENABLE_PIN_1);
+LP50XX device1(ENABLE_PIN_2);
+LP50XX *devices[DEVICES] = { &device0, &device1 };
+
+LP50XXAnimationDecoder decoder(devices, DEVICES);
+
+uint8_t previous[DEVICES][REGISTERS];
+uint8_t current[DEVICES][REGISTERS];
+uint8_t block[REGISTERS + 1];
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  while (!Serial);
+  Wire.begin();
+
+  // Support for 400kHz available
+  Wire.setClock(400000UL);
+
+  device0.Begin(I2C_Address_1);
+  device1.Begin(I2C_Address_2);
+
+  Serial.println("Animation     Raw   Encoded  Ratio  Decode us/frame  Cycles/frame");
+  Benchmark("Rainbow", 0);
+  Benchmark("Pulse", 1);
+  Benchmark("Twinkle", 2);
+}
+
+void loop() {
+  
+}
+
+void Benchmark(const char *name, uint8_t animation) {
+  uint8_t header[LP50XX_ANIMATION_HEADER_SIZE];
+  uint32_t encoded = LP50XXAnimationEncoder::EncodeHeader(DEVICES, FIRST_REGISTER, REGISTERS, FRAMES, header);
+  uint32_t decodeTime = 0;
+
+  decoder.Reset();
+  for (uint8_t i = 0; i < LP50XX_ANIMATION_HEADER_SIZE; i++) {
+    decoder.Feed(header[i]);
+  }
+
+  for (uint16_t frame = 0; frame < FRAMES; frame++) {
+    Render(animation, frame);
+
+    for (uint8_t device = 0; device < DEVICES; device++) {
+      uint8_t length = LP50XXAnimationEncoder::EncodeDevice(frame ? previous[device] : NULL, current[device], REGISTERS, block);
+      encoded += length;
+
+      uint32_t start = micros();
+      for (uint8_t i = 0; i < length; i++) {
+        decoder.Feed(block[i]);
+      }
+      decodeTime += micros() - start;
+    }
+
+    // Only the registers that changed since the last frame are written
+    for (uint8_t device = 0; device < DEVICES; device++) {
+      devices[device]->Flush();
+    }
+    delay(FRAME_MS);
+
+    memcpy(previous, current, sizeof(current));
+  }
+
+  uint32_t raw = (uint32_t)FRAMES * DEVICES * REGISTERS;
+  Serial.print(name);
+  Serial.print("\t");
+  Serial.print(raw);
+  Serial.print("\t");
+  Serial.print(encoded);
+  Serial.print("\t");
+  Serial.print((float)raw / encoded);
+  Serial.print("\t");
+  Serial.print((float)decodeTime / FRAMES);
+  Serial.print("\t\t");
+  Serial.println((float)decodeTime / FRAMES * (F_CPU / 1000000UL));
+}
+
+void Render(uint8_t animation, uint16_t frame) {
+  for (uint8_t device = 0; device < DEVICES; device++) {
+    uint8_t *registers = current[device];
+    switch (animation) {
+    case 0:
+      // Every output changes every frame
+      for (uint8_t led = 0; led < 4; led++) {
+        registers[led] = 0xFF;
+        uint8_t position = frame * 3 + (device * 4 + led) * 16;
+        registers[4 + led * 3] = position;
+        registers[4 + led * 3 + 1] = 255 - position;
+        registers[4 + led * 3 + 2] = position * 2;
+      }
+      break;
+    case 1:
+      // One LED per driver slowly pulses
+      memset(registers, 0, REGISTERS);
+      registers[device] = 0xFF;
+      registers[4 + device * 3] = (frame / 4) & 0x80 ? ~(frame / 2) : frame / 2;
+      break;
+    case 2:
+      // A few random outputs change every frame
+      if (frame == 0) {
+        memset(registers, 0, REGISTERS);
+        memset(registers, 0xFF, 4);
+      }
+      registers[4 + random(12)] = random(256);
+      break;
+    }
+  }
+}
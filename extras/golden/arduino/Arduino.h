@@ -0,0 +1,154 @@
+/**
+ * @file Arduino.h
+ * @brief Host version of the Arduino core functions used by the library and the examples, implemented by
+ * lp50xx_golden.cpp on a simulated clock
+ */
+#ifndef __LP50XX_GOLDEN_ARDUINO_H
+#define __LP50XX_GOLDEN_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#define F_CPU 16000000UL
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+static const uint8_t SDA = 18;
+static const uint8_t SCL = 19;
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define F(string) (string)
+#define digitalPinToInterrupt(pin) (pin)
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+/**
+ * @brief The subset of the Arduino String used by the examples
+ */
+class String
+{
+    public:
+        String(const char *value = "") : _value(value) {}
+        String(int value, unsigned char base = DEC) : _value(format(value, base)) {}
+        String(unsigned value, unsigned char base = DEC) : _value(format(value, base)) {}
+        String(long value, unsigned char base = DEC) : _value(format(value, base)) {}
+        String(unsigned long value, unsigned char base = DEC) : _value(format(value, base)) {}
+
+        const char *c_str() const { return _value.c_str(); }
+        unsigned int length() const { return _value.length(); }
+        String &operator+=(const String &other) { _value += other._value; return *this; }
+        friend String operator+(const String &left, const String &right) { String result(left); result += right; return result; }
+        friend String operator+(const char *left, const String &right) { return String(left) + right; }
+
+    private:
+        std::string _value;
+
+        static std::string format(unsigned long value, unsigned char base);
+        static std::string format(long value, unsigned char base);
+        static std::string format(int value, unsigned char base) { return format((long)value, base); }
+        static std::string format(unsigned value, unsigned char base) { return format((unsigned long)value, base); }
+};
+
+/**
+ * @brief Text and binary output
+ */
+class Print
+{
+    public:
+        virtual size_t write(uint8_t value) = 0;
+        virtual size_t write(const uint8_t *buffer, size_t size);
+        size_t write(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+
+        size_t print(const char *text) { return write(text); }
+        size_t print(const String &text) { return write(text.c_str()); }
+        size_t print(char value) { return write((uint8_t)value); }
+        size_t print(int value, int base = DEC) { return print((long)value, base); }
+        size_t print(unsigned value, int base = DEC) { return print((unsigned long)value, base); }
+        size_t print(long value, int base = DEC);
+        size_t print(unsigned long value, int base = DEC);
+        size_t print(double value, int digits = 2);
+
+        template <typename T> size_t println(T value) { return print(value) + println(); }
+        template <typename T> size_t println(T value, int format) { return print(value, format) + println(); }
+        size_t println() { return write("\r\n"); }
+
+    protected:
+        ~Print() {}
+};
+
+/**
+ * @brief Input on top of the output
+ */
+class Stream : public Print
+{
+    public:
+        virtual int available() = 0;
+        virtual int read() = 0;
+        virtual int peek() = 0;
+        virtual void flush() {}
+
+    protected:
+        ~Stream() {}
+};
+
+/**
+ * @brief The serial port, output goes to the standard output when enabled, input comes from the harness
+ */
+class HardwareSerial : public Stream
+{
+    public:
+        void begin(unsigned long baud);
+        void end() {}
+        operator bool() { return true; }
+
+        size_t write(uint8_t value);
+        size_t write(const uint8_t *buffer, size_t size);
+        using Print::write;
+        int available();
+        int read();
+        int peek();
+
+        uint32_t GetTransmitted() { return _transmitted; }
+
+    private:
+        uint32_t _transmitted = 0;
+};
+
+extern HardwareSerial Serial;
+
+#endif
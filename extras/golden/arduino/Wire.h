@@ -0,0 +1,53 @@
+/**
+ * @file Wire.h
+ * @brief Host version of the Arduino TwoWire bus, every transaction goes to the simulated devices and into the
+ * recorded trace of lp50xx_golden.cpp
+ */
+#ifndef __LP50XX_GOLDEN_WIRE_H
+#define __LP50XX_GOLDEN_WIRE_H
+
+#include "Arduino.h"
+
+#define LP50XX_GOLDEN_WIRE_BUFFER 32
+#define WIRE_HAS_TIMEOUT
+
+/**
+ * @brief Simulated I2C controller
+ */
+class TwoWire : public Stream
+{
+    public:
+        void begin() {}
+        void end() {}
+        void setClock(uint32_t clockHz);
+        void setWireTimeout(uint32_t timeoutUs = 25000, bool resetWithTimeout = false) { _timeout_us = timeoutUs; }
+        uint32_t getWireTimeout() { return _timeout_us; }
+
+        void beginTransmission(uint8_t address);
+        void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+        uint8_t endTransmission(bool sendStop = true);
+        uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop = 1);
+        uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (uint8_t)quantity); }
+
+        size_t write(uint8_t value);
+        size_t write(const uint8_t *buffer, size_t size);
+        using Print::write;
+        int available();
+        int read();
+        int peek();
+
+    private:
+        uint8_t     _address = 0;
+        uint8_t     _buffer[LP50XX_GOLDEN_WIRE_BUFFER];
+        uint8_t     _length = 0;
+        bool        _overflow = false;
+        int16_t     _pending = -1;      // Register address sent without a stop, -1 for none
+        uint8_t     _received[LP50XX_GOLDEN_WIRE_BUFFER];
+        uint8_t     _received_length = 0;
+        uint8_t     _received_index = 0;
+        uint32_t    _timeout_us = 25000;
+};
+
+extern TwoWire Wire;
+
+#endif
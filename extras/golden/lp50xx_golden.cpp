@@ -0,0 +1,801 @@
+/**
+ * @file lp50xx_golden.cpp
+ * @brief Host harness that runs an example sketch for a fixed simulated time and records or checks its bus traffic
+ *
+ * Built and run for every sketch in examples/ by run.sh, which links this file, the Arduino core in arduino/, the
+ * library and the sketch. The simulated bus has an LP5012 at 0x14 and 0x15 and an LP5009 at 0x16, every other
+ * address does not acknowledge. Time only advances with delay(), the wire time of the transactions at the clock
+ * set with Wire.setClock() (see @ref LP50XXBusTiming) and 10 us per loop() call, so every run is identical.
+ * Interrupts attached with attachInterrupt() fire every 500 ms of simulated time.
+ *
+ * With -s the device at 0x14 browns out in the first transaction to it after the given time: its registers reset
+ * and it holds SDA low until SCL was clocked @ref STUCK_CLOCKS times with the pins of Wire, see
+ * @ref LP50XX_BusRecovery.h. Until then every transaction times out after the timeout of Wire.setWireTimeout(). The
+ * run prints when the bus was released and when all registers of 0x14 were written again.
+ *
+ * The trace is a text file with one transaction per line: `W addr reg data` for a write, `R addr reg data` for a
+ * register read (`--` for a read without register address), `P addr` for a probe, all hexadecimal, followed by
+ * `!status` when the transaction failed. `F time` (in us) marks every delay() call, where the sketch waits and the
+ * register state of the devices is compared. `B addr` marks the brownout of a device.
+ *
+ * With a golden trace the run fails when the register state of a device differs from the golden run at any common
+ * delay() call, or when the bus carried more bytes until the last common delay() call. A different trace with the
+ * same register state and fewer bytes passes with a note, refresh the golden trace to keep the gain.
+ *
+ * Usage: sketch [-d ms] [-f serial frames] [-s ms] [-v] [-o trace] [-g golden trace]
+ *        -d  Simulated time, 3000 ms by default
+ *        -f  Frames for the SerialStreaming protocol that arrive on Serial, one every 20 ms at 115200 baud
+ *        -s  Time of the brownout of 0x14 that holds the bus, none by default
+ *        -v  Print the Serial output of the sketch
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "LP50XX.h"
+#include "LP50XX_BusTiming.h"
+#include "LP50XX_Serial.h"
+
+#define LOOP_NS 10000ULL                // Time of one loop() call besides its delays and transactions
+#define INTERRUPT_NS 500000000ULL       // Period of the attached interrupts
+#define SERIAL_FRAME_NS 20000000ULL     // Period of the generated serial frames
+#define SERIAL_BYTE_NS 86806ULL         // 10 bits at 115200 baud
+#define MAX_INTERRUPTS 4
+#define STUCK_ADDRESS 0x14              // Device that browns out with -s
+#define STUCK_CLOCKS 7                  // Clocks until it has shifted out the rest of its byte and releases SDA
+
+void setup();
+void loop();
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+/*----------------------- Simulation ----------------------------------------*/
+
+/**
+ * @brief Thrown by delay() when the simulated time is over
+ */
+struct SimulationEnd {};
+
+/**
+ * @brief Register file of one simulated device
+ */
+struct SimDevice {
+    uint8_t address;
+    uint8_t variant;
+    uint8_t registers[LP50XX_REGISTER_COUNT];
+    uint32_t written;           // Registers written since the last brownout
+
+    void Reset() {
+        memset(registers, 0, sizeof(registers));
+        registers[DEVICE_CONFIG1] = LOG_SCALE_ON | POWER_SAVE_ON | AUTO_INC_ON | PWM_DITHERING_ON;
+        registers[BANK_BRIGHTNESS] = 0xFF;
+        for (uint8_t led = 0; led < (variant == VariantLP5009 ? 3 : 4); led++) {
+            registers[LED0_BRIGHTNESS + led] = 0xFF;
+        }
+    }
+
+    bool Exists(uint8_t reg) {
+        if (variant == VariantLP5009) {
+            return reg < LP5009_REGISTER_COUNT && reg != LED3_BRIGHTNESS;
+        }
+        return reg < LP50XX_REGISTER_COUNT;
+    }
+
+    void Write(uint8_t reg, const uint8_t *pdata, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (reg == RESET_REGISTERS && pdata[i] == 0xFF) {
+                Reset();
+            } else if (Exists(reg)) {
+                registers[reg] = pdata[i];
+                written |= 1UL << reg;
+            }
+            if (registers[DEVICE_CONFIG1] & AUTO_INC_ON) {
+                reg++;
+            }
+        }
+    }
+
+    void Read(uint8_t reg, uint8_t *pdata, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            pdata[i] = Exists(reg) ? registers[reg] : 0;
+            if (registers[DEVICE_CONFIG1] & AUTO_INC_ON) {
+                reg++;
+            }
+        }
+    }
+};
+
+/**
+ * @brief The devices on the simulated bus
+ */
+struct SimBus {
+    SimDevice devices[3];
+
+    SimBus() {
+        devices[0].address = 0x14;
+        devices[0].variant = VariantLP5012;
+        devices[1].address = 0x15;
+        devices[1].variant = VariantLP5012;
+        devices[2].address = 0x16;
+        devices[2].variant = VariantLP5009;
+        for (uint8_t i = 0; i < 3; i++) {
+            devices[i].Reset();
+            devices[i].written = 0;
+        }
+    }
+
+    SimDevice *Find(uint8_t address) {
+        for (uint8_t i = 0; i < 3; i++) {
+            if (devices[i].address == address) {
+                return &devices[i];
+            }
+        }
+        return NULL;
+    }
+
+    bool Acknowledges(uint8_t address) {
+        return address == BROADCAST_ADDRESS || Find(address) != NULL;
+    }
+
+    void Write(uint8_t address, uint8_t reg, const uint8_t *pdata, uint32_t count) {
+        for (uint8_t i = 0; i < 3; i++) {
+            if (address == BROADCAST_ADDRESS || devices[i].address == address) {
+                devices[i].Write(reg, pdata, count);
+            }
+        }
+    }
+};
+
+/**
+ * @brief One recorded transaction or delay() call
+ */
+struct Event {
+    char type;                  // W, R, P, F or B
+    uint8_t address;
+    int16_t reg;                // -1 for a probe, a delay() call or a read without register address
+    uint8_t status;
+    uint64_t timeUs;            // Only for F
+    std::vector<uint8_t> data;
+
+    uint32_t Bytes() const {
+        switch (type)
+        {
+        case 'W': return status == 2 ? 1 : 2 + data.size();
+        case 'R': return status == 2 ? 2 : (reg >= 0 ? 3 : 1) + data.size();
+        case 'P': return 1;
+        default: return 0;
+        }
+    }
+};
+
+static uint64_t now = 0;
+static uint64_t limit = 3000000000ULL;
+static uint64_t nextInterrupt = INTERRUPT_NS;
+static void (*interruptHandlers[MAX_INTERRUPTS])(void);
+static uint8_t interruptCount = 0;
+static bool verbose = false;
+static uint32_t randomState = 1;
+static LP50XXBusTiming timing(LP50XX_I2C_STANDARD);
+static SimBus bus;
+static std::vector<Event> trace;
+static std::vector<std::pair<uint64_t, uint8_t> > serialInput;
+static size_t serialIndex = 0;
+static uint8_t pinModes[256];
+static uint8_t pinLevels[256];
+static uint64_t brownoutNs = 0;         // 0 for no brownout
+static uint64_t stuckNs = 0;            // Time of the brownout, 0 before it
+static uint64_t releasedNs = 0;         // Time SDA was released, 0 before it
+static uint64_t resyncNs = 0;           // Time all registers of the device were written again, 0 before it
+static uint8_t stuckClocks = 0;
+
+/**
+ * @brief Advances the simulated time and fires the interrupts that are due
+ */
+static void advance(uint64_t ns) {
+    uint64_t target = now + ns;
+    while (interruptCount > 0 && nextInterrupt <= target) {
+        now = nextInterrupt;
+        nextInterrupt += INTERRUPT_NS;
+        for (uint8_t i = 0; i < interruptCount; i++) {
+            interruptHandlers[i]();
+        }
+    }
+    now = target > now ? target : now;
+}
+
+/**
+ * @brief Returns whether the device at 0x14 holds SDA low
+ */
+static bool sdaStuck() {
+    return stuckNs != 0 && releasedNs == 0;
+}
+
+/**
+ * @brief Browns out the device at 0x14 in the first transaction to it after the time of -s
+ *
+ * @param address The address of the transaction
+ * @return true when the bus is stuck and the transaction times out
+ */
+static bool busStuck(uint8_t address) {
+    if (brownoutNs != 0 && stuckNs == 0 && now >= brownoutNs && address == STUCK_ADDRESS) {
+        stuckNs = now;
+        SimDevice *device = bus.Find(STUCK_ADDRESS);
+        device->Reset();
+        Event event = { 'B', STUCK_ADDRESS, -1, 0, 0, {} };
+        trace.push_back(event);
+    }
+    return sdaStuck();
+}
+
+/**
+ * @brief Checks whether all registers of the device at 0x14 were written since SDA was released
+ */
+static void checkResync() {
+    SimDevice *device = bus.Find(STUCK_ADDRESS);
+    if (releasedNs == 0 || resyncNs != 0) {
+        return;
+    }
+    for (uint8_t reg = 0; reg < RESET_REGISTERS; reg++) {
+        if (device->Exists(reg) && !(device->written >> reg & 1)) {
+            return;
+        }
+    }
+    resyncNs = now;
+}
+
+/**
+ * @brief Returns whether a pin pulls its line low
+ */
+static bool lineLow(uint8_t pin) {
+    return pinModes[pin] == OUTPUT && pinLevels[pin] == LOW;
+}
+
+/**
+ * @brief Counts the clocks on SCL while SDA is stuck, the device releases SDA after @ref STUCK_CLOCKS
+ */
+static void updateLine(uint8_t pin, bool wasLow) {
+    if (pin == SCL && wasLow && !lineLow(pin) && sdaStuck() && ++stuckClocks >= STUCK_CLOCKS) {
+        releasedNs = now;
+        bus.Find(STUCK_ADDRESS)->written = 0;
+    }
+}
+
+/*----------------------- Arduino core --------------------------------------*/
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    bool wasLow = lineLow(pin);
+    pinModes[pin] = mode;
+    updateLine(pin, wasLow);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    bool wasLow = lineLow(pin);
+    pinLevels[pin] = value;
+    updateLine(pin, wasLow);
+}
+
+int digitalRead(uint8_t pin) {
+    if (pin == SDA && sdaStuck()) {
+        return LOW;
+    }
+    return lineLow(pin) ? LOW : HIGH;
+}
+void noInterrupts() {}
+void interrupts() {}
+void yield() {}
+
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode) {
+    if (interruptCount < MAX_INTERRUPTS) {
+        interruptHandlers[interruptCount++] = isr;
+    }
+}
+
+void detachInterrupt(uint8_t interrupt) {
+    interruptCount = 0;
+}
+
+unsigned long millis() {
+    return now / 1000000;
+}
+
+unsigned long micros() {
+    return now / 1000;
+}
+
+void delay(unsigned long ms) {
+    Event event = { 'F', 0, -1, 0, now / 1000, {} };
+    trace.push_back(event);
+    advance(ms * 1000000ULL);
+    if (now >= limit) {
+        throw SimulationEnd();
+    }
+}
+
+void delayMicroseconds(unsigned int us) {
+    advance(us * 1000ULL);
+}
+
+long random(long max) {
+    // Numerical Recipes LCG, the same sequence on every host
+    randomState = randomState * 1664525UL + 1013904223UL;
+    return max > 0 ? (long)((randomState >> 8) % (uint32_t)max) : 0;
+}
+
+long random(long min, long max) {
+    return min + random(max - min);
+}
+
+void randomSeed(unsigned long seed) {
+    randomState = seed;
+}
+
+std::string String::format(unsigned long value, unsigned char base) {
+    char buff[8 * sizeof(long) + 1];
+    char *p = &buff[sizeof(buff) - 1];
+    *p = 0;
+    do {
+        uint8_t digit = value % base;
+        *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= base;
+    } while (value != 0);
+    return p;
+}
+
+std::string String::format(long value, unsigned char base) {
+    if (value < 0 && base == DEC) {
+        return "-" + format((unsigned long)-value, base);
+    }
+    return format((unsigned long)value, base);
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t count = 0;
+    while (size-- > 0) {
+        count += write(*buffer++);
+    }
+    return count;
+}
+
+size_t Print::print(long value, int base) {
+    return print(String(value, base));
+}
+
+size_t Print::print(unsigned long value, int base) {
+    return print(String(value, base));
+}
+
+size_t Print::print(double value, int digits) {
+    char buff[32];
+    snprintf(buff, sizeof(buff), "%.*f", digits, value);
+    return print(buff);
+}
+
+void HardwareSerial::begin(unsigned long baud) {}
+
+size_t HardwareSerial::write(uint8_t value) {
+    _transmitted++;
+    if (verbose) {
+        putchar(value);
+    }
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    return Print::write(buffer, size);
+}
+
+int HardwareSerial::available() {
+    size_t count = 0;
+    while (serialIndex + count < serialInput.size() && serialInput[serialIndex + count].first <= now) {
+        count++;
+    }
+    return count;
+}
+
+int HardwareSerial::read() {
+    if (available() == 0) {
+        return -1;
+    }
+    return serialInput[serialIndex++].second;
+}
+
+int HardwareSerial::peek() {
+    return available() > 0 ? serialInput[serialIndex].second : -1;
+}
+
+void TwoWire::setClock(uint32_t clockHz) {
+    timing.SetClock(clockHz);
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    _address = address;
+    _length = 0;
+    _overflow = false;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    if (_overflow) {
+        return 1;
+    }
+    if (busStuck(_address)) {
+        Event event = { (char)(_length == 0 ? 'P' : (!sendStop && _length == 1 ? 'R' : 'W')), _address,
+                        (int16_t)(_length > 0 ? _buffer[0] : -1), 5, 0, {} };
+        if (_length > 1) {
+            event.data.assign(&_buffer[1], &_buffer[_length]);
+        }
+        trace.push_back(event);
+        advance(_timeout_us * 1000ULL);
+        _pending = -1;
+        return 5;
+    }
+    bool acknowledged = bus.Acknowledges(_address);
+    if (!sendStop && _length == 1) {
+        // Register address of a read, the transaction continues with requestFrom()
+        _pending = acknowledged ? _buffer[0] : -2;
+        return acknowledged ? 0 : 2;
+    }
+
+    Event event = { _length == 0 ? 'P' : 'W', _address, (int16_t)(_length > 0 ? _buffer[0] : -1), (uint8_t)(acknowledged ? 0 : 2), 0, {} };
+    if (_length > 1) {
+        event.data.assign(&_buffer[1], &_buffer[_length]);
+    }
+    trace.push_back(event);
+    if (event.type == 'P') {
+        advance(timing.GetProbeTime());
+    } else {
+        advance(acknowledged ? timing.GetWriteTime(_length - 1) : timing.GetProbeTime());
+    }
+    if (acknowledged && _length > 0) {
+        bus.Write(_address, _buffer[0], &_buffer[1], _length - 1);
+        checkResync();
+    }
+    return event.status;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop) {
+    SimDevice *device = address != BROADCAST_ADDRESS ? bus.Find(address) : NULL;
+    Event event = { 'R', address, _pending >= 0 ? _pending : (int16_t)-1, 0, 0, {} };
+    bool failed = device == NULL || _pending == -2;
+    _pending = -1;
+    _received_length = 0;
+    _received_index = 0;
+    if (quantity > LP50XX_GOLDEN_WIRE_BUFFER) {
+        quantity = LP50XX_GOLDEN_WIRE_BUFFER;
+    }
+
+    if (busStuck(address)) {
+        event.status = 5;
+        trace.push_back(event);
+        advance(_timeout_us * 1000ULL);
+        return 0;
+    }
+    if (failed) {
+        event.status = 2;
+        trace.push_back(event);
+        advance(2 * timing.GetProbeTime());
+        return 0;
+    }
+    device->Read(event.reg >= 0 ? event.reg : 0, _received, quantity);
+    _received_length = quantity;
+    event.data.assign(_received, _received + quantity);
+    trace.push_back(event);
+    advance(timing.GetReadTime(quantity));
+    return quantity;
+}
+
+size_t TwoWire::write(uint8_t value) {
+    if (_length >= LP50XX_GOLDEN_WIRE_BUFFER) {
+        _overflow = true;
+        return 0;
+    }
+    _buffer[_length++] = value;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *buffer, size_t size) {
+    size_t count = 0;
+    while (size-- > 0) {
+        count += write(*buffer++);
+    }
+    return count;
+}
+
+int TwoWire::available() {
+    return _received_length - _received_index;
+}
+
+int TwoWire::read() {
+    return available() > 0 ? _received[_received_index++] : -1;
+}
+
+int TwoWire::peek() {
+    return available() > 0 ? _received[_received_index] : -1;
+}
+
+/*----------------------- Traces --------------------------------------------*/
+
+/**
+ * @brief Queues frames of the serial protocol for two devices, the bytes arrive at the speed of the port
+ */
+static void generateSerialFrames(int frames) {
+    uint8_t packet[64];
+    uint64_t arrival = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        uint64_t start = frame * SERIAL_FRAME_NS;
+        arrival = arrival > start ? arrival : start;
+        for (uint8_t device = 0; device < 2; device++) {
+            uint8_t outputs[12];
+            for (uint8_t i = 0; i < 12; i++) {
+                outputs[i] = frame * 8 + i * 20 + device * 128;
+            }
+            uint8_t length = LP50XXSerialEncoder::EncodePacket(device, OUT0_COLOR, outputs, 12, device == 1, packet);
+            for (uint8_t i = 0; i < length; i++) {
+                arrival += SERIAL_BYTE_NS;
+                serialInput.push_back(std::make_pair(arrival, packet[i]));
+            }
+        }
+    }
+}
+
+static bool writeTrace(const char *path, const char *options) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        perror(path);
+        return false;
+    }
+    fprintf(out, "# LP50XX golden trace\n# options %s\n", options);
+    for (size_t i = 0; i < trace.size(); i++) {
+        const Event &event = trace[i];
+        if (event.type == 'F') {
+            fprintf(out, "F %llu\n", (unsigned long long)event.timeUs);
+            continue;
+        }
+        fprintf(out, "%c %02X", event.type, event.address);
+        if (event.type != 'P' && event.type != 'B') {
+            if (event.reg >= 0) {
+                fprintf(out, " %02X", event.reg);
+            } else {
+                fprintf(out, " --");
+            }
+        }
+        for (size_t j = 0; j < event.data.size(); j++) {
+            fprintf(out, " %02X", event.data[j]);
+        }
+        if (event.status != 0) {
+            fprintf(out, " !%u", event.status);
+        }
+        fprintf(out, "\n");
+    }
+    fclose(out);
+    return true;
+}
+
+static bool readTrace(const char *path, std::vector<Event> &events) {
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        perror(path);
+        return false;
+    }
+    char line[1024];
+    while (fgets(line, sizeof(line), in) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        Event event = { line[0], 0, -1, 0, 0, {} };
+        char *p = &line[1];
+        if (event.type == 'F') {
+            event.timeUs = strtoull(p, NULL, 10);
+            events.push_back(event);
+            continue;
+        }
+        event.address = strtoul(p, &p, 16);
+        if (event.type != 'P' && event.type != 'B') {
+            while (*p == ' ') {
+                p++;
+            }
+            if (strncmp(p, "--", 2) == 0) {
+                p += 2;
+            } else {
+                event.reg = strtoul(p, &p, 16);
+            }
+        }
+        for (;;) {
+            while (*p == ' ') {
+                p++;
+            }
+            if (*p == '!') {
+                event.status = atoi(p + 1);
+                break;
+            }
+            char *end;
+            unsigned long value = strtoul(p, &end, 16);
+            if (end == p) {
+                break;
+            }
+            event.data.push_back(value);
+            p = end;
+        }
+        events.push_back(event);
+    }
+    fclose(in);
+    return true;
+}
+
+/**
+ * @brief Replays a trace on a fresh simulated bus up to a delay() call
+ *
+ * @param events The trace
+ * @param index The position in the trace, advanced to after the next delay() call
+ * @param replay The bus
+ * @param bytes Incremented by the bus bytes of the replayed transactions
+ * @return true A delay() call was reached
+ */
+static bool replay(const std::vector<Event> &events, size_t &index, SimBus &replay, uint64_t &bytes) {
+    while (index < events.size()) {
+        const Event &event = events[index++];
+        if (event.type == 'F') {
+            return true;
+        }
+        bytes += event.Bytes();
+        if (event.type == 'W' && event.status == 0 && event.reg >= 0) {
+            replay.Write(event.address, event.reg, event.data.data(), event.data.size());
+        } else if (event.type == 'B') {
+            replay.Find(event.address)->Reset();
+        }
+    }
+    return false;
+}
+
+static bool sameTraces(const std::vector<Event> &a, const std::vector<Event> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].type != b[i].type || a[i].address != b[i].address || a[i].reg != b[i].reg || a[i].status != b[i].status ||
+            a[i].timeUs != b[i].timeUs || a[i].data != b[i].data) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Compares the register state of the devices of two replays
+ *
+ * @return true The register state is the same
+ */
+static bool sameState(const char *name, SimBus &golden, SimBus &actual, const char *when) {
+    for (uint8_t device = 0; device < 3; device++) {
+        const SimDevice &g = golden.devices[device];
+        const SimDevice &a = actual.devices[device];
+        for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+            if (g.registers[reg] != a.registers[reg]) {
+                printf("%s: FAIL register 0x%02X of 0x%02X is 0x%02X instead of 0x%02X %s\n", name, reg, g.address,
+                       a.registers[reg], g.registers[reg], when);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Compares the recorded trace with the golden trace
+ *
+ * @return int 0 when the register state matches and the bus bytes did not increase
+ */
+static int compare(const char *name, const std::vector<Event> &golden) {
+    SimBus goldenBus, actualBus;
+    size_t goldenIndex = 0, actualIndex = 0;
+    uint64_t goldenBytes = 0, actualBytes = 0;
+    uint32_t frames = 0;
+    char when[64];
+
+    for (;;) {
+        bool goldenFrame = replay(golden, goldenIndex, goldenBus, goldenBytes);
+        bool actualFrame = replay(trace, actualIndex, actualBus, actualBytes);
+        if (!goldenFrame && !actualFrame) {
+            // Both runs ended after the same delay() calls, the rest of the traces is comparable as well
+            if (!sameState(name, goldenBus, actualBus, "at the end")) {
+                return 1;
+            }
+            break;
+        }
+        if (!goldenFrame || !actualFrame) {
+            break;
+        }
+        snprintf(when, sizeof(when), "at delay %lu (%llu us)", (unsigned long)frames, (unsigned long long)trace[actualIndex - 1].timeUs);
+        if (!sameState(name, goldenBus, actualBus, when)) {
+            return 1;
+        }
+        frames++;
+    }
+
+    if (actualBytes > goldenBytes) {
+        printf("%s: FAIL %llu bus bytes instead of %llu until delay %lu\n", name, (unsigned long long)actualBytes,
+               (unsigned long long)goldenBytes, (unsigned long)frames);
+        return 1;
+    }
+    if (sameTraces(trace, golden)) {
+        printf("%s: OK, %lu delays, %llu bus bytes\n", name, (unsigned long)frames, (unsigned long long)actualBytes);
+    } else {
+        printf("%s: OK, trace changed with the same register state, %llu instead of %llu bus bytes until delay %lu\n", name,
+               (unsigned long long)actualBytes, (unsigned long long)goldenBytes, (unsigned long)frames);
+    }
+    return 0;
+}
+
+/*----------------------- Main ----------------------------------------------*/
+
+int main(int argc, char **argv) {
+    unsigned long durationMs = 3000;
+    int serialFrames = 0;
+    unsigned long stuckMs = 0;
+    const char *outputPath = NULL;
+    const char *goldenPath = NULL;
+
+    int option;
+    while ((option = getopt(argc, argv, "d:f:s:vo:g:")) != -1) {
+        switch (option)
+        {
+        case 'd': durationMs = strtoul(optarg, NULL, 0); break;
+        case 'f': serialFrames = atoi(optarg); break;
+        case 's': stuckMs = strtoul(optarg, NULL, 0); break;
+        case 'v': verbose = true; break;
+        case 'o': outputPath = optarg; break;
+        case 'g': goldenPath = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-d ms] [-f serial frames] [-s ms] [-v] [-o trace] [-g golden trace]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    limit = durationMs * 1000000ULL;
+    brownoutNs = stuckMs * 1000000ULL;
+    generateSerialFrames(serialFrames);
+
+    try {
+        setup();
+        while (now < limit) {
+            loop();
+            advance(LOOP_NS);
+        }
+    } catch (const SimulationEnd &) {
+    }
+
+    char options[64];
+    int length = snprintf(options, sizeof(options), "-d %lu -f %d", durationMs, serialFrames);
+    if (stuckMs != 0) {
+        snprintf(options + length, sizeof(options) - length, " -s %lu", stuckMs);
+    }
+    if (stuckNs != 0) {
+        printf("SDA held by 0x%02X at %llu us", STUCK_ADDRESS, (unsigned long long)(stuckNs / 1000));
+        if (releasedNs != 0) {
+            printf(", released after %u clocks at %llu us", stuckClocks, (unsigned long long)(releasedNs / 1000));
+        }
+        if (resyncNs != 0) {
+            printf(", registers written again at %llu us, %llu us after the brownout", (unsigned long long)(resyncNs / 1000),
+                   (unsigned long long)((resyncNs - stuckNs) / 1000));
+        }
+        printf("\n");
+    }
+    if (outputPath != NULL && !writeTrace(outputPath, options)) {
+        return 2;
+    }
+    if (goldenPath != NULL) {
+        std::vector<Event> golden;
+        if (!readTrace(goldenPath, golden)) {
+            return 2;
+        }
+        const char *name = strrchr(goldenPath, '/');
+        std::string sketch(name != NULL ? name + 1 : goldenPath);
+        return compare(sketch.substr(0, sketch.rfind(".trace")).c_str(), golden);
+    }
+    return 0;
+}
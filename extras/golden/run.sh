@@ -0,0 +1,59 @@
+#!/bin/sh
+# Runs every example sketch on the simulated bus of lp50xx_golden.cpp and compares its bus traffic with the
+# golden trace in traces/<sketch>.trace. Exits with 1 when a sketch fails.
+#
+# Usage: extras/golden/run.sh [sketch...]
+#        UPDATE=1 extras/golden/run.sh    Records the golden traces instead of checking them
+#
+# A new sketch without a golden trace fails until its trace is recorded. The options of a sketch, e.g. the
+# simulated time, are kept in the "# options" line of its trace.
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+GOLDEN=$ROOT/extras/golden
+BUILD=${BUILD:-$ROOT/_golden_build}
+CXX=${CXX:-g++}
+CXXFLAGS="-DARDUINO=10819 -std=gnu++11 -O1 -w -I$GOLDEN/arduino -I$ROOT/src"
+
+mkdir -p "$BUILD/obj" || exit 2
+
+# Library and harness are compiled once for all sketches
+for source in "$ROOT"/src/*.cpp "$GOLDEN/lp50xx_golden.cpp"; do
+    object=$BUILD/obj/$(basename "$source" .cpp).o
+    if [ ! -f "$object" ] || [ "$source" -nt "$object" ] || [ -n "$(find "$ROOT/src" "$GOLDEN/arduino" -newer "$object" -name '*.h')" ]; then
+        $CXX $CXXFLAGS -c "$source" -o "$object" || exit 2
+    fi
+done
+
+if [ $# -eq 0 ]; then
+    set -- $(find "$ROOT/examples" -name '*.ino' | sort)
+fi
+
+failed=0
+for sketch in "$@"; do
+    name=$(basename "$sketch" .ino)
+    trace=$GOLDEN/traces/$name.trace
+    source=$BUILD/$name.cpp
+
+    # Like the Arduino builder, declare the functions of the sketch before its code
+    {
+        echo '#include <Arduino.h>'
+        grep -E '^[A-Za-z_][A-Za-z0-9_ *&]* [*&]?[A-Za-z_][A-Za-z0-9_]* *\([^;]*\) *\{ *$' "$sketch" | sed 's/ *{ *$/;/'
+        echo "#line 1 \"$sketch\""
+        cat "$sketch"
+    } > "$source"
+    $CXX $CXXFLAGS "$source" "$BUILD"/obj/*.o -o "$BUILD/$name" -lpthread || { echo "$name: FAIL build"; failed=1; continue; }
+
+    options=""
+    if [ -f "$trace" ]; then
+        options=$(sed -n 's/^# options //p' "$trace")
+    fi
+    if [ -n "$UPDATE" ]; then
+        "$BUILD/$name" $options -o "$trace" && echo "$name: recorded $(grep -c '^[WRP]' "$trace") transactions" || failed=1
+    elif [ -f "$trace" ]; then
+        "$BUILD/$name" $options -g "$trace" || failed=1
+    else
+        echo "$name: FAIL no golden trace, record it with UPDATE=1"
+        failed=1
+    fi
+done
+exit $failed
@@ -0,0 +1,113 @@
+/**
+ * @file lp50xx_anim_encode.cpp
+ * @brief Host tool that encodes raw register frames into a compressed LP50XX animation stream
+ *
+ * Build: g++ -O2 -I../../src -o lp50xx_anim_encode lp50xx_anim_encode.cpp ../../src/LP50XX_AnimationEncoder.cpp
+ *
+ * The input file holds the frames back to back. Every frame holds the register window of every device,
+ * so a frame is (devices * registers) bytes. The default window covers LED0_BRIGHTNESS..OUT11_COLOR.
+ *
+ * Usage: lp50xx_anim_encode [-d devices] [-f first register] [-n registers] [-c array name] input output
+ *   -c writes a C header with a PROGMEM array instead of a binary stream
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "LP50XX_Animation.h"
+
+static void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [-d devices] [-f first register] [-n registers] [-c array name] input output\n", name);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    int devices = 1;
+    int firstRegister = 0x07;
+    int registerCount = 16;
+    const char *arrayName = NULL;
+
+    int option;
+    while ((option = getopt(argc, argv, "d:f:n:c:")) != -1) {
+        switch (option)
+        {
+        case 'd':
+            devices = strtol(optarg, NULL, 0);
+            break;
+        case 'f':
+            firstRegister = strtol(optarg, NULL, 0);
+            break;
+        case 'n':
+            registerCount = strtol(optarg, NULL, 0);
+            break;
+        case 'c':
+            arrayName = optarg;
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (argc - optind != 2 || devices < 1 || devices > 255 || registerCount < 1 || firstRegister < 0) {
+        usage(argv[0]);
+    }
+
+    FILE *input = fopen(argv[optind], "rb");
+    if (!input) {
+        perror(argv[optind]);
+        return 1;
+    }
+    std::vector<uint8_t> raw;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), input)) > 0) {
+        raw.insert(raw.end(), chunk, chunk + read);
+    }
+    fclose(input);
+
+    size_t frameSize = (size_t)devices * registerCount;
+    size_t frames = raw.size() / frameSize;
+    if (frames == 0 || frames > 0xFFFF || raw.size() % frameSize) {
+        fprintf(stderr, "Input must hold 1..65535 frames of %zu bytes\n", frameSize);
+        return 1;
+    }
+
+    std::vector<uint8_t> stream(LP50XX_ANIMATION_HEADER_SIZE);
+    if (!LP50XXAnimationEncoder::EncodeHeader(devices, firstRegister, registerCount, frames, stream.data())) {
+        fprintf(stderr, "Register window 0x%02X + %d does not fit the register map\n", firstRegister, registerCount);
+        return 1;
+    }
+
+    uint8_t block[LP50XX_ANIMATION_MAX_REGISTERS + 1];
+    for (size_t frame = 0; frame < frames; frame++) {
+        for (int device = 0; device < devices; device++) {
+            const uint8_t *current = &raw[frame * frameSize + device * registerCount];
+            const uint8_t *previous = frame ? current - frameSize : NULL;
+            uint8_t length = LP50XXAnimationEncoder::EncodeDevice(previous, current, registerCount, block);
+            stream.insert(stream.end(), block, block + length);
+        }
+    }
+
+    FILE *output = fopen(argv[optind + 1], arrayName ? "w" : "wb");
+    if (!output) {
+        perror(argv[optind + 1]);
+        return 1;
+    }
+    if (arrayName) {
+        fprintf(output, "// Generated by lp50xx_anim_encode: %zu frames, %d devices, registers 0x%02X..0x%02X\n",
+                frames, devices, firstRegister, firstRegister + registerCount - 1);
+        fprintf(output, "const uint8_t %s[%zu] PROGMEM = {", arrayName, stream.size());
+        for (size_t i = 0; i < stream.size(); i++) {
+            fprintf(output, "%s0x%02X,", i % 16 ? " " : "\n    ", stream[i]);
+        }
+        fprintf(output, "\n};\n");
+    } else {
+        fwrite(stream.data(), 1, stream.size(), output);
+    }
+    fclose(output);
+
+    fprintf(stderr, "%zu frames: %zu raw bytes -> %zu encoded bytes (ratio %.2f:1, %.1f bytes/frame)\n",
+            frames, raw.size(), stream.size(), (double)raw.size() / stream.size(), (double)stream.size() / frames);
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file lp50xx_c_bench.c
+ * @brief Host benchmark for the C interface: per output calls versus one batch call per frame
+ *
+ * Build from the src directory: gcc -O2 -I. -c ../extras/tools/lp50xx_c_bench.c && g++ -O2 -I. -o lp50xx_c_bench lp50xx_c_bench.o *.cpp -lpthread
+ *
+ * The I2C functions are implemented here by a simulated bus without wire time, so only the cost of the calls
+ * and the number of transactions is measured. Every foreign function call adds the crossing cost of the caller,
+ * e.g. around 0.5 us per call in Python ctypes, so the calls per frame matter more than the time in C.
+ *
+ * Usage: lp50xx_c_bench [-d devices] [-n frames]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LP50XX_C.h"
+#include "I2C_coms.h"
+
+static unsigned long transactions = 0;
+
+int8_t i2c_init() {
+    return 0;
+}
+
+int8_t i2c_write_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    transactions++;
+    return 0;
+}
+
+int8_t i2c_read_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    transactions++;
+    memset(pdata, 0, count);
+    return 0;
+}
+
+int8_t i2c_write_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t data) {
+    return i2c_write_multi(deviceAddress, registerAddress, &data, 1);
+}
+
+int8_t i2c_read_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *data) {
+    return i2c_read_multi(deviceAddress, registerAddress, data, 1);
+}
+
+static double nanoseconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void report(const char *name, double start, unsigned long calls, unsigned long frames) {
+    printf("%-28s %8.1f %10.0f %10.2f\n", name, (double)calls / frames, (nanoseconds() - start) / frames,
+           (double)transactions / frames);
+}
+
+int main(int argc, char **argv) {
+    int devices = 4;
+    unsigned long frames = 100000;
+
+    int option;
+    while ((option = getopt(argc, argv, "d:n:")) != -1) {
+        switch (option)
+        {
+        case 'd': devices = atoi(optarg); break;
+        case 'n': frames = strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "Usage: %s [-d devices] [-n frames]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (devices < 1 || devices > 64 || frames < 1) {
+        return 1;
+    }
+
+    lp50xx_device *handles[64];
+    for (int i = 0; i < devices; i++) {
+        handles[i] = lp50xx_create(LP50XX_C_NO_PIN);
+        lp50xx_begin(handles[i], 0x14 + i % 4);
+    }
+    lp50xx_flush_all(handles, devices);
+
+    uint8_t *frame = malloc(devices * LP50XX_C_OUTPUTS);
+    printf("%d devices, %lu frames, every output changes every frame\n", devices, frames);
+    printf("%-28s %8s %10s %10s\n", "Method", "Calls", "ns/frame", "I2C/frame");
+
+    // Direct writes, one call and one transaction per output
+    transactions = 0;
+    unsigned long calls = 0;
+    double start = nanoseconds();
+    for (unsigned long n = 0; n < frames; n++) {
+        for (int d = 0; d < devices; d++) {
+            for (uint8_t output = 0; output < LP50XX_C_OUTPUTS; output++) {
+                lp50xx_set_output_color(handles[d], output, n + output);
+                calls++;
+            }
+        }
+    }
+    report("lp50xx_set_output_color", start, calls, frames);
+
+    // Staged per output, flushed per device
+    transactions = 0;
+    calls = 0;
+    start = nanoseconds();
+    for (unsigned long n = 0; n < frames; n++) {
+        for (int d = 0; d < devices; d++) {
+            for (uint8_t output = 0; output < LP50XX_C_OUTPUTS; output++) {
+                uint8_t value = n + output + 1;
+                lp50xx_stage_outputs(handles[d], output, &value, 1);
+                calls++;
+            }
+            lp50xx_flush(handles[d]);
+            calls++;
+        }
+    }
+    report("lp50xx_stage_outputs + flush", start, calls, frames);
+
+    // One call per frame for all devices
+    transactions = 0;
+    calls = 0;
+    start = nanoseconds();
+    for (unsigned long n = 0; n < frames; n++) {
+        for (int i = 0; i < devices * LP50XX_C_OUTPUTS; i++) {
+            frame[i] = n + i % LP50XX_C_OUTPUTS;
+        }
+        lp50xx_write_outputs(handles, devices, frame);
+        calls++;
+    }
+    report("lp50xx_write_outputs", start, calls, frames);
+
+    free(frame);
+    for (int i = 0; i < devices; i++) {
+        lp50xx_destroy(handles[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file lp50xx_daemon_bench.cpp
+ * @brief Host load benchmark for the Unix socket server with many simulated clients and a simulated I2C bus
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_daemon_bench ../extras/tools/lp50xx_daemon_bench.cpp *.cpp -lpthread
+ *
+ * The number of clients is doubled from 1 up to the maximum. Every client thread sends random colors for its own LED
+ * at a fixed rate, with more clients than LEDs several clients share an LED and compete with priorities 0..2.
+ * The bus takes the wire time of every transaction at 400 kHz. The I2C transactions and bytes per frame stop growing
+ * once every LED is written every frame, however many clients write.
+ *
+ * Usage: lp50xx_daemon_bench [-c max clients] [-d devices] [-r messages/s per client] [-f fps] [-s seconds per step]
+ */
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "LP50XX.h"
+#include "LP50XX_Daemon.h"
+
+#define BUS_CLOCK 400000UL
+
+/**
+ * @brief Simulated bus: START + address + register + payload bytes with ACK bits + STOP
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        std::atomic<unsigned long> transactions;
+        std::atomic<unsigned long> bytes;
+
+        SimulatedBus() : transactions(0), bytes(0) {}
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            transactions++;
+            bytes += count;
+            delayMicroseconds((2 + count) * 9 * 1000000UL / BUS_CLOCK + 2);
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            memset(pdata, 0, count);
+            return 0;
+        }
+};
+
+static int connectTo(const char *path) {
+    struct sockaddr_un remote = {};
+    remote.sun_family = AF_UNIX;
+    strcpy(remote.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&remote, sizeof(remote)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char **argv) {
+    int maxClients = 32;
+    int devices = 4;
+    int rate = 200;
+    int fps = 100;
+    int seconds = 2;
+
+    int option;
+    while ((option = getopt(argc, argv, "c:d:r:f:s:")) != -1) {
+        switch (option)
+        {
+        case 'c': maxClients = atoi(optarg); break;
+        case 'd': devices = atoi(optarg); break;
+        case 'r': rate = atoi(optarg); break;
+        case 'f': fps = atoi(optarg); break;
+        case 's': seconds = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-c max clients] [-d devices] [-r messages/s per client] [-f fps] [-s seconds per step]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (maxClients < 1 || maxClients > LP50XX_DAEMON_MAX_CLIENTS || devices < 1 || devices > LP50XX_DAEMON_MAX_DEVICES ||
+        rate < 1 || fps < 1) {
+        return 1;
+    }
+
+    SimulatedBus bus;
+    std::vector<LP50XX> drivers(devices);
+    std::vector<LP50XX *> pointers;
+    for (int i = 0; i < devices; i++) {
+        drivers[i].SetTransport(&bus);
+        drivers[i].Begin(0x14 + i % 4);
+        drivers[i].Flush();
+        pointers.push_back(&drivers[i]);
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/lp50xx_bench_%d.sock", (int)getpid());
+    LP50XXDaemon daemon(pointers.data(), devices);
+    daemon.SetFrameRate(fps);
+    if (!daemon.Begin(path)) {
+        perror(path);
+        return 1;
+    }
+
+    printf("%d devices, %d messages/s per client, %d fps, %lu Hz bus\n", devices, rate, fps, BUS_CLOCK);
+    printf("Clients  Messages/s  Frames/s  Writes/frame  Denied  I2C/frame  Bytes/frame\n");
+
+    for (int clients = 1; clients <= maxClients; clients *= 2) {
+        std::atomic<bool> running(true);
+        std::vector<std::thread> threads;
+        for (int c = 0; c < clients; c++) {
+            threads.push_back(std::thread([&, c]() {
+                int fd = connectTo(path);
+                if (fd < 0) {
+                    return;
+                }
+                uint8_t priority[2] = { LP50XX_DAEMON_PRIORITY, (uint8_t)(c % 3) };
+                send(fd, priority, sizeof(priority), MSG_NOSIGNAL);
+
+                unsigned int seed = c + 1;
+                uint8_t led = c % (devices * 4);
+                unsigned long next = micros();
+                while (running) {
+                    uint8_t message[7] = { LP50XX_DAEMON_WRITE, (uint8_t)(led / 4), (uint8_t)(OUT0_COLOR + (led % 4) * 3), 3,
+                                           (uint8_t)rand_r(&seed), (uint8_t)rand_r(&seed), (uint8_t)rand_r(&seed) };
+                    send(fd, message, sizeof(message), MSG_NOSIGNAL);
+
+                    next += 1000000UL / rate;
+                    long wait = (long)(next - micros());
+                    if (wait > 0) {
+                        delayMicroseconds(wait);
+                    }
+                }
+                close(fd);
+            }));
+        }
+
+        // Let the clients connect before measuring
+        unsigned long end = millis() + 100;
+        while ((long)(end - millis()) > 0) {
+            daemon.Poll();
+        }
+        daemon.ResetStats();
+        bus.transactions = 0;
+        bus.bytes = 0;
+
+        end = millis() + seconds * 1000UL;
+        while ((long)(end - millis()) > 0) {
+            daemon.Poll();
+        }
+        LP50XXDaemonStats stats;
+        daemon.GetStats(&stats);
+        unsigned long transactions = bus.transactions;
+        unsigned long bytes = bus.bytes;
+
+        running = false;
+        for (size_t i = 0; i < threads.size(); i++) {
+            threads[i].join();
+        }
+        // Let the server notice the disconnects, so the next step starts without owners
+        end = millis() + 50;
+        while ((long)(end - millis()) > 0) {
+            daemon.Poll();
+        }
+
+        double elapsed = stats.elapsedUs / 1e6;
+        double frames = stats.frames ? stats.frames : 1;
+        printf("%7d  %10.0f  %8.1f  %12.1f  %5.1f%%  %9.2f  %11.1f\n", clients, stats.messages / elapsed, stats.frames / elapsed,
+               stats.writes / frames, stats.writes + stats.denied ? 100.0 * stats.denied / (stats.writes + stats.denied) : 0.0,
+               transactions / frames, bytes / frames);
+    }
+
+    daemon.End();
+    return 0;
+}
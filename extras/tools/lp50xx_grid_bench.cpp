@@ -0,0 +1,170 @@
+/**
+ * @file lp50xx_grid_bench.cpp
+ * @brief Host benchmark for the 2D panel mapping with a 16x16 panel of 64 devices on 16 simulated buses
+ *
+ * Build from the src directory: g++ -O2 -I. -DLP50XX_CHAIN_MAX_DEVICES=64 -o lp50xx_grid_bench ../extras/tools/lp50xx_grid_bench.cpp *.cpp -lpthread
+ *
+ * The panel consists of four 8x8 tiles with different wiring and rotation. A full panel is written per frame
+ * by computing the mapping for every pixel, by @ref LP50XXGrid::SetPixel and by @ref LP50XXGrid::Fill, the staged
+ * registers of both methods are compared to verify the compiled table.
+ *
+ * Usage: lp50xx_grid_bench [-n frames]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "LP50XX_Grid.h"
+
+#define SIZE 16
+#define TILE 8
+
+/**
+ * @brief Simulated bus that counts the transactions
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        unsigned long transactions = 0;
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            transactions++;
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            memset(pdata, 0, count);
+            return 0;
+        }
+};
+
+static const LP50XXTile tiles[4] = {
+    { 0, 0, TILE, TILE, 0, LP50XX_WIRING_SERPENTINE, Rotation0 },
+    { TILE, 0, TILE, TILE, 64, LP50XX_WIRING_COLUMNS | LP50XX_WIRING_SERPENTINE, Rotation90 },
+    { 0, TILE, TILE, TILE, 128, LP50XX_WIRING_ROWS, Rotation180 },
+    { TILE, TILE, TILE, TILE, 192, LP50XX_WIRING_COLUMNS | LP50XX_WIRING_SERPENTINE, Rotation270 },
+};
+
+// The mapping computed for every pixel, the inverse of the table compilation
+static uint16_t chainPixel(uint8_t x, uint8_t y) {
+    const LP50XXTile &tile = tiles[(y / TILE) * 2 + x / TILE];
+    uint8_t lx = x - tile.x;
+    uint8_t ly = y - tile.y;
+    uint8_t column;
+    uint8_t row;
+    switch (tile.rotation) {
+        case Rotation90: column = ly; row = TILE - 1 - lx; break;
+        case Rotation180: column = TILE - 1 - lx; row = TILE - 1 - ly; break;
+        case Rotation270: column = TILE - 1 - ly; row = lx; break;
+        default: column = lx; row = ly; break;
+    }
+    bool serpentine = tile.wiring & LP50XX_WIRING_SERPENTINE;
+    if (tile.wiring & LP50XX_WIRING_COLUMNS) {
+        return tile.firstPixel + column * TILE + (serpentine && (column & 1) ? TILE - 1 - row : row);
+    }
+    return tile.firstPixel + row * TILE + (serpentine && (row & 1) ? TILE - 1 - column : column);
+}
+
+static double nanoseconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    int frames = 20000;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:")) != -1) {
+        switch (option)
+        {
+        case 'n': frames = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n frames]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const int devices = SIZE * SIZE / 4;
+    std::vector<SimulatedBus> buses(devices / 4);
+    std::vector<LP50XX> drivers(devices);
+    LP50XXChain chain;
+    for (int i = 0; i < devices; i++) {
+        drivers[i].SetLEDConfiguration((LED_Configuration)(i % 6));
+        drivers[i].SetTransport(&buses[i / 4]);
+        chain.Add(drivers[i], 0x14 + i % 4);
+    }
+    chain.Begin();
+    chain.Flush();
+
+    LP50XXGrid grid(chain);
+    if (!grid.Begin(SIZE, SIZE, tiles, 4)) {
+        fprintf(stderr, "The panel does not fit, build with -DLP50XX_CHAIN_MAX_DEVICES=64\n");
+        return 1;
+    }
+
+    // Verify the table against the computed mapping
+    bool verified = true;
+    for (uint8_t y = 0; y < SIZE; y++) {
+        for (uint8_t x = 0; x < SIZE; x++) {
+            chain.SetPixel(chainPixel(x, y), x, y, 1);
+            std::vector<uint8_t> expected;
+            for (int i = 0; i < devices; i++) {
+                for (uint8_t reg = OUT0_COLOR; reg <= OUT11_COLOR; reg++) {
+                    expected.push_back(drivers[i].GetShadowRegister(reg));
+                }
+            }
+            chain.SetPixel(chainPixel(x, y), 0, 0, 0);
+            grid.SetPixel(x, y, x, y, 1);
+            for (int i = 0, n = 0; i < devices; i++) {
+                for (uint8_t reg = OUT0_COLOR; reg <= OUT11_COLOR; reg++) {
+                    verified &= drivers[i].GetShadowRegister(reg) == expected[n++];
+                }
+            }
+            grid.SetPixel(x, y, 0, 0, 0);
+        }
+    }
+    chain.Flush();
+
+    printf("%dx%d panel, 4 tiles, %d devices, %d frames, table %s\n", SIZE, SIZE, devices, frames, verified ? "verified" : "MISMATCH");
+    printf("Method                 ns/frame  ns/pixel  I2C/frame\n");
+
+    const char *names[3] = { "computed mapping", "LP50XXGrid::SetPixel", "LP50XXGrid::Fill" };
+    for (int method = 0; method < 3; method++) {
+        for (size_t i = 0; i < buses.size(); i++) {
+            buses[i].transactions = 0;
+        }
+        double staging = 0;
+        for (int frame = 0; frame < frames; frame++) {
+            uint8_t value = frame;
+            double start = nanoseconds();
+            if (method == 0) {
+                for (uint8_t y = 0; y < SIZE; y++) {
+                    for (uint8_t x = 0; x < SIZE; x++) {
+                        chain.SetPixel(chainPixel(x, y), value, x, y);
+                    }
+                }
+            } else if (method == 1) {
+                for (uint8_t y = 0; y < SIZE; y++) {
+                    for (uint8_t x = 0; x < SIZE; x++) {
+                        grid.SetPixel(x, y, value, x, y);
+                    }
+                }
+            } else {
+                grid.Fill(value, value, value);
+            }
+            staging += nanoseconds() - start;
+            chain.Flush();
+        }
+
+        unsigned long transactions = 0;
+        for (size_t i = 0; i < buses.size(); i++) {
+            transactions += buses[i].transactions;
+        }
+        printf("%-21s  %8.0f  %8.2f  %9.1f\n", names[method], staging / frames, staging / frames / (SIZE * SIZE),
+               (double)transactions / frames);
+    }
+    return verified ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file lp50xx_i2cdev_bench.cpp
+ * @brief Host benchmark for the Linux i2c-dev transport without I2C hardware
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_i2cdev_bench ../extras/tools/lp50xx_i2cdev_bench.cpp *.cpp
+ *
+ * The ioctl of the default transport is replaced by a simulated bus that applies the I2C_RDWR messages to
+ * simulated register maps. Frames for all devices are flushed with and without batching, and the
+ * ioctls and messages per frame are reported. The simulated register maps are verified after every frame.
+ *
+ * Usage: lp50xx_i2cdev_bench [-d devices] [-n frames] [-c changes per device per frame]
+ */
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+
+#include "LP50XX.h"
+#include "LP50XX_LinuxI2C.h"
+
+static uint8_t registers[0x80][0x20];
+
+static int simulatedIoctl(int fd, unsigned long request, void *arg) {
+    if (request != I2C_RDWR) {
+        return -1;
+    }
+    struct i2c_rdwr_ioctl_data *data = (struct i2c_rdwr_ioctl_data *)arg;
+    uint8_t pointer = 0;
+    for (uint32_t i = 0; i < data->nmsgs; i++) {
+        struct i2c_msg &message = data->msgs[i];
+        uint8_t *map = registers[message.addr & 0x7F];
+        if (message.flags & I2C_M_RD) {
+            for (uint16_t j = 0; j < message.len; j++) {
+                message.buf[j] = map[(pointer + j) & 0x1F];
+            }
+        } else if (message.len) {
+            pointer = message.buf[0];
+            for (uint16_t j = 1; j < message.len; j++) {
+                map[(pointer + j - 1) & 0x1F] = message.buf[j];
+            }
+        }
+    }
+    return 0;
+}
+
+static bool verify(std::vector<LP50XX> &drivers) {
+    for (size_t i = 0; i < drivers.size(); i++) {
+        for (uint8_t reg = LED0_BRIGHTNESS; reg <= OUT11_COLOR; reg++) {
+            if (registers[0x14 + i][reg] != drivers[i].GetShadowRegister(reg)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int devices = 4;
+    int frames = 1000;
+    int changes = 12;
+
+    int option;
+    while ((option = getopt(argc, argv, "d:n:c:")) != -1) {
+        switch (option)
+        {
+        case 'd': devices = atoi(optarg); break;
+        case 'n': frames = atoi(optarg); break;
+        case 'c': changes = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-d devices] [-n frames] [-c changes per device per frame]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (devices < 1 || devices > 4 || frames < 1) {
+        return 1;
+    }
+
+    LP50XXLinuxI2C &bus = LP50XXLinuxI2C::Default();
+    bus.SetIoctl(simulatedIoctl);
+    bus.Attach(open("/dev/null", O_RDWR));
+
+    std::vector<LP50XX> drivers(devices);
+    for (int i = 0; i < devices; i++) {
+        registers[0x14 + i][DEVICE_CONFIG1] = AUTO_INC_ON;
+        drivers[i].Begin(0x14 + i);
+    }
+
+    printf("%d devices, %d changed outputs per device per frame\n", devices, changes);
+    for (int batched = 0; batched < 2; batched++) {
+        srand(1);
+        bus.ResetCounters();
+        for (int frame = 0; frame < frames; frame++) {
+            for (int i = 0; i < devices; i++) {
+                for (int change = 0; change < changes; change++) {
+                    drivers[i].StageOutputColor(rand() % 12, rand());
+                }
+            }
+
+            if (batched) {
+                bus.BeginBatch();
+            }
+            for (int i = 0; i < devices; i++) {
+                drivers[i].Flush();
+            }
+            if (batched) {
+                bus.EndBatch();
+            }
+
+            if (!verify(drivers)) {
+                printf("Register mismatch in frame %d\n", frame);
+                return 1;
+            }
+        }
+        printf("%-10s %6.2f ioctls/frame, %6.2f messages/frame\n", batched ? "Batched" : "Unbatched",
+               (double)bus.GetSyscallCount() / frames, (double)bus.GetMessageCount() / frames);
+    }
+    return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file lp50xx_multibus_bench.cpp
+ * @brief Host benchmark for the parallel multi-bus flush with simulated buses
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_multibus_bench ../extras/tools/lp50xx_multibus_bench.cpp *.cpp -lpthread
+ *
+ * Every simulated bus takes the wire time of a transaction at the given clock. Four devices per bus get a full
+ * frame (all outputs change) and the frame rate is reported with sequential and parallel flushing for 1..4 buses.
+ *
+ * A fault check then runs two buses that queue the writes of a batch like @ref LP50XXLinuxI2C. The EndBatch() of
+ * one frame fails and drops the queued writes, the next Flush() has to write those registers again.
+ *
+ * Usage: lp50xx_multibus_bench [-c i2c clock] [-n frames]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "LP50XX.h"
+#include "LP50XX_MultiBus.h"
+
+/**
+ * @brief Simulated bus: START + address + register + payload bytes with ACK bits + STOP
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        unsigned long clock = 400000;
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            delayMicroseconds((2 + count) * 9 * 1000000UL / clock + 2);
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            memset(pdata, 0, count);
+            delayMicroseconds((3 + count) * 9 * 1000000UL / clock + 4);
+            return 0;
+        }
+};
+
+/**
+ * @brief Simulated bus that queues the writes of a batch and applies them in EndBatch(), which fails on request
+ */
+class BatchingBus : public LP50XXTransport
+{
+    public:
+        uint8_t registers[4][LP50XX_REGISTER_COUNT];
+        bool failNextBatch = false;
+
+        BatchingBus() {
+            memset(registers, 0, sizeof(registers));
+        }
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            if (!_batching) {
+                apply(deviceAddress, registerAddress, pdata, count);
+                return 0;
+            }
+            Queued &queued = _queue[_queued++ % 32];
+            queued.address = deviceAddress;
+            queued.reg = registerAddress;
+            queued.count = count < LP50XX_REGISTER_COUNT ? count : LP50XX_REGISTER_COUNT;
+            memcpy(queued.data, pdata, queued.count);
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            for (uint32_t i = 0; i < count; i++) {
+                pdata[i] = registerAddress + i < LP50XX_REGISTER_COUNT ? registers[deviceAddress - 0x14][registerAddress + i] : 0;
+            }
+            return 0;
+        }
+
+        void BeginBatch() {
+            _batching = true;
+            _queued = 0;
+        }
+
+        int8_t EndBatch() {
+            _batching = false;
+            if (failNextBatch) {
+                failNextBatch = false;
+                return 4;
+            }
+            for (uint8_t i = 0; i < _queued && i < 32; i++) {
+                apply(_queue[i].address, _queue[i].reg, _queue[i].data, _queue[i].count);
+            }
+            return 0;
+        }
+
+    private:
+        struct Queued {
+            uint8_t address;
+            uint8_t reg;
+            uint8_t count;
+            uint8_t data[LP50XX_REGISTER_COUNT];
+        };
+        Queued _queue[32];
+        uint8_t _queued = 0;
+        bool _batching = false;
+
+        void apply(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            for (uint32_t i = 0; i < count && registerAddress + i < LP50XX_REGISTER_COUNT; i++) {
+                registers[deviceAddress - 0x14][registerAddress + i] = pdata[i];
+            }
+        }
+};
+
+/**
+ * @brief Fails the EndBatch() of one frame on the second bus and checks that the next frame writes its registers
+ *
+ * @return true when all registers hold the staged values after the next frame
+ */
+static bool faultCheck() {
+    BatchingBus bus[2];
+    LP50XX devices[2][4];
+    LP50XXMultiBusFlush coordinator;
+
+    for (uint8_t b = 0; b < 2; b++) {
+        for (uint8_t d = 0; d < 4; d++) {
+            devices[b][d].SetTransport(&bus[b]);
+            devices[b][d].Begin(0x14 + d);
+            coordinator.Add(&devices[b][d]);
+        }
+    }
+    coordinator.Begin();
+    coordinator.Flush();
+
+    bool ok = true;
+    for (int frame = 1; frame <= 3; frame++) {
+        for (uint8_t b = 0; b < 2; b++) {
+            for (uint8_t d = 0; d < 4; d++) {
+                for (uint8_t output = 0; output < 12; output++) {
+                    devices[b][d].StageOutputColor(output, frame * 16 + output);
+                }
+            }
+        }
+        bus[1].failNextBatch = frame == 1;
+        int8_t status = coordinator.Flush();
+        if (frame == 1) {
+            ok &= status != 0;
+            // Stage nothing new, the next Flush() alone has to repair the bus
+            status = coordinator.Flush();
+        }
+        ok &= status == 0;
+        for (uint8_t b = 0; b < 2; b++) {
+            for (uint8_t d = 0; d < 4; d++) {
+                for (uint8_t output = 0; output < 12; output++) {
+                    ok &= bus[b].registers[d][OUT0_COLOR + output] == (uint8_t)(frame * 16 + output);
+                }
+            }
+        }
+    }
+    coordinator.End();
+    return ok;
+}
+
+static double run(uint8_t buses, bool parallel, unsigned long clock, int frames) {
+    SimulatedBus bus[LP50XX_MULTIBUS_MAX_BUSES];
+    LP50XX devices[LP50XX_MULTIBUS_MAX_BUSES][4];
+    LP50XXMultiBusFlush coordinator;
+
+    for (uint8_t b = 0; b < buses; b++) {
+        bus[b].clock = clock;
+        for (uint8_t d = 0; d < 4; d++) {
+            devices[b][d].SetTransport(&bus[b]);
+            devices[b][d].Begin(0x14 + d);
+            coordinator.Add(&devices[b][d]);
+        }
+    }
+    if (parallel) {
+        coordinator.Begin();
+    }
+    coordinator.Flush();
+
+    unsigned long start = micros();
+    for (int frame = 0; frame < frames; frame++) {
+        for (uint8_t b = 0; b < buses; b++) {
+            for (uint8_t d = 0; d < 4; d++) {
+                for (uint8_t output = 0; output < 12; output++) {
+                    devices[b][d].StageOutputColor(output, frame + output);
+                }
+            }
+        }
+        coordinator.Flush();
+    }
+    return frames * 1e6 / (micros() - start);
+}
+
+int main(int argc, char **argv) {
+    unsigned long clock = 400000;
+    int frames = 200;
+
+    int option;
+    while ((option = getopt(argc, argv, "c:n:")) != -1) {
+        switch (option)
+        {
+        case 'c': clock = atol(optarg); break;
+        case 'n': frames = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-c i2c clock] [-n frames]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("4 devices per bus, full frames, %lu Hz bus\n", clock);
+    printf("Buses  Sequential fps  Parallel fps  Scaling\n");
+    double single = 0;
+    for (uint8_t buses = 1; buses <= LP50XX_MULTIBUS_MAX_BUSES; buses++) {
+        double sequential = run(buses, false, clock, frames);
+        double parallel = run(buses, true, clock, frames);
+        if (buses == 1) {
+            single = parallel;
+        }
+        printf("%5u  %14.1f  %12.1f  %6.2fx\n", buses, sequential, parallel, parallel * buses / single);
+    }
+
+    bool ok = faultCheck();
+    printf("Failed EndBatch(): %s\n", ok ? "registers written again by the next flush" : "registers lost");
+    return ok ? 0 : 1;
+}
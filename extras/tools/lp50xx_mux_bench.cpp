@@ -0,0 +1,184 @@
+/**
+ * @file lp50xx_mux_bench.cpp
+ * @brief Host benchmark for devices behind I2C multiplexers on a simulated bus
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_mux_bench ../extras/tools/lp50xx_mux_bench.cpp *.cpp -lpthread
+ *
+ * Two multiplexers at 0x70 and 0x71 with 4 channels each. By default every channel has two devices, channels 0 and 2
+ * at 0x14/0x15, channels 1 and 3 at 0x16/0x17, so pairs of channels can be enabled together. With -f every channel has
+ * all four addresses. The devices are added alternating between the multiplexers, the way a fixture is numbered.
+ * Every frame a random part of the devices changes. The multiplexer switch transactions per frame are compared for:
+ *
+ * - naive:  the channel is switched before every device, the other multiplexer is disabled
+ * - cached: @ref LP50XXMuxChannel in the order the devices were added
+ * - flush:  @ref LP50XXMuxFlush
+ *
+ * The simulated bus reports address collisions and the registers of all devices are verified after every method.
+ *
+ * Usage: lp50xx_mux_bench [-f] [-p percent of devices changed per frame] [-n frames]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+
+#include "LP50XX.h"
+#include "LP50XX_Mux.h"
+
+#define MUXES 2
+#define CHANNELS 4
+
+/**
+ * @brief Simulated bus with multiplexers and LP50XX devices that auto increment
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        struct Device {
+            uint8_t     mux;
+            uint8_t     channel;
+            uint8_t     address;
+            uint8_t     registers[0x20];
+        };
+
+        std::vector<Device> devices;
+        uint8_t     control[MUXES] = {0};
+        unsigned long switches = 0;
+        unsigned long transactions = 0;
+        unsigned long collisions = 0;
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            transactions++;
+            if (deviceAddress >= LP50XX_MUX_DEFAULT_ADDRESS && deviceAddress < LP50XX_MUX_DEFAULT_ADDRESS + MUXES) {
+                control[deviceAddress - LP50XX_MUX_DEFAULT_ADDRESS] = registerAddress;
+                switches++;
+                return 0;
+            }
+
+            int targets = 0;
+            for (size_t i = 0; i < devices.size(); i++) {
+                Device &device = devices[i];
+                if (!(control[device.mux] >> device.channel & 1) ||
+                    (device.address != deviceAddress && deviceAddress != BROADCAST_ADDRESS)) {
+                    continue;
+                }
+                for (uint32_t n = 0; n < count && registerAddress + n < sizeof(device.registers); n++) {
+                    device.registers[registerAddress + n] = pdata[n];
+                }
+                targets++;
+            }
+            if (targets > 1 && deviceAddress != BROADCAST_ADDRESS) {
+                collisions++;
+            }
+            return targets ? 0 : 2;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            memset(pdata, 0, count);
+            return 0;
+        }
+};
+
+int main(int argc, char **argv) {
+    bool full = false;
+    int percent = 50;
+    int frames = 10000;
+
+    int option;
+    while ((option = getopt(argc, argv, "fp:n:")) != -1) {
+        switch (option)
+        {
+        case 'f': full = true; break;
+        case 'p': percent = atoi(optarg); break;
+        case 'n': frames = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-f] [-p percent of devices changed per frame] [-n frames]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SimulatedBus bus;
+    int perChannel = full ? 4 : 2;
+    for (int i = 0; i < MUXES * CHANNELS * perChannel; i++) {
+        // Alternate between the multiplexers, then the channels
+        SimulatedBus::Device device = {};
+        device.mux = i % MUXES;
+        device.channel = i / MUXES % CHANNELS;
+        device.address = 0x14 + (full ? 0 : (device.channel % 2) * 2) + i / (MUXES * CHANNELS);
+        bus.devices.push_back(device);
+    }
+    int count = bus.devices.size();
+
+    LP50XXMux mux0(0x70, &bus);
+    LP50XXMux mux1(0x71, &bus);
+    LP50XXMux *muxes[MUXES] = { &mux0, &mux1 };
+    std::vector<LP50XXMuxChannel> channels;
+    channels.reserve(MUXES * CHANNELS);
+    for (int m = 0; m < MUXES; m++) {
+        for (int c = 0; c < CHANNELS; c++) {
+            channels.push_back(LP50XXMuxChannel(*muxes[m], 1 << c));
+        }
+    }
+
+    std::vector<LP50XX> drivers(count);
+    LP50XXMuxFlush flusher;
+    for (int i = 0; i < count; i++) {
+        flusher.Add(drivers[i], channels[bus.devices[i].mux * CHANNELS + bus.devices[i].channel]);
+        drivers[i].Begin(bus.devices[i].address);
+    }
+    flusher.Flush();
+
+    printf("%d devices behind %d multiplexers, %d per channel, %d%% changed per frame, %d frames\n",
+           count, MUXES, perChannel, percent, frames);
+    printf("Method   Switches/frame  I2C/frame  Collisions  Verified\n");
+
+    const char *names[3] = { "naive", "cached", "flush" };
+    for (int method = 0; method < 3; method++) {
+        srand(1);
+        bus.switches = 0;
+        bus.transactions = 0;
+        bus.collisions = 0;
+
+        for (int frame = 0; frame < frames; frame++) {
+            for (int i = 0; i < count; i++) {
+                if (rand() % 100 < percent) {
+                    drivers[i].StageOutputColor(rand() % 12, rand());
+                }
+            }
+
+            if (method == 0) {
+                for (int i = 0; i < count; i++) {
+                    SimulatedBus::Device &device = bus.devices[i];
+                    bus.Write(0x70 + (1 - device.mux), 0, NULL, 0);
+                    bus.Write(0x70 + device.mux, 1 << device.channel, NULL, 0);
+                    drivers[i].SetTransport(&bus);
+                    drivers[i].Flush();
+                    drivers[i].SetTransport(&channels[device.mux * CHANNELS + device.channel]);
+                }
+                // The cache of the multiplexers is stale after the direct writes
+                mux0.Begin();
+                mux1.Begin();
+            } else if (method == 1) {
+                for (int i = 0; i < count; i++) {
+                    drivers[i].Flush();
+                }
+            } else {
+                flusher.Flush();
+            }
+        }
+
+        bool verified = true;
+        for (int i = 0; i < count; i++) {
+            for (uint8_t reg = OUT0_COLOR; reg <= OUT11_COLOR; reg++) {
+                verified &= bus.devices[i].registers[reg] == drivers[i].GetShadowRegister(reg);
+            }
+        }
+        if (method == 0) {
+            bus.switches -= 2 * frames;
+            bus.transactions -= 2 * frames;
+        }
+        printf("%-6s   %14.2f  %9.2f  %10lu  %s\n", names[method], (double)bus.switches / frames,
+               (double)bus.transactions / frames, bus.collisions, verified ? "yes" : "NO");
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file lp50xx_pageflip_stress.cpp
+ * @brief Host stress test for the page flipped frame buffer with a renderer and a flusher thread
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_pageflip_stress ../extras/tools/lp50xx_pageflip_stress.cpp *.cpp -lpthread
+ *
+ * The renderer thread writes frame n to all 12 outputs one by one, yielding in between to provoke preemption
+ * mid-frame, and commits. The flusher thread flushes to a simulated bus as fast as it can and checks after every
+ * flush that all outputs of the simulated device hold the same frame. A torn frame is reported as an error.
+ *
+ * Usage: lp50xx_pageflip_stress [-n frames]
+ */
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+#include "LP50XX_FrameBuffer.h"
+
+/**
+ * @brief Simulated device with auto increment, counts the register writes
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        uint8_t     registers[0x20] = {0};
+        uint32_t    transactions = 0;
+        uint32_t    bytes = 0;
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            for (uint32_t i = 0; i < count && registerAddress + i < sizeof(registers); i++) {
+                registers[registerAddress + i] = pdata[i];
+            }
+            transactions++;
+            bytes += count;
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            for (uint32_t i = 0; i < count; i++) {
+                pdata[i] = registerAddress + i < sizeof(registers) ? registers[registerAddress + i] : 0;
+            }
+            return 0;
+        }
+};
+
+static double seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    uint32_t frames = 100000;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:")) != -1) {
+        switch (option)
+        {
+        case 'n': frames = strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n frames]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SimulatedBus bus;
+    LP50XX device;
+    device.SetTransport(&bus);
+    device.Begin();
+    device.Flush();
+
+    LP50XXFrameBuffer frame(device);
+    frame.Load();
+
+    std::atomic<bool> rendering(true);
+    uint32_t torn = 0;
+    uint32_t flushes = 0;
+    double start = seconds();
+
+    std::thread flusher([&]() {
+        for (;;) {
+            bool last = !rendering.load();
+            frame.Flush();
+            flushes++;
+            for (uint8_t output = 1; output < 12; output++) {
+                if (bus.registers[OUT0_COLOR + output] != bus.registers[OUT0_COLOR]) {
+                    torn++;
+                    break;
+                }
+            }
+            if (last) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    for (uint32_t n = 1; n <= frames; n++) {
+        for (uint8_t output = 0; output < 12; output++) {
+            frame.SetOutputColor(output, n & 0xFF);
+            if (output == 5) {
+                std::this_thread::yield();
+            }
+        }
+        frame.Commit();
+    }
+    rendering = false;
+    flusher.join();
+
+    double elapsed = seconds() - start;
+    bool complete = bus.registers[OUT0_COLOR] == (frames & 0xFF);
+    printf("Rendered %u frames in %.3f s, %u flushes, %u frames sent, %u dropped as superseded\n",
+           frames, elapsed, flushes, frame.GetFrameCount(), frames - frame.GetFrameCount());
+    printf("Bus: %u transactions, %.1f bytes per sent frame\n", bus.transactions,
+           frame.GetFrameCount() ? (double)bus.bytes / frame.GetFrameCount() : 0.0);
+    printf("Torn frames: %u, last frame %s\n", torn, complete ? "sent" : "MISSING");
+    return torn == 0 && complete ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file lp50xx_profile_bench.cpp
+ * @brief Host tool that profiles the CPU time of the driver per API against the time waiting on a simulated bus
+ *
+ * Build from the src directory: g++ -O2 -I. -DLP50XX_PROFILE=1 -o lp50xx_profile_bench ../extras/tools/lp50xx_profile_bench.cpp *.cpp -lpthread
+ *
+ * Every API runs on four devices behind a simulated bus that waits the wire time of every transaction
+ * (see LP50XXBusTiming), and prints the profile of the hook sites. The summary line splits a call or frame into
+ * the self time of the driver sites (CPU) and the time of the I2C sites (bus).
+ *
+ * Usage: lp50xx_profile_bench [-n iterations] [-c clockHz]
+ *        -c  SCL clock of the simulated bus, 0 to skip the wait and measure the CPU side only
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LP50XX.h"
+#include "LP50XX_Chain.h"
+#include "LP50XX_Profile.h"
+
+#if !LP50XX_PROFILE
+#error "Build with -DLP50XX_PROFILE=1"
+#endif
+
+/**
+ * @brief Simulated bus that spins for the wire time of every transaction
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        bool wait = true;
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            LP50XX_PROFILE_SCOPE(ProfileI2CWrite);
+            spin(GetTiming().GetWriteTime(count));
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            LP50XX_PROFILE_SCOPE(ProfileI2CRead);
+            memset(pdata, 0, count);
+            spin(GetTiming().GetReadTime(count));
+            return 0;
+        }
+
+    private:
+        void spin(uint32_t ns) {
+            if (!wait) {
+                return;
+            }
+            struct timespec start, now;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            do {
+                clock_gettime(CLOCK_MONOTONIC, &now);
+            } while ((uint64_t)(now.tv_sec - start.tv_sec) * 1000000000ULL + now.tv_nsec - start.tv_nsec < ns);
+        }
+};
+
+static SimulatedBus bus;
+static LP50XX devices[4];
+
+static double ticksToUs(uint64_t ticks) {
+    return ticks * 1e6 / LP50XXProfile::GetFrequency();
+}
+
+/**
+ * @brief Prints the profile of one API and the split of a call into CPU and bus time
+ */
+static void report(const char *name, int calls) {
+    uint64_t cpu = 0;
+    uint64_t wire = 0;
+    for (uint8_t site = 0; site < ProfileSiteCount; site++) {
+        LP50XXProfileStats stats;
+        LP50XXProfile::Get(site, &stats);
+        if (site == ProfileI2CWrite || site == ProfileI2CRead) {
+            wire += stats.total;
+        } else {
+            cpu += stats.self;
+        }
+    }
+
+    printf("\n== %s, %d calls\n", name, calls);
+    LP50XXProfile::Report(stdout);
+    printf("per call: CPU %.2f us, bus %.2f us, CPU share %.1f %%\n", ticksToUs(cpu) / calls, ticksToUs(wire) / calls,
+           cpu + wire > 0 ? 100.0 * cpu / (cpu + wire) : 0.0);
+}
+
+int main(int argc, char **argv) {
+    int iterations = 1000;
+    uint32_t clockHz = LP50XX_I2C_FAST;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:c:")) != -1) {
+        switch (option)
+        {
+        case 'n': iterations = atoi(optarg); break;
+        case 'c': clockHz = strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n iterations] [-c clockHz]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    LP50XXBusTiming timing(clockHz != 0 ? clockHz : LP50XX_I2C_FAST);
+    bus.SetTiming(&timing);
+    bus.wait = clockHz != 0;
+
+    LP50XXChain chain;
+    for (uint8_t i = 0; i < 4; i++) {
+        devices[i].SetTransport(&bus);
+        chain.Add(devices[i], 0x14 + i);
+    }
+    chain.Begin();
+    chain.Flush();
+
+    LP50XXProfile::Begin();
+    printf("Counter %lu ticks/s, bus %s\n", (unsigned long)LP50XXProfile::GetFrequency(), bus.wait ? "waits the wire time" : "does not wait");
+
+    LP50XXProfile::Reset();
+    for (int i = 0; i < iterations; i++) {
+        devices[i & 3].SetLEDColor(i & 3, i, i * 3, i * 7);
+    }
+    report("SetLEDColor", iterations);
+
+    LP50XXProfile::Reset();
+    for (int i = 0; i < iterations; i++) {
+        devices[i & 3].SetOutputColor(i % 12, i);
+    }
+    report("SetOutputColor", iterations);
+
+    LP50XXProfile::Reset();
+    for (int frame = 0; frame < iterations; frame++) {
+        for (uint8_t i = 0; i < 4; i++) {
+            for (uint8_t led = 0; led < 4; led++) {
+                devices[i].StageLEDColor(led, frame + led, frame * 3, i * 64);
+            }
+            devices[i].Flush();
+        }
+    }
+    report("StageLEDColor and Flush, frames of 4 devices", iterations);
+
+    LP50XXProfile::Reset();
+    for (int frame = 0; frame < iterations; frame++) {
+        for (uint16_t pixel = 0; pixel < chain.GetPixelCount(); pixel++) {
+            chain.SetPixel(pixel, frame + pixel, frame * 3, pixel * 16);
+        }
+        chain.Flush();
+    }
+    report("Chain SetPixel and Flush, frames of 4 devices", iterations);
+    return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file lp50xx_ring_stress.cpp
+ * @brief Host stress test for the SPSC command ring with one thread per producer
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_ring_stress ../extras/tools/lp50xx_ring_stress.cpp *.cpp -lpthread
+ *
+ * Every producer thread pushes a numbered sequence of commands into its own ring, retrying when the ring is full.
+ * The consumer thread pops all rings and verifies that every sequence arrives complete and in order, then the
+ * push latency distribution is reported.
+ *
+ * Usage: lp50xx_ring_stress [-p producers] [-n commands per producer]
+ */
+#include <algorithm>
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "LP50XX_CommandRing.h"
+
+static uint64_t nanoseconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    int producers = 4;
+    uint32_t commands = 100000;
+
+    int option;
+    while ((option = getopt(argc, argv, "p:n:")) != -1) {
+        switch (option)
+        {
+        case 'p': producers = atoi(optarg); break;
+        case 'n': commands = strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "Usage: %s [-p producers] [-n commands per producer]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (producers < 1 || producers > 64 || commands < 1 || commands > 0xFFFFFF) {
+        return 1;
+    }
+
+    std::vector<LP50XXCommandRing> rings(producers);
+    std::vector<std::vector<uint32_t> > latencies(producers);
+    std::vector<uint64_t> retries(producers);
+    std::atomic<int> finished(0);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&, p]() {
+            latencies[p].reserve(commands);
+            for (uint32_t sequence = 0; sequence < commands; sequence++) {
+                for (;;) {
+                    uint64_t start = nanoseconds();
+                    bool pushed = rings[p].PushLEDColor(p, sequence & 3, sequence >> 16, sequence >> 8, sequence);
+                    uint64_t end = nanoseconds();
+                    if (pushed) {
+                        latencies[p].push_back(end - start);
+                        break;
+                    }
+                    retries[p]++;
+                    std::this_thread::yield();
+                }
+            }
+            finished++;
+        }));
+    }
+
+    std::vector<uint32_t> expected(producers);
+    uint64_t errors = 0;
+    uint64_t received = 0;
+    uint64_t start = nanoseconds();
+    for (;;) {
+        bool done = finished == producers;
+        bool idle = true;
+        for (int p = 0; p < producers; p++) {
+            LP50XXCommand command;
+            while (rings[p].Pop(&command)) {
+                idle = false;
+                uint32_t sequence = (uint32_t)command.value[0] << 16 | command.value[1] << 8 | command.value[2];
+                if (command.device != p || command.type != CommandLEDColor || command.index != (expected[p] & 3) ||
+                    sequence != (expected[p] & 0xFFFFFF)) {
+                    errors++;
+                }
+                expected[p]++;
+                received++;
+            }
+        }
+        if (done && received == (uint64_t)producers * commands) {
+            break;
+        }
+        if (idle) {
+            std::this_thread::yield();
+        }
+    }
+    double elapsed = (nanoseconds() - start) / 1e9;
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    std::vector<uint32_t> all;
+    uint64_t totalRetries = 0;
+    for (int p = 0; p < producers; p++) {
+        all.insert(all.end(), latencies[p].begin(), latencies[p].end());
+        totalRetries += retries[p];
+    }
+    std::sort(all.begin(), all.end());
+    double sum = 0;
+    for (size_t i = 0; i < all.size(); i++) {
+        sum += all[i];
+    }
+
+    printf("%d producers x %u commands, ring size %d\n", producers, commands, LP50XX_COMMAND_RING_SIZE);
+    printf("Received %llu commands in %.3f s (%.1f M/s), %llu out of order or lost, %llu full-ring retries\n",
+           (unsigned long long)received, elapsed, received / elapsed / 1e6, (unsigned long long)errors, (unsigned long long)totalRetries);
+    printf("Push latency: mean %.0f ns, p50 %u ns, p99 %u ns, max %u ns\n",
+           sum / all.size(), all[all.size() / 2], all[all.size() * 99 / 100], all.back());
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,318 @@
+/**
+ * @file lp50xx_serial_receive.cpp
+ * @brief Host tool that runs the serial receiver on a pseudo-terminal against a simulated bus and measures frame rate
+ * and latency
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_serial_receive ../extras/tools/lp50xx_serial_receive.cpp *.cpp -lpthread
+ *
+ * The tool opens a pseudo-terminal with posix_openpt() and feeds every byte of the master side to
+ * @ref LP50XXSerialReceiver::Feed. Completed frames are flushed with @ref LP50XXSerialReceiver::FlushFrame to LP5012
+ * at 0x14.. on a simulated bus that takes the wire time of every transaction at the clock of -c, and answered with
+ * ACK or NAK. A sender thread streams frames to the slave side like lp50xx_serial_send and corrupts one byte of
+ * every -x th frame. With -e the sender thread is not started, the tool prints the slave side for lp50xx_serial_send
+ * and runs until it is interrupted.
+ *
+ * At the end the output registers of all devices have to hold the last frame and all other registers their value
+ * after Begin(), a corrupt packet must never be staged. Before the run a frame whose last packet has a corrupt CRC
+ * is fed directly, its clean resend has to complete without an error.
+ *
+ * Usage: lp50xx_serial_receive [-d devices] [-n frames] [-x corrupt every nth frame] [-t timeout ms] [-c i2c clock] [-e]
+ */
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+#include "LP50XX.h"
+#include "LP50XX_Serial.h"
+
+#define OUTPUTS 12
+#define MAX_DEVICES 8
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Simulated bus with devices at 0x14.., every transaction takes its wire time
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        uint8_t registers[MAX_DEVICES][LP50XX_REGISTER_COUNT];
+        std::atomic<unsigned long> transactions;
+
+        SimulatedBus() : transactions(0) {
+            memset(registers, 0, sizeof(registers));
+        }
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            if (deviceAddress < 0x14 || deviceAddress >= 0x14 + MAX_DEVICES) {
+                return 2;
+            }
+            transactions++;
+            delayMicroseconds(GetTiming().GetWriteTime(count) / 1000);
+            for (uint32_t i = 0; i < count && registerAddress + i < LP50XX_REGISTER_COUNT; i++) {
+                registers[deviceAddress - 0x14][registerAddress + i] = pdata[i];
+            }
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            if (deviceAddress < 0x14 || deviceAddress >= 0x14 + MAX_DEVICES) {
+                return 2;
+            }
+            transactions++;
+            delayMicroseconds(GetTiming().GetReadTime(count) / 1000);
+            for (uint32_t i = 0; i < count; i++) {
+                pdata[i] = registerAddress + i < LP50XX_REGISTER_COUNT ? registers[deviceAddress - 0x14][registerAddress + i] : 0;
+            }
+            return 0;
+        }
+};
+
+struct SenderStats {
+    long frames;
+    long retries;
+    long timeouts;
+    double latencyMin;
+    double latencyMax;
+    double latencySum;
+    uint8_t last[MAX_DEVICES][OUTPUTS];
+};
+
+static void outputsOf(long frame, int device, uint8_t *outputs) {
+    for (int output = 0; output < OUTPUTS; output++) {
+        outputs[output] = (uint8_t)(frame * 7 + device * OUTPUTS + output);
+    }
+}
+
+/**
+ * @brief Sends frames like lp50xx_serial_send, one frame in flight. After a timeout the answers of the previous
+ * attempt are drained before the frame is resent, so a late ACK is never taken for the ACK of the resend
+ */
+static void sender(const char *port, int devices, long frames, long corruptEvery, int timeout, SenderStats *stats) {
+    int fd = open(port, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        perror(port);
+        exit(1);
+    }
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    uint8_t frame[MAX_DEVICES * (OUTPUTS + LP50XX_SERIAL_OVERHEAD)];
+    for (long i = 0; i < frames; i++) {
+        size_t frameSize = 0;
+        for (int device = 0; device < devices; device++) {
+            outputsOf(i, device, stats->last[device]);
+            frameSize += LP50XXSerialEncoder::EncodePacket(device, OUT0_COLOR, stats->last[device], OUTPUTS, device == devices - 1, &frame[frameSize]);
+        }
+
+        bool corrupt = corruptEvery > 0 && i % corruptEvery == corruptEvery - 1;
+        for (;;) {
+            // Only the first attempt is corrupted, any byte including the header
+            uint8_t sent[sizeof(frame)];
+            memcpy(sent, frame, frameSize);
+            if (corrupt) {
+                sent[rand() % frameSize] ^= 1 << (rand() % 8);
+                corrupt = false;
+            }
+
+            double start = now();
+            if (write(fd, sent, frameSize) != (ssize_t)frameSize) {
+                perror("write");
+                exit(1);
+            }
+
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            uint8_t answer = 0;
+            if (poll(&pfd, 1, timeout) > 0 && read(fd, &answer, 1) == 1) {
+                if (answer == LP50XX_SERIAL_ACK) {
+                    double latency = now() - start;
+                    stats->latencySum += latency;
+                    if (latency < stats->latencyMin) stats->latencyMin = latency;
+                    if (latency > stats->latencyMax) stats->latencyMax = latency;
+                    break;
+                }
+                stats->retries++;
+                continue;
+            }
+
+            stats->timeouts++;
+            stats->retries++;
+            while (poll(&pfd, 1, timeout) > 0 && read(fd, &answer, 1) == 1) {
+            }
+        }
+        stats->frames++;
+    }
+    close(fd);
+}
+
+/**
+ * @brief Feeds a frame with a corrupt CRC in its last packet and then the clean resend
+ *
+ * @return true when the corrupt frame got no answer and the resend completed
+ */
+static bool checkEndOfFrameCRC() {
+    LP50XX drivers[2];
+    LP50XX *pointers[2] = { &drivers[0], &drivers[1] };
+    LP50XXSerialReceiver receiver(pointers, 2);
+
+    uint8_t frame[2 * (OUTPUTS + LP50XX_SERIAL_OVERHEAD)];
+    uint8_t outputs[OUTPUTS];
+    size_t frameSize = 0;
+    for (int device = 0; device < 2; device++) {
+        outputsOf(1, device, outputs);
+        frameSize += LP50XXSerialEncoder::EncodePacket(device, OUT0_COLOR, outputs, OUTPUTS, device == 1, &frame[frameSize]);
+    }
+
+    bool ok = true;
+    frame[frameSize - 1] ^= 0x01;
+    for (size_t i = 0; i < frameSize; i++) {
+        ok &= receiver.Feed(frame[i]) != SerialFrameComplete;
+    }
+    frame[frameSize - 1] ^= 0x01;
+    ESerialStatus status = SerialBusy;
+    for (size_t i = 0; i < frameSize; i++) {
+        status = receiver.Feed(frame[i]);
+    }
+    return ok && status == SerialFrameComplete;
+}
+
+int main(int argc, char **argv) {
+    int devices = 2;
+    long frames = 2000;
+    long corruptEvery = 0;
+    int timeout = 20;
+    bool external = false;
+    LP50XXBusTiming timing;
+
+    int option;
+    while ((option = getopt(argc, argv, "d:n:x:t:c:e")) != -1) {
+        switch (option)
+        {
+        case 'd': devices = strtol(optarg, NULL, 0); break;
+        case 'n': frames = strtol(optarg, NULL, 0); break;
+        case 'x': corruptEvery = strtol(optarg, NULL, 0); break;
+        case 't': timeout = strtol(optarg, NULL, 0); break;
+        case 'c': timing.SetClock(strtoul(optarg, NULL, 0)); break;
+        case 'e': external = true; break;
+        default:
+            fprintf(stderr, "Usage: %s [-d devices] [-n frames] [-x corrupt every nth frame] [-t timeout ms] [-c i2c clock] [-e]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (devices < 1 || devices > MAX_DEVICES || frames < 1) {
+        fprintf(stderr, "Usage: %s [-d devices] [-n frames] [-x corrupt every nth frame] [-t timeout ms] [-c i2c clock] [-e]\n", argv[0]);
+        return 1;
+    }
+
+    if (!checkEndOfFrameCRC()) {
+        printf("resend after a corrupt last packet is not acknowledged\n");
+        return 1;
+    }
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+    const char *port = ptsname(master);
+    struct termios tio;
+    if (tcgetattr(master, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(master, TCSANOW, &tio);
+    }
+
+    SimulatedBus bus;
+    bus.SetTiming(&timing);
+    LP50XX drivers[MAX_DEVICES];
+    LP50XX *pointers[MAX_DEVICES];
+    for (int i = 0; i < devices; i++) {
+        drivers[i].SetTransport(&bus);
+        drivers[i].Begin(0x14 + i);
+        drivers[i].Flush();
+        pointers[i] = &drivers[i];
+    }
+    uint8_t initial[MAX_DEVICES][LP50XX_REGISTER_COUNT];
+    memcpy(initial, bus.registers, sizeof(initial));
+    bus.transactions = 0;
+
+    LP50XXSerialReceiver receiver(pointers, devices);
+    SenderStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.latencyMin = 1e9;
+    std::atomic<bool> done(false);
+    std::thread thread;
+    if (external) {
+        printf("Receiving on %s\n", port);
+        fflush(stdout);
+    } else {
+        thread = std::thread([&]() {
+            sender(port, devices, frames, corruptEvery, timeout, &stats);
+            done = true;
+        });
+    }
+
+    long flushed = 0, naks = 0;
+    double flushTime = 0;
+    double start = now();
+    while (!done) {
+        struct pollfd pfd = { master, POLLIN, 0 };
+        if (poll(&pfd, 1, 10) <= 0) {
+            continue;
+        }
+        uint8_t buffer[256];
+        ssize_t count = read(master, buffer, sizeof(buffer));
+        for (ssize_t i = 0; i < count; i++) {
+            ESerialStatus status = receiver.Feed(buffer[i]);
+            uint8_t answer;
+            if (status == SerialFrameComplete) {
+                double flushStart = now();
+                answer = receiver.FlushFrame() == 0 ? LP50XX_SERIAL_ACK : LP50XX_SERIAL_NAK;
+                flushTime += now() - flushStart;
+                flushed++;
+            } else if (status == SerialFrameError) {
+                answer = LP50XX_SERIAL_NAK;
+            } else {
+                continue;
+            }
+            naks += answer == LP50XX_SERIAL_NAK;
+            if (write(master, &answer, 1) != 1) {
+                perror("write");
+                return 1;
+            }
+        }
+    }
+    double elapsed = now() - start;
+    thread.join();
+
+    printf("%ld frames in %.3f s: %.1f frames/s, %ld flushes, %ld NAKs, %ld timeouts, %lu transactions\n",
+           stats.frames, elapsed, stats.frames / elapsed, flushed, naks, stats.timeouts, bus.transactions.load());
+    printf("Latency min %.3f ms, avg %.3f ms, max %.3f ms, flush avg %.3f ms\n", stats.latencyMin * 1e3,
+           stats.latencySum / stats.frames * 1e3, stats.latencyMax * 1e3, flushed ? flushTime / flushed * 1e3 : 0);
+
+    int differences = 0;
+    for (int i = 0; i < devices; i++) {
+        memcpy(&initial[i][OUT0_COLOR], stats.last[i], OUTPUTS);
+        if (memcmp(bus.registers[i], initial[i], LP50XX_REGISTER_COUNT) != 0) {
+            printf("device 0x%02X differs\n", 0x14 + i);
+            differences++;
+        }
+    }
+    printf("%s\n", differences == 0 ? "devices match" : "devices differ");
+    close(master);
+    return differences != 0;
+}
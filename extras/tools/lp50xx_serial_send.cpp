@@ -0,0 +1,160 @@
+/**
+ * @file lp50xx_serial_send.cpp
+ * @brief Host tool that streams test frames with the LP50XX serial protocol and measures latency and frame rate
+ *
+ * Build: g++ -O2 -I../../src -o lp50xx_serial_send lp50xx_serial_send.cpp ../../src/LP50XX_SerialEncoder.cpp
+ *
+ * The port can be a USB serial port running the SerialStreaming example, or the pseudo-terminal printed by
+ * lp50xx_serial_receive -e, which runs the receiver on the computer itself.
+ *
+ * Usage: lp50xx_serial_send [-b baud] [-d devices] [-n frames] [-t timeout ms] port
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LP50XX_Serial.h"
+
+#define OUTPUT_REGISTER 0x0B    // OUT0_COLOR
+#define OUTPUTS 12
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static speed_t baudrate(long baud) {
+    switch (baud)
+    {
+    case 9600: return B9600;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 500000: return B500000;
+    case 1000000: return B1000000;
+    case 2000000: return B2000000;
+    default:
+        fprintf(stderr, "Unsupported baudrate %ld\n", baud);
+        exit(1);
+    }
+}
+
+static bool writeAll(int fd, const uint8_t *pdata, size_t count) {
+    while (count) {
+        ssize_t written = write(fd, pdata, count);
+        if (written < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            return false;
+        }
+        pdata += written;
+        count -= written;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    long baud = 115200;
+    int devices = 1;
+    long frames = 1000;
+    int timeout = 100;
+
+    int option;
+    while ((option = getopt(argc, argv, "b:d:n:t:")) != -1) {
+        switch (option)
+        {
+        case 'b':
+            baud = strtol(optarg, NULL, 0);
+            break;
+        case 'd':
+            devices = strtol(optarg, NULL, 0);
+            break;
+        case 'n':
+            frames = strtol(optarg, NULL, 0);
+            break;
+        case 't':
+            timeout = strtol(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-b baud] [-d devices] [-n frames] [-t timeout ms] port\n", argv[0]);
+            return 1;
+        }
+    }
+    if (argc - optind != 1 || devices < 1 || devices > 127 || frames < 1) {
+        fprintf(stderr, "Usage: %s [-b baud] [-d devices] [-n frames] [-t timeout ms] port\n", argv[0]);
+        return 1;
+    }
+
+    int fd = open(argv[optind], O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, baudrate(baud));
+        cfsetospeed(&tio, baudrate(baud));
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    tcflush(fd, TCIOFLUSH);
+
+    uint8_t frame[127 * (OUTPUTS + LP50XX_SERIAL_OVERHEAD)];
+    double latencyMin = 1e9, latencyMax = 0, latencySum = 0;
+    long retries = 0;
+    size_t frameSize = 0;
+    double start = now();
+
+    for (long i = 0; i < frames; i++) {
+        frameSize = 0;
+        for (int device = 0; device < devices; device++) {
+            uint8_t outputs[OUTPUTS];
+            for (int output = 0; output < OUTPUTS; output++) {
+                outputs[output] = (uint8_t)(i + device * OUTPUTS + output);
+            }
+            frameSize += LP50XXSerialEncoder::EncodePacket(device, OUTPUT_REGISTER, outputs, OUTPUTS, device == devices - 1, &frame[frameSize]);
+        }
+
+        // Only one frame is in flight, the next frame is sent after the ACK. NAKs and timeouts resend the frame
+        for (;;) {
+            double sent = now();
+            if (!writeAll(fd, frame, frameSize)) {
+                perror("write");
+                return 1;
+            }
+
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            uint8_t answer = 0;
+            if (poll(&pfd, 1, timeout) > 0 && read(fd, &answer, 1) == 1) {
+                if (answer == LP50XX_SERIAL_ACK) {
+                    double latency = now() - sent;
+                    latencySum += latency;
+                    if (latency < latencyMin) latencyMin = latency;
+                    if (latency > latencyMax) latencyMax = latency;
+                    break;
+                }
+                retries++;
+                tcflush(fd, TCIFLUSH);
+                continue;
+            }
+            // The answer of the timed out attempt may still arrive, drain it so it is not taken for the answer of the resend
+            retries++;
+            while (poll(&pfd, 1, timeout) > 0 && read(fd, &answer, 1) == 1) {
+            }
+        }
+    }
+
+    double elapsed = now() - start;
+    printf("%ld frames of %zu bytes in %.3f s: %.1f frames/s, %ld retries\n", frames, frameSize, elapsed, frames / elapsed, retries);
+    printf("Latency min %.3f ms, avg %.3f ms, max %.3f ms\n", latencyMin * 1e3, latencySum / frames * 1e3, latencyMax * 1e3);
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file lp50xx_snapshot_bench.cpp
+ * @brief Host tool that compares dumping a device register by register with a snapshot in one burst, and
+ * migrates the state to a second device with a stored snapshot
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_snapshot_bench ../extras/tools/lp50xx_snapshot_bench.cpp *.cpp -lpthread
+ *
+ * Two LP5012 share a simulated bus that counts the transactions and their wire time at the clock of -c (see
+ * LP50XX_BusTiming.h). The device at 0x14 is configured and colored, its map is read with ReadRegister(), with
+ * CaptureSnapshot() and stored with Serialize(). The stored snapshot is restored on the device at 0x15 and both
+ * devices are compared.
+ *
+ * Usage: lp50xx_snapshot_bench [-c clock Hz]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "LP50XX.h"
+#include "LP50XX_Snapshot.h"
+
+/**
+ * @brief Simulated bus with auto incrementing devices at 0x14 and 0x15
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        uint8_t registers[2][LP50XX_REGISTER_COUNT];
+        uint32_t transactions = 0;
+        uint32_t timeNs = 0;
+
+        SimulatedBus() {
+            memset(registers, 0, sizeof(registers));
+        }
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            transactions++;
+            timeNs += GetTiming().GetWriteTime(count);
+            for (uint32_t i = 0; i < count && registerAddress + i < LP50XX_REGISTER_COUNT; i++) {
+                registers[deviceAddress - 0x14][registerAddress + i] = pdata[i];
+            }
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            transactions++;
+            timeNs += GetTiming().GetReadTime(count);
+            for (uint32_t i = 0; i < count; i++) {
+                pdata[i] = registerAddress + i < LP50XX_REGISTER_COUNT ? registers[deviceAddress - 0x14][registerAddress + i] : 0;
+            }
+            return 0;
+        }
+
+        void Reset() {
+            transactions = 0;
+            timeNs = 0;
+        }
+};
+
+static void report(const char *name, SimulatedBus &bus) {
+    printf("%-28s %3lu transactions, %6lu us\n", name, (unsigned long)bus.transactions, (unsigned long)(bus.timeNs / 1000));
+    bus.Reset();
+}
+
+int main(int argc, char **argv) {
+    LP50XXBusTiming timing;
+
+    int option;
+    while ((option = getopt(argc, argv, "c:")) != -1) {
+        switch (option)
+        {
+        case 'c': timing.SetClock(strtoul(optarg, NULL, 0)); break;
+        default:
+            fprintf(stderr, "Usage: %s [-c clock Hz]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SimulatedBus bus;
+    bus.SetTiming(&timing);
+    LP50XX source, target;
+    source.SetTransport(&bus);
+    target.SetTransport(&bus);
+    source.Begin(0x14);
+    target.Begin(0x15);
+
+    source.SetBankControl(LED_0 | LED_1);
+    source.SetBankColor(10, 20, 30);
+    for (uint8_t led = 2; led < 4; led++) {
+        source.StageLEDColor(led, led * 50, 255 - led * 50, 128);
+        source.StageLEDBrightness(led, 200);
+    }
+    source.Flush();
+    // Without an enable pin the auto increment of the target is only known after its first flush
+    target.Flush();
+    bus.Reset();
+
+    uint8_t values[LP50XX_REGISTER_COUNT];
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        source.ReadRegister(reg, &values[reg]);
+    }
+    report("ReadRegister() per register", bus);
+
+    source.ReadRegisters(0, values, LP50XX_REGISTER_COUNT);
+    report("ReadRegisters()", bus);
+
+    LP50XXSnapshot snapshot;
+    source.CaptureSnapshot(snapshot);
+    report("CaptureSnapshot()", bus);
+
+    uint8_t stored[LP50XX_SNAPSHOT_MAX_SIZE];
+    uint8_t length = snapshot.Serialize(stored);
+    printf("stored snapshot              %u of %u bytes:", length, LP50XX_SNAPSHOT_MAX_SIZE);
+    for (uint8_t i = 0; i < length; i++) {
+        printf(" %02X", stored[i]);
+    }
+    printf("\n");
+
+    LP50XXSnapshot loaded;
+    if (!loaded.Deserialize(stored, length)) {
+        printf("stored snapshot is invalid\n");
+        return 1;
+    }
+    target.RestoreSnapshot(loaded);
+    report("RestoreSnapshot()", bus);
+
+    int differences = 0;
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        if (bus.registers[0][reg] != bus.registers[1][reg] || target.GetShadowRegister(reg) != bus.registers[1][reg]) {
+            printf("register 0x%02X differs\n", reg);
+            differences++;
+        }
+    }
+    printf("%s, dirty registers of the target 0x%06lX\n", differences == 0 ? "devices match" : "devices differ",
+           (unsigned long)target.GetDirtyMask());
+    return differences != 0;
+}
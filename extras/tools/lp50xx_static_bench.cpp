@@ -0,0 +1,135 @@
+/**
+ * @file lp50xx_static_bench.cpp
+ * @brief Host benchmark comparing the code size and time per call of LP50XX and LP50XXStatic on a simulated bus
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_static_bench ../extras/tools/lp50xx_static_bench.cpp *.cpp -lpthread
+ *
+ * Every call is compiled into its own section, the size of the section is the code at the call site. The functions
+ * of LP50XX that the call sites jump to are shared by all call sites and reported by `nm -S` on the binary.
+ * Time is measured with the time stamp counter on x86 and with clock_gettime() elsewhere.
+ *
+ * Usage: lp50xx_static_bench [-n calls]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "LP50XX_Static.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TICKS() __rdtsc()
+#define TICK_UNIT "cycles"
+#else
+static unsigned long long ticks() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#define TICKS() ticks()
+#define TICK_UNIT "ns"
+#endif
+
+/**
+ * @brief Simulated bus that keeps the last written bytes and counts the transactions
+ */
+class SimulatedBus final : public LP50XXTransport
+{
+    public:
+        unsigned long transactions = 0;
+        uint8_t registers[0x20];
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            transactions++;
+            memcpy(&registers[registerAddress & 0x1F], pdata, count);
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            transactions++;
+            memcpy(pdata, &registers[registerAddress & 0x1F], count);
+            return 0;
+        }
+};
+
+typedef LP50XXStatic<SimulatedBus, 0x14, 0xFF, GRB> StaticDevice;
+
+#define CALL(name, sectionName, body) \
+    __attribute__((noinline, section(#sectionName))) void name(uint8_t index, uint8_t value) { body; } \
+    extern "C" char __start_##sectionName[], __stop_##sectionName[];
+
+static LP50XX *runtime;
+static StaticDevice *fixed;
+
+CALL(runtimeLEDColor, lp50xx_runtime_led, runtime->SetLEDColor(index, value, value, value))
+CALL(staticLEDColor, lp50xx_static_led, fixed->SetLEDColor(index, value, value, value))
+CALL(runtimeOutput, lp50xx_runtime_output, runtime->SetOutputColor(index, value))
+CALL(staticOutput, lp50xx_static_output, fixed->SetOutputColor(index, value))
+CALL(runtimeBrightness, lp50xx_runtime_brightness, runtime->SetLEDBrightness(index, value))
+CALL(staticBrightness, lp50xx_static_brightness, fixed->SetLEDBrightness(index, value))
+CALL(runtimeLED2Color, lp50xx_runtime_led2, runtime->SetLEDColor(2, value, 0, 0))
+CALL(staticLED2Color, lp50xx_static_led2, fixed->SetLEDColor(2, value, 0, 0))
+
+struct Call {
+    const char *name;
+    void (*function)(uint8_t, uint8_t);
+    const char *start;
+    const char *stop;
+    uint8_t indexCount;
+};
+
+static const Call calls[] = {
+    { "LP50XX::SetLEDColor(led)", runtimeLEDColor, __start_lp50xx_runtime_led, __stop_lp50xx_runtime_led, 4 },
+    { "LP50XXStatic::SetLEDColor(led)", staticLEDColor, __start_lp50xx_static_led, __stop_lp50xx_static_led, 4 },
+    { "LP50XX::SetLEDColor(2)", runtimeLED2Color, __start_lp50xx_runtime_led2, __stop_lp50xx_runtime_led2, 1 },
+    { "LP50XXStatic::SetLEDColor(2)", staticLED2Color, __start_lp50xx_static_led2, __stop_lp50xx_static_led2, 1 },
+    { "LP50XX::SetOutputColor", runtimeOutput, __start_lp50xx_runtime_output, __stop_lp50xx_runtime_output, 12 },
+    { "LP50XXStatic::SetOutputColor", staticOutput, __start_lp50xx_static_output, __stop_lp50xx_static_output, 12 },
+    { "LP50XX::SetLEDBrightness", runtimeBrightness, __start_lp50xx_runtime_brightness, __stop_lp50xx_runtime_brightness, 4 },
+    { "LP50XXStatic::SetLEDBrightness", staticBrightness, __start_lp50xx_static_brightness, __stop_lp50xx_static_brightness, 4 },
+};
+
+int main(int argc, char **argv) {
+    int count = 1000000;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:")) != -1) {
+        switch (option)
+        {
+        case 'n': count = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n calls]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SimulatedBus runtimeBus;
+    SimulatedBus staticBus;
+    LP50XX runtimeDevice(GRB);
+    runtimeDevice.SetTransport(&runtimeBus);
+    runtimeDevice.Begin(0x14);
+    StaticDevice staticDevice(staticBus);
+    staticDevice.Begin();
+    runtime = &runtimeDevice;
+    fixed = &staticDevice;
+
+    printf("%d calls per function, call site size in bytes, time in %s per call\n", count, TICK_UNIT);
+    printf("Call                             bytes  %6s  I2C/call\n", TICK_UNIT);
+    for (size_t i = 0; i < sizeof(calls) / sizeof(calls[0]); i++) {
+        SimulatedBus &bus = (i & 1) ? staticBus : runtimeBus;
+        bus.transactions = 0;
+        unsigned long long start = TICKS();
+        for (int n = 0; n < count; n++) {
+            calls[i].function(n % calls[i].indexCount, n);
+        }
+        unsigned long long ticks = TICKS() - start;
+        printf("%-31s  %5ld  %6.1f  %8.1f\n", calls[i].name, (long)(calls[i].stop - calls[i].start),
+               (double)ticks / count, (double)bus.transactions / count);
+    }
+
+    // LP50XX also writes DEVICE_CONFIG1 to enable auto increment, compare the LED registers only
+    bool equal = memcmp(&runtimeBus.registers[LED0_BRIGHTNESS], &staticBus.registers[LED0_BRIGHTNESS], OUT11_COLOR - LED0_BRIGHTNESS + 1) == 0;
+    printf("LED registers %s\n", equal ? "equal" : "DIFFERENT");
+    return equal ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file lp50xx_telemetry_report.cpp
+ * @brief Host tool that prints the telemetry of devices on a simulated, partly degraded bus
+ *
+ * Build from the src directory: g++ -O2 -I. -DLP50XX_TELEMETRY=1 -o lp50xx_telemetry_report ../extras/tools/lp50xx_telemetry_report.cpp *.cpp -lpthread
+ *
+ * Four devices share a simulated 400 kHz bus, the device at 0x17 does not acknowledge a share of its
+ * transactions. The report shows the counters of the bus and of every device as an application would log them.
+ * With a retry policy (see LP50XX_Retry.h) it also shows the repeats, the final failures and the frames that
+ * ended with registers still dirty.
+ *
+ * Usage: lp50xx_telemetry_report [-n frames] [-e nack permille] [-r attempts] [-b backoff us] [-t frame budget us]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "LP50XX.h"
+
+#if !LP50XX_TELEMETRY
+#error "Build with -DLP50XX_TELEMETRY=1"
+#endif
+
+/**
+ * @brief Simulated bus that takes the time of the bytes at 400 kHz and fails a share of the transactions to 0x17
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        int nackPermille = 20;
+
+        SimulatedBus() {
+            memset(_registers, 0, sizeof(_registers));
+        }
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            unsigned long start = micros();
+            wait(start, count + 2);
+            int8_t status = fail(deviceAddress) ? 2 : 0;
+            if (status == 0) {
+                memcpy(&_registers[deviceAddress & 0x7F][registerAddress & 0x1F], pdata, count);
+            }
+            _telemetry.Record(TelemetryWrite, deviceAddress, count, status, micros() - start);
+            return status;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            unsigned long start = micros();
+            wait(start, count + 3);
+            memcpy(pdata, &_registers[deviceAddress & 0x7F][registerAddress & 0x1F], count);
+            int8_t status = fail(deviceAddress) ? 2 : 0;
+            _telemetry.Record(TelemetryRead, deviceAddress, count, status, micros() - start);
+            return status;
+        }
+
+    private:
+        uint8_t _registers[128][0x40];
+
+        // 9 clocks of 2.5 us per byte at 400 kHz
+        void wait(unsigned long start, uint32_t bytes) {
+            while (micros() - start < bytes * 45 / 2) {
+            }
+        }
+
+        bool fail(uint8_t deviceAddress) {
+            return deviceAddress == 0x17 && rand() % 1000 < nackPermille;
+        }
+};
+
+static void printTelemetry(const char *name, const LP50XXTelemetry &telemetry) {
+    static const char *operations[TelemetryOperationCount] = { "write", "read", "probe" };
+
+    printf("%s\n", name);
+    printf("  transactions  write %lu, read %lu, probe %lu\n", (unsigned long)telemetry.transactions[TelemetryWrite],
+           (unsigned long)telemetry.transactions[TelemetryRead], (unsigned long)telemetry.transactions[TelemetryProbe]);
+    printf("  bytes         payload %lu, overhead %lu\n", (unsigned long)telemetry.payloadBytes, (unsigned long)telemetry.overheadBytes);
+    printf("  errors        nack %lu, timeout %lu, other %lu\n", (unsigned long)telemetry.nacks, (unsigned long)telemetry.timeouts,
+           (unsigned long)telemetry.errors);
+    if (telemetry.retries != 0 || telemetry.failures != 0) {
+        printf("  retry policy  retries %lu, failures %lu\n", (unsigned long)telemetry.retries, (unsigned long)telemetry.failures);
+    }
+    for (uint8_t i = 0; i < telemetry.addressCount; i++) {
+        const LP50XXAddressErrors &errors = telemetry.addresses[i];
+        printf("    0x%02X        nack %u, timeout %u, other %u\n", errors.address, errors.nacks, errors.timeouts, errors.errors);
+    }
+    for (uint8_t operation = 0; operation < TelemetryOperationCount; operation++) {
+        if (telemetry.transactions[operation] == 0) {
+            continue;
+        }
+        printf("  %-5s us     ", operations[operation]);
+        for (uint8_t bucket = 0; bucket < LP50XX_TELEMETRY_BUCKETS; bucket++) {
+            if (telemetry.latency[operation][bucket] != 0) {
+                printf(" <%lu:%u", 1UL << bucket, telemetry.latency[operation][bucket]);
+            }
+        }
+        printf(", max %lu\n", (unsigned long)telemetry.latencyMaxUs[operation]);
+    }
+}
+
+int main(int argc, char **argv) {
+    int frames = 1000;
+    SimulatedBus bus;
+    LP50XXRetryPolicy retry;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:e:r:b:t:")) != -1) {
+        switch (option)
+        {
+        case 'n': frames = atoi(optarg); break;
+        case 'e': bus.nackPermille = atoi(optarg); break;
+        case 'r': retry.SetMaxAttempts(atoi(optarg)); break;
+        case 'b': retry.SetBackoff(atoi(optarg)); break;
+        case 't': retry.SetFrameBudget(strtoul(optarg, NULL, 0)); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n frames] [-e nack permille] [-r attempts] [-b backoff us] [-t frame budget us]\n", argv[0]);
+            return 1;
+        }
+    }
+    bus.SetRetryPolicy(&retry);
+
+    LP50XX devices[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        devices[i].SetTransport(&bus);
+        devices[i].Begin(0x14 + i);
+        devices[i].Flush();
+        devices[i].ResetTelemetry();
+    }
+    bus.ResetTelemetry();
+
+    int dirtyFrames = 0;
+    unsigned long maxRetryUs = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        retry.BeginFrame();
+        bool dirty = false;
+        for (uint8_t i = 0; i < 4; i++) {
+            for (uint8_t led = 0; led < 4; led++) {
+                devices[i].StageLEDColor(led, frame, frame * 3, led * 64);
+            }
+            devices[i].Flush();
+            dirty |= devices[i].GetDirtyMask() != 0;
+        }
+        dirtyFrames += dirty;
+        if (retry.GetBudgetUsed() > maxRetryUs) {
+            maxRetryUs = retry.GetBudgetUsed();
+        }
+        if (frame % 100 == 0) {
+            uint8_t value;
+            devices[frame / 100 % 4].ReadRegister(DEVICE_CONFIG1, &value);
+        }
+    }
+
+    printf("retry policy %u attempts, backoff %u us, budget %lu us: %d of %d frames left registers dirty, "
+           "max %lu us of repeats per frame\n", retry.GetMaxAttempts(), retry.GetBackoff(), (unsigned long)retry.GetFrameBudget(),
+           dirtyFrames, frames, maxRetryUs);
+
+    LP50XXTelemetry telemetry;
+    bus.GetTelemetry(&telemetry);
+    printTelemetry("bus", telemetry);
+    for (uint8_t i = 0; i < 4; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "device 0x%02X", 0x14 + i);
+        devices[i].GetTelemetry(&telemetry);
+        printTelemetry(name, telemetry);
+    }
+    return 0;
+}
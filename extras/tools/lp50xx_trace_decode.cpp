@@ -0,0 +1,188 @@
+/**
+ * @file lp50xx_trace_decode.cpp
+ * @brief Host tool that decodes a binary trace dump of LP50XXTrace::Dump into text and summary statistics
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_trace_decode ../extras/tools/lp50xx_trace_decode.cpp LP50XX_BusTiming.cpp
+ *
+ * The dump is read from a file or from stdin, e.g. captured from the serial port with
+ * `stty -F /dev/ttyACM0 115200 raw && cat /dev/ttyACM0 > trace.bin`. Several dumps may follow each other.
+ *
+ * With -c every event is annotated with the time it took on the wire according to @ref LP50XXBusTiming, the
+ * summary adds the bus utilization and the time spent on addressing instead of register values.
+ *
+ * Usage: lp50xx_trace_decode [-s] [-c clockHz] [file]
+ *        -s  Only print the summary
+ *        -c  SCL clock for the wire time estimate, e.g. 400000
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "LP50XX_BusTiming.h"
+
+#define MAX_PAYLOAD 255
+
+static const char *operations[4] = { "W", "R", "P", "?" };
+
+struct Summary {
+    unsigned long events = 0;
+    unsigned long lost = 0;
+    unsigned long operations[4] = { 0 };
+    unsigned long statuses[16] = { 0 };
+    unsigned long addressEvents[128] = { 0 };
+    unsigned long addressErrors[128] = { 0 };
+    unsigned long long bytes = 0;
+    uint32_t firstUs = 0;
+    uint32_t lastUs = 0;
+    uint32_t maxGapUs = 0;
+    unsigned long long wireNs = 0;
+    uint32_t firstWireNs = 0;
+    unsigned long long payloadNs = 0;
+};
+
+static uint32_t readLE(const uint8_t *buff, uint8_t count) {
+    uint32_t value = 0;
+    for (uint8_t i = count; i > 0; i--) {
+        value = value << 8 | buff[i - 1];
+    }
+    return value;
+}
+
+int main(int argc, char **argv) {
+    bool summaryOnly = false;
+    uint32_t clockHz = 0;
+
+    int option;
+    while ((option = getopt(argc, argv, "sc:")) != -1) {
+        switch (option)
+        {
+        case 's': summaryOnly = true; break;
+        case 'c': clockHz = strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "Usage: %s [-s] [-c clockHz] [file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    FILE *in = stdin;
+    if (optind < argc) {
+        in = fopen(argv[optind], "rb");
+        if (in == NULL) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    LP50XXBusTiming timing(clockHz != 0 ? clockHz : LP50XX_I2C_FAST);
+    Summary summary;
+    int payloadSize = -1;
+    bool haveSequence = false;
+    uint16_t nextSequence = 0;
+    uint8_t buff[10 + MAX_PAYLOAD];
+
+    if (!summaryOnly) {
+        printf("     time us    delta us    seq  op  addr  reg  len  status  %spayload\n", clockHz != 0 ? " wire us  " : "");
+    }
+
+    while (fread(buff, 1, 4, in) == 4) {
+        if (memcmp(buff, "LPTR", 4) == 0) {
+            if (fread(&buff[4], 1, 2, in) != 2) {
+                break;
+            }
+            if (buff[4] != 1) {
+                fprintf(stderr, "Unsupported trace version %u\n", buff[4]);
+                return 1;
+            }
+            payloadSize = buff[5];
+            continue;
+        }
+        if (payloadSize < 0) {
+            fprintf(stderr, "Missing trace header\n");
+            return 1;
+        }
+        if (fread(&buff[4], 1, 6 + payloadSize, in) != (size_t)(6 + payloadSize)) {
+            break;
+        }
+
+        uint32_t timeUs = readLE(buff, 4);
+        uint16_t sequence = readLE(&buff[4], 2);
+        uint8_t address = buff[6] & 0x7F;
+        uint8_t reg = buff[7];
+        uint8_t operation = buff[8] & 0x03;
+        uint8_t status = buff[8] >> 4;
+        uint8_t length = buff[9];
+
+        if (haveSequence && sequence != nextSequence) {
+            uint16_t gap = sequence - nextSequence;
+            summary.lost += gap;
+            if (!summaryOnly) {
+                printf("  ... %u events lost\n", gap);
+            }
+        }
+        uint32_t delta = summary.events > 0 ? timeUs - summary.lastUs : 0;
+        if (summary.events == 0) {
+            summary.firstUs = timeUs;
+        } else if (delta > summary.maxGapUs) {
+            summary.maxGapUs = delta;
+        }
+        haveSequence = true;
+        nextSequence = sequence + 1;
+
+        summary.events++;
+        summary.operations[operation]++;
+        summary.statuses[status]++;
+        summary.addressEvents[address]++;
+        if (status != 0) {
+            summary.addressErrors[address]++;
+        }
+        summary.bytes += length;
+        summary.lastUs = timeUs;
+
+        uint32_t wireNs = timing.GetTime(operation, length);
+        if (summary.wireNs == 0) {
+            summary.firstWireNs = wireNs;
+        }
+        summary.wireNs += wireNs;
+        summary.payloadNs += operation != 2 ? (unsigned long long)length * timing.GetByteTime() : 0;
+
+        if (!summaryOnly) {
+            printf("%12lu  %10lu  %5u  %-2s  0x%02X  0x%02X  %3u  %6u ", (unsigned long)timeUs, (unsigned long)delta, sequence,
+                   operations[operation], address, reg, length, status);
+            if (clockHz != 0) {
+                printf(" %8.1f ", wireNs / 1e3);
+            }
+            for (int i = 0; i < payloadSize && i < length; i++) {
+                printf(" %02X", buff[10 + i]);
+            }
+            printf("%s\n", length > payloadSize && operation != 2 ? " ..." : "");
+        }
+    }
+
+    double spanS = (summary.lastUs - summary.firstUs) / 1e6;
+    printf("\nEvents %lu (write %lu, read %lu, probe %lu), lost %lu, register values %llu\n", summary.events,
+           summary.operations[0], summary.operations[1], summary.operations[2], summary.lost, summary.bytes);
+    printf("Span %.3f s, %.1f transactions/s, mean gap %.1f us, max gap %lu us\n", spanS,
+           spanS > 0 ? summary.events / spanS : 0.0, summary.events > 1 ? spanS * 1e6 / (summary.events - 1) : 0.0,
+           (unsigned long)summary.maxGapUs);
+    if (clockHz != 0 && summary.wireNs > 0) {
+        // The timestamps are taken at the end of the transactions, the first one started its wire time earlier
+        double busyS = summary.wireNs / 1e9;
+        double windowS = spanS + summary.firstWireNs / 1e9;
+        printf("Wire time at %lu Hz %.3f ms, utilization %.1f %%, register values %.1f %% of the wire time\n",
+               (unsigned long)clockHz, busyS * 1e3, 100.0 * busyS / windowS,
+               100.0 * summary.payloadNs / summary.wireNs);
+    }
+    for (int status = 1; status < 16; status++) {
+        if (summary.statuses[status] != 0) {
+            printf("Status %d: %lu\n", status, summary.statuses[status]);
+        }
+    }
+    for (int address = 0; address < 128; address++) {
+        if (summary.addressEvents[address] != 0) {
+            printf("Address 0x%02X: %lu transactions, %lu errors\n", address, summary.addressEvents[address], summary.addressErrors[address]);
+        }
+    }
+    return 0;
+}
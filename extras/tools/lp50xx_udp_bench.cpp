@@ -0,0 +1,147 @@
+/**
+ * @file lp50xx_udp_bench.cpp
+ * @brief Host benchmark for the Art-Net ingest over loopback with a simulated I2C bus
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_udp_bench ../extras/tools/lp50xx_udp_bench.cpp *.cpp -lpthread
+ *
+ * A sender thread sends ArtDmx packets to 127.0.0.1 while the ingest coalesces them into frames. The I2C functions
+ * are implemented here by a simulated bus that takes the wire time of every transaction at the given clock.
+ *
+ * Usage: lp50xx_udp_bench [-d devices] [-u universes] [-r packets/s] [-f fps] [-c i2c clock] [-s seconds]
+ */
+#include <arpa/inet.h>
+#include <atomic>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "LP50XX.h"
+#include "LP50XX_UDP.h"
+#include "I2C_coms.h"
+
+static unsigned long busClock = 400000;
+static std::atomic<unsigned long> transactions(0);
+
+// Simulated bus: START + address + register + payload bytes with ACK bits + STOP
+int8_t i2c_init() {
+    return 0;
+}
+
+int8_t i2c_write_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    transactions++;
+    delayMicroseconds((2 + count) * 9 * 1000000UL / busClock + 2);
+    return 0;
+}
+
+int8_t i2c_read_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    transactions++;
+    memset(pdata, 0, count);
+    delayMicroseconds((3 + count) * 9 * 1000000UL / busClock + 4);
+    return 0;
+}
+
+int8_t i2c_write_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t data) {
+    return i2c_write_multi(deviceAddress, registerAddress, &data, 1);
+}
+
+int8_t i2c_read_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *data) {
+    return i2c_read_multi(deviceAddress, registerAddress, data, 1);
+}
+
+int main(int argc, char **argv) {
+    int devices = 4;
+    int universes = 1;
+    int rate = 1000;
+    int fps = 100;
+    int seconds = 3;
+
+    int option;
+    while ((option = getopt(argc, argv, "d:u:r:f:c:s:")) != -1) {
+        switch (option)
+        {
+        case 'd': devices = atoi(optarg); break;
+        case 'u': universes = atoi(optarg); break;
+        case 'r': rate = atoi(optarg); break;
+        case 'f': fps = atoi(optarg); break;
+        case 'c': busClock = atol(optarg); break;
+        case 's': seconds = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-d devices] [-u universes] [-r packets/s] [-f fps] [-c i2c clock] [-s seconds]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (devices < 1 || devices > 64 || universes < 1 || rate < 1 || fps < 1) {
+        return 1;
+    }
+
+    // Every device gets 12 channels, the devices are spread evenly over the universes
+    std::vector<LP50XX> drivers(devices);
+    std::vector<LP50XX *> pointers;
+    std::vector<LP50XXPatch> patch;
+    for (int i = 0; i < devices; i++) {
+        drivers[i].Begin(0x14 + i % 4);
+        pointers.push_back(&drivers[i]);
+        LP50XXPatch entry = { (uint16_t)(i % universes), (uint16_t)(1 + (i / universes) * 12), (uint8_t)i, OUT0_COLOR, 12 };
+        patch.push_back(entry);
+    }
+
+    LP50XXUDPIngest ingest(pointers.data(), devices);
+    ingest.SetPatch(patch.data(), patch.size());
+    ingest.SetFrameRate(fps);
+    if (!ingest.Begin(LP50XX_ARTNET_PORT, "127.0.0.1")) {
+        perror("bind");
+        return 1;
+    }
+
+    std::atomic<bool> running(true);
+    std::thread sender([&]() {
+        int sock = socket(AF_INET, SOCK_DGRAM, 0);
+        struct sockaddr_in target = {};
+        target.sin_family = AF_INET;
+        target.sin_port = htons(LP50XX_ARTNET_PORT);
+        inet_pton(AF_INET, "127.0.0.1", &target.sin_addr);
+
+        uint8_t packet[18 + LP50XX_DMX_CHANNELS] = { 'A', 'r', 't', '-', 'N', 'e', 't', 0, 0x00, 0x50, 0, 14 };
+        packet[16] = LP50XX_DMX_CHANNELS >> 8;
+        packet[17] = LP50XX_DMX_CHANNELS & 0xFF;
+        unsigned long next = micros();
+        for (uint32_t sequence = 0; running; sequence++) {
+            packet[12] = sequence;
+            packet[14] = sequence % universes;
+            for (int i = 0; i < LP50XX_DMX_CHANNELS; i++) {
+                packet[18 + i] = sequence + i;
+            }
+            sendto(sock, packet, sizeof(packet), 0, (struct sockaddr *)&target, sizeof(target));
+            next += 1000000UL / rate;
+            long wait = (long)(next - micros());
+            if (wait > 0) {
+                delayMicroseconds(wait);
+            }
+        }
+        close(sock);
+    });
+
+    transactions = 0;
+    ingest.ResetStats();
+    unsigned long end = millis() + seconds * 1000UL;
+    while ((long)(end - millis()) > 0) {
+        ingest.Poll();
+    }
+    running = false;
+    sender.join();
+
+    LP50XXUDPStats stats;
+    ingest.GetStats(&stats);
+    double elapsed = stats.elapsedUs / 1e6;
+    printf("%d devices, %d universes, %d packets/s offered, %d fps, %lu Hz bus\n", devices, universes, rate, fps, busClock);
+    printf("Packets/s:      %.1f (%u rejected)\n", stats.packets / elapsed, stats.rejected);
+    printf("Frames/s:       %.1f (%u flush errors)\n", stats.frames / elapsed, stats.flushErrors);
+    printf("Latency:        avg %.3f ms, max %.3f ms (first packet of a frame until its flush completed)\n",
+           stats.frames ? stats.latencySumUs / 1e3 / stats.frames : 0.0, stats.latencyMaxUs / 1e3);
+    printf("I2C/frame:      %.2f transactions\n", stats.frames ? (double)transactions / stats.frames : 0.0);
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file lp50xx_vcd_capture.cpp
+ * @brief Host tool that runs an animation on a simulated bus and records the wire levels as a VCD file
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_vcd_capture ../extras/tools/lp50xx_vcd_capture.cpp *.cpp -lpthread
+ *
+ * Four devices at 0x14..0x17 are probed, started and flushed every frame, every tenth frame reads back
+ * DEVICE_CONFIG1 with a repeated start. The address 0x18 is probed as well and does not acknowledge.
+ * Open the result in a waveform viewer, e.g. `gtkwave bus.vcd`.
+ *
+ * Usage: lp50xx_vcd_capture [-c clockHz] [-n frames] [-r] [-o file]
+ *        -r  Keep the idle time between the transactions of the host instead of packing them
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "LP50XX.h"
+#include "LP50XX_Discovery.h"
+#include "LP50XX_Vcd.h"
+
+/**
+ * @brief Simulated bus with the register files of the devices at 0x14..0x17
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        uint32_t transactions = 0;
+
+        SimulatedBus() {
+            memset(_registers, 0, sizeof(_registers));
+        }
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            transactions++;
+            if (!present(deviceAddress)) {
+                return 2;
+            }
+            memcpy(&_registers[deviceAddress & 0x03][registerAddress & 0x1F], pdata, count);
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            transactions++;
+            if (!present(deviceAddress)) {
+                return 2;
+            }
+            memcpy(pdata, &_registers[deviceAddress & 0x03][registerAddress & 0x1F], count);
+            return 0;
+        }
+
+        int8_t Probe(uint8_t deviceAddress) {
+            transactions++;
+            return present(deviceAddress) ? 0 : 2;
+        }
+
+    private:
+        uint8_t _registers[4][0x40];
+
+        bool present(uint8_t deviceAddress) {
+            return deviceAddress >= 0x14 && deviceAddress <= 0x17;
+        }
+};
+
+int main(int argc, char **argv) {
+    uint32_t clockHz = LP50XX_I2C_FAST;
+    int frames = 100;
+    bool realTime = false;
+    const char *path = "bus.vcd";
+
+    int option;
+    while ((option = getopt(argc, argv, "c:n:ro:")) != -1) {
+        switch (option)
+        {
+        case 'c': clockHz = strtoul(optarg, NULL, 0); break;
+        case 'n': frames = atoi(optarg); break;
+        case 'r': realTime = true; break;
+        case 'o': path = optarg; break;
+        default:
+            fprintf(stderr, "Usage: %s [-c clockHz] [-n frames] [-r] [-o file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SimulatedBus bus;
+    LP50XXBusTiming timing(clockHz);
+    LP50XXVcdTransport vcd(bus);
+    vcd.SetTiming(&timing);
+    vcd.SetRealTime(realTime);
+    if (!vcd.Open(path)) {
+        perror(path);
+        return 1;
+    }
+
+    for (uint8_t address = 0x14; address <= 0x18; address++) {
+        LP50XXDiscovery::Probe(&vcd, address);
+    }
+
+    LP50XX devices[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        devices[i].SetTransport(&vcd);
+        devices[i].Begin(0x14 + i);
+        devices[i].Flush();
+    }
+
+    uint64_t frameStart = vcd.GetTime();
+    for (int frame = 0; frame < frames; frame++) {
+        for (uint8_t i = 0; i < 4; i++) {
+            for (uint8_t led = 0; led < 4; led++) {
+                devices[i].StageLEDColor(led, frame + led * 64, frame * 3, (frame >> 2) + i * 64);
+            }
+            devices[i].Flush();
+        }
+        if (frame % 10 == 0) {
+            uint8_t value;
+            devices[frame / 10 % 4].ReadRegister(DEVICE_CONFIG1, &value);
+        }
+    }
+    uint64_t end = vcd.GetTime();
+    vcd.Close();
+
+    printf("%s: %lu transactions, %.3f ms at %lu Hz", path, (unsigned long)bus.transactions, end / 1e6, (unsigned long)clockHz);
+    if (frames > 0) {
+        printf(", %.1f us per frame", (end - frameStart) / 1e3 / frames);
+    }
+    printf("\n");
+    return 0;
+}
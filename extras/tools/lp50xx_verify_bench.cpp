@@ -0,0 +1,192 @@
+/**
+ * @file lp50xx_verify_bench.cpp
+ * @brief Host tool that corrupts the registers of devices on a simulated bus and reports how the sampled
+ * read-back of LP50XX_Verifier.h finds and repairs them
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xx_verify_bench ../extras/tools/lp50xx_verify_bench.cpp *.cpp -lpthread
+ *
+ * Four LP5012 share a simulated 400 kHz bus that takes the wire time of every transaction. Every frame animates
+ * LED 0 of every device, the other registers stay as configured. Every -c frames a bit of a random register of a
+ * random device flips, every -x frames a device browns out and loses all registers. The report shows the bus time
+ * of the verifier against its share and the frames until the corrupted devices matched their shadow image again.
+ *
+ * Usage: lp50xx_verify_bench [-n frames] [-f frame us] [-b burst] [-p period] [-s share %] [-c frames] [-x frames]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "LP50XX.h"
+#include "LP50XX_Verifier.h"
+
+#define DEVICES 4
+
+/**
+ * @brief Simulated bus with auto incrementing devices at 0x14..0x17 that takes the wire time of the transactions
+ */
+class SimulatedBus : public LP50XXTransport
+{
+    public:
+        uint8_t registers[DEVICES][LP50XX_REGISTER_COUNT];
+        unsigned long busyUs = 0;
+
+        SimulatedBus() {
+            for (uint8_t i = 0; i < DEVICES; i++) {
+                Reset(i);
+            }
+        }
+
+        void Reset(uint8_t device) {
+            memset(registers[device], 0, sizeof(registers[device]));
+            registers[device][DEVICE_CONFIG1] = LOG_SCALE_ON | POWER_SAVE_ON | AUTO_INC_ON | PWM_DITHERING_ON;
+            memset(&registers[device][BANK_BRIGHTNESS], 0xFF, LED3_BRIGHTNESS - BANK_BRIGHTNESS + 1);
+        }
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            wait(GetTiming().GetWriteTime(count));
+            uint8_t *device = find(deviceAddress);
+            if (device == NULL) {
+                return 2;
+            }
+            for (uint32_t i = 0; i < count && registerAddress + i < LP50XX_REGISTER_COUNT; i++) {
+                device[registerAddress + i] = pdata[i];
+            }
+            return 0;
+        }
+
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            wait(GetTiming().GetReadTime(count));
+            uint8_t *device = find(deviceAddress);
+            if (device == NULL) {
+                return 2;
+            }
+            for (uint32_t i = 0; i < count; i++) {
+                pdata[i] = registerAddress + i < LP50XX_REGISTER_COUNT ? device[registerAddress + i] : 0;
+            }
+            return 0;
+        }
+
+    private:
+        uint8_t *find(uint8_t deviceAddress) {
+            return deviceAddress >= 0x14 && deviceAddress < 0x14 + DEVICES ? registers[deviceAddress - 0x14] : NULL;
+        }
+
+        void wait(uint32_t timeNs) {
+            unsigned long start = micros();
+            while (micros() - start < timeNs / 1000) {
+            }
+            busyUs += timeNs / 1000;
+        }
+};
+
+/**
+ * @brief Returns whether the simulated device holds the shadow image of the driver
+ */
+static bool matches(SimulatedBus &bus, uint8_t index, LP50XX &device) {
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        if (bus.registers[index][reg] != device.GetShadowRegister(reg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int frames = 1000;
+    unsigned long frameUs = 2000;
+    int corruptFrames = 50;
+    int brownoutFrames = 0;
+    LP50XXVerifier verifier;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:f:b:p:s:c:x:")) != -1) {
+        switch (option)
+        {
+        case 'n': frames = atoi(optarg); break;
+        case 'f': frameUs = strtoul(optarg, NULL, 0); break;
+        case 'b': verifier.SetBurst(atoi(optarg)); break;
+        case 'p': verifier.SetPeriod(atoi(optarg)); break;
+        case 's': verifier.SetShare(atoi(optarg)); break;
+        case 'c': corruptFrames = atoi(optarg); break;
+        case 'x': brownoutFrames = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-n frames] [-f frame us] [-b burst] [-p period] [-s share %%] [-c frames] [-x frames]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    SimulatedBus bus;
+    LP50XX devices[DEVICES];
+    for (uint8_t i = 0; i < DEVICES; i++) {
+        devices[i].SetTransport(&bus);
+        devices[i].Begin(0x14 + i);
+        for (uint8_t led = 1; led < 4; led++) {
+            devices[i].StageLEDColor(led, led * 40, 255 - led * 40, i * 60);
+        }
+        devices[i].Flush();
+        verifier.Add(devices[i]);
+    }
+    bus.busyUs = 0;
+    srand(1);
+
+    int corruptedAt[DEVICES];
+    int corruptions = 0, repaired = 0, latencySum = 0, latencyMax = 0;
+    for (uint8_t i = 0; i < DEVICES; i++) {
+        corruptedAt[i] = -1;
+    }
+
+    unsigned long start = micros();
+    unsigned long frameStart = start;
+    for (int frame = 1; frame <= frames; frame++) {
+        if (corruptFrames > 0 && frame % corruptFrames == 0) {
+            uint8_t index = rand() % DEVICES;
+            bus.registers[index][BANK_BRIGHTNESS + rand() % (LP50XX_REGISTER_COUNT - BANK_BRIGHTNESS)] ^= 1 << (rand() % 8);
+            corruptedAt[index] = corruptedAt[index] < 0 ? frame : corruptedAt[index];
+            corruptions++;
+        }
+        if (brownoutFrames > 0 && frame % brownoutFrames == 0) {
+            uint8_t index = rand() % DEVICES;
+            bus.Reset(index);
+            corruptedAt[index] = corruptedAt[index] < 0 ? frame : corruptedAt[index];
+            corruptions++;
+        }
+
+        for (uint8_t i = 0; i < DEVICES; i++) {
+            devices[i].StageLEDColor(0, frame, frame * 3, i * 64);
+            devices[i].Flush();
+        }
+        verifier.Verify();
+
+        for (uint8_t i = 0; i < DEVICES; i++) {
+            if (corruptedAt[i] >= 0 && matches(bus, i, devices[i])) {
+                int latency = frame - corruptedAt[i];
+                latencySum += latency;
+                latencyMax = latency > latencyMax ? latency : latencyMax;
+                corruptedAt[i] = -1;
+                repaired++;
+            }
+        }
+
+        frameStart += frameUs;
+        while ((long)(micros() - frameStart) < 0) {
+        }
+    }
+    unsigned long elapsedUs = micros() - start;
+
+    LP50XXVerifierStats stats;
+    verifier.GetStats(&stats);
+    printf("%d frames of %lu us, %u devices, burst %u registers every %u frames, share %u %%\n", frames, frameUs, DEVICES,
+           verifier.GetBurst(), verifier.GetPeriod(), verifier.GetShare());
+    printf("verifier     reads %lu, registers %lu, mismatches %lu, resyncs %lu, deferred %lu, failures %lu\n",
+           (unsigned long)stats.reads, (unsigned long)stats.registers, (unsigned long)stats.mismatches,
+           (unsigned long)stats.resyncs, (unsigned long)stats.deferred, (unsigned long)stats.failures);
+    for (uint8_t i = 0; i < DEVICES; i++) {
+        printf("  0x%02X       mismatches %lu\n", 0x14 + i, (unsigned long)verifier.GetMismatches(i));
+    }
+    printf("bus time     %lu us of %lu us, verifier %lu us (%.2f %%)\n", bus.busyUs, elapsedUs, (unsigned long)stats.busTimeUs,
+           100.0 * stats.busTimeUs / elapsedUs);
+    printf("corruptions  %d, repaired %d, frames until repaired mean %.1f, max %d\n", corruptions, repaired,
+           repaired != 0 ? (double)latencySum / repaired : 0.0, latencyMax);
+    return 0;
+}
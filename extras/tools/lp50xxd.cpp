@@ -0,0 +1,89 @@
+/**
+ * @file lp50xxd.cpp
+ * @brief LED server for Linux: owns an i2c-dev bus with LP5009/LP5012 devices and serves them on a Unix socket
+ *
+ * Build from the src directory: g++ -O2 -I. -o lp50xxd ../extras/tools/lp50xxd.cpp *.cpp -lpthread
+ *
+ * The devices are numbered in the order of their addresses, see @ref LP50XX_Daemon.h for the client protocol.
+ * Every frame is flushed as a single I2C_RDWR ioctl.
+ *
+ * Usage: lp50xxd [-b bus] [-a address,address,...] [-s socket] [-f fps]
+ */
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "LP50XX.h"
+#include "LP50XX_Daemon.h"
+#include "LP50XX_LinuxI2C.h"
+
+static volatile sig_atomic_t running = 1;
+
+static void stop(int) {
+    running = 0;
+}
+
+int main(int argc, char **argv) {
+    const char *busPath = LP50XX_LINUX_I2C_DEVICE;
+    const char *socketPath = "/run/lp50xx.sock";
+    char addresses[128] = "0x14";
+    int fps = LP50XX_DAEMON_DEFAULT_FPS;
+
+    int option;
+    while ((option = getopt(argc, argv, "b:a:s:f:")) != -1) {
+        switch (option)
+        {
+        case 'b': busPath = optarg; break;
+        case 'a': strncpy(addresses, optarg, sizeof(addresses) - 1); break;
+        case 's': socketPath = optarg; break;
+        case 'f': fps = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: %s [-b bus] [-a address,address,...] [-s socket] [-f fps]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    LP50XXLinuxI2C bus;
+    if (!bus.Open(busPath)) {
+        perror(busPath);
+        return 1;
+    }
+
+    std::vector<LP50XX *> devices;
+    for (char *token = strtok(addresses, ","); token != NULL; token = strtok(NULL, ",")) {
+        LP50XX *device = new LP50XX();
+        device->SetTransport(&bus);
+        device->Begin(strtoul(token, NULL, 0));
+        device->Flush();
+        devices.push_back(device);
+    }
+    if (devices.empty() || devices.size() > LP50XX_DAEMON_MAX_DEVICES) {
+        fprintf(stderr, "Between 1 and %d devices are supported\n", LP50XX_DAEMON_MAX_DEVICES);
+        return 1;
+    }
+
+    LP50XXDaemon daemon(devices.data(), devices.size());
+    daemon.SetFrameRate(fps);
+    if (!daemon.Begin(socketPath)) {
+        perror(socketPath);
+        return 1;
+    }
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+    signal(SIGPIPE, SIG_IGN);
+
+    // Every frame of Poll() is flushed as one batch of the bus
+    while (running) {
+        daemon.Poll();
+    }
+
+    daemon.End();
+    for (size_t i = 0; i < devices.size(); i++) {
+        delete devices[i];
+    }
+    return 0;
+}
@@ -1,57 +1,86 @@
 #include "I2C_coms.h"
+#include "LP50XX_Trace.h"
+#include "LP50XX_Profile.h"
+#include "LP50XX_BusRecovery.h"
 
-//#define I2C_DEBUG
+// Platforms other than Arduino and Linux provide their own implementation of these functions
+#ifdef ARDUINO
 
 int8_t i2c_init() {
     Wire.begin();
+#if defined(WIRE_HAS_TIMEOUT)
+    Wire.setWireTimeout(LP50XX_I2C_TIMEOUT_US, true);
+#endif
     return 0;
 }
 
+// Recovers Wire when it is stuck, see LP50XX_BusRecovery.h. 0 when the bus is free, 4 when it is still stuck
+static int8_t i2c_check_bus() {
+    LP50XXBusRecovery &recovery = LP50XXBusRecovery::Default();
+    if (!recovery.IsStuck()) {
+        return 0;
+    }
+    return recovery.Recover(Wire);
+}
+
 int8_t i2c_write_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
-    Wire.beginTransmission(deviceAddress);
-    Wire.write(registerAddress);
-#ifdef I2C_DEBUG
-    Serial.print("\tWriting "); Serial.print(count); Serial.print(" to addr 0x"); Serial.print(registerAddress, HEX); Serial.print(": ");
-#endif
-    while(count--) {
-        Wire.write((uint8_t)pdata[0]);
-#ifdef I2C_DEBUG
-        Serial.print("0x"); Serial.print(pdata[0], HEX); Serial.print(", ");
-#endif
-        pdata++;
+    LP50XX_PROFILE_SCOPE(ProfileI2CWrite);
+    int8_t status = i2c_check_bus();
+    if (status == 0) {
+        Wire.beginTransmission(deviceAddress);
+        Wire.write(registerAddress);
+        Wire.write(pdata, count);
+        status = Wire.endTransmission();
+        if (status != 0) {
+            // A repeat of the transaction finds a recovered bus
+            i2c_check_bus();
+        }
     }
-#ifdef I2C_DEBUG
-    Serial.println();
-#endif
-    return Wire.endTransmission();
+    LP50XX_TRACE_RECORD(TraceWrite, deviceAddress, registerAddress, pdata, count, status);
+    return status;
 }
 
 int8_t i2c_read_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count){
-    Wire.beginTransmission(deviceAddress);
-    Wire.write(registerAddress);
-    Wire.endTransmission(false); // Dont send a stop bit
-    Wire.requestFrom(deviceAddress, (byte)count);
-#ifdef I2C_DEBUG
-    Serial.print("\tReading "); Serial.print(count); Serial.print(" from addr 0x"); Serial.print(registerAddress, HEX); Serial.print(": ");
-#endif
+    LP50XX_PROFILE_SCOPE(ProfileI2CRead);
+    int8_t status = i2c_check_bus();
+    if (status == 0) {
+        Wire.beginTransmission(deviceAddress);
+        Wire.write(registerAddress);
+        status = Wire.endTransmission(false); // Dont send a stop bit
+        if (status == 0 && Wire.requestFrom(deviceAddress, (byte)count) != count) {
+            status = 4;
+        }
+        if (status != 0) {
+            i2c_check_bus();
+        }
+    }
 
-    while (count--) {
-        pdata[0] = Wire.read();
-#ifdef I2C_DEBUG
-        Serial.print("0x"); Serial.print(pdata[0], HEX); Serial.print(", ");
-#endif
-        pdata++;
+    // Bytes that were not received read as 0
+    for (uint32_t i = 0; i < count; i++) {
+        int value = status == 0 ? Wire.read() : -1;
+        pdata[i] = value >= 0 ? value : 0;
     }
-#ifdef I2C_DEBUG
-    Serial.println();
-#endif
-    return 0;
+    LP50XX_TRACE_RECORD(TraceRead, deviceAddress, registerAddress, pdata, count, status);
+    return status;
 }
 
 int8_t i2c_write_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t data) {
     return i2c_write_multi(deviceAddress, registerAddress, &data, 1);
 }
 
+int8_t i2c_probe(uint8_t deviceAddress) {
+    int8_t status = i2c_check_bus();
+    if (status == 0) {
+        Wire.beginTransmission(deviceAddress);
+        status = Wire.endTransmission();
+        if (status != 0) {
+            i2c_check_bus();
+        }
+    }
+    LP50XX_TRACE_RECORD(TraceProbe, deviceAddress, 0, NULL, 0, status);
+    return status;
+}
+
 // int8_t i2c_write_word(uint8_t deviceAddress, uint8_t registerAddress, uint16_t data) {
 //     uint8_t buff[2];
 //     buff[1] = data & 0xFF;
@@ -104,3 +133,39 @@ int8_t i2c_read_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *da
 
 //     return r;
 // }
+
+#elif defined(__linux__)
+
+#include "LP50XX_LinuxI2C.h"
+
+// The Linux functions are weak, so an application or simulator can still provide its own bus
+
+__attribute__((weak)) int8_t i2c_init() {
+    LP50XXLinuxI2C &bus = LP50XXLinuxI2C::Default();
+    if (!bus.IsOpen() && !bus.Open(LP50XX_LINUX_I2C_DEVICE)) {
+        return -1;
+    }
+    return 0;
+}
+
+__attribute__((weak)) int8_t i2c_write_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    return LP50XXLinuxI2C::Default().Write(deviceAddress, registerAddress, pdata, count);
+}
+
+__attribute__((weak)) int8_t i2c_read_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    return LP50XXLinuxI2C::Default().Read(deviceAddress, registerAddress, pdata, count);
+}
+
+__attribute__((weak)) int8_t i2c_write_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t data) {
+    return i2c_write_multi(deviceAddress, registerAddress, &data, 1);
+}
+
+__attribute__((weak)) int8_t i2c_read_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *data) {
+    return i2c_read_multi(deviceAddress, registerAddress, data, 1);
+}
+
+__attribute__((weak)) int8_t i2c_probe(uint8_t deviceAddress) {
+    return LP50XXLinuxI2C::Default().Probe(deviceAddress);
+}
+
+#endif
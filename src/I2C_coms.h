@@ -6,14 +6,24 @@
 #ifndef _I2C_COMS_H_
 #define _I2C_COMS_H_
 
-#include "Arduino.h"
+#include "LP50XX_Platform.h"
+#ifdef ARDUINO
 #include "Wire.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+#ifndef LP50XX_I2C_TIMEOUT_US
+#define LP50XX_I2C_TIMEOUT_US 25000     // Bus timeout set by i2c_init() where the Wire library supports it
+#endif
+
+#ifndef LP50XX_I2C_MAX_READ
+#define LP50XX_I2C_MAX_READ 32          // Bytes per read, the receive buffer of Wire on AVR
+#endif
+
 /** @brief i2c_init() definition.\n
  * 
  */
@@ -42,6 +52,11 @@ int8_t i2c_write_byte(
         uint8_t       deviceAddress,
         uint8_t       registerAddress,
         uint8_t       data);
+/** @brief i2c_probe() definition.\n
+ * Address only write, returns 0 when a device acknowledges the address
+ */
+int8_t i2c_probe(
+        uint8_t       deviceAddress);
 // /** @brief i2c_write_word() definition.\n
 //  * To be implemented by the developer
 //  */
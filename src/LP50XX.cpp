@@ -10,6 +10,8 @@
  */
 #include "LP50XX.h"
 #include "I2C_coms.h"
+#include "LP50XX_Profile.h"
+#include "LP50XX_Snapshot.h"
 
 /*----------------------- Initialisation functions --------------------------*/
 
@@ -62,9 +64,12 @@ LP50XX::LP50XX(LED_Configuration ledConfiguration, uint8_t enablePin) {
  * @brief Initializes the I2C bus and the LP5009 or LP5012
  * 
  * @param i2cAddress The I2C address of the device
+ * @return true when the device acknowledged
  */
 bool LP50XX::Begin(uint8_t i2cAddress) {
-    i2c_init();
+    if (_transport == NULL) {
+        i2c_init();
+    }
     _i2c_address = i2cAddress;
 
     if (_enable_pin != 0xFF) {
@@ -74,8 +79,22 @@ bool LP50XX::Begin(uint8_t i2cAddress) {
     // 500 us delay after enabling the device before I2C access is available
     delayMicroseconds(500);
 
+    resetShadow();
+    LP50XXBusRecovery *recovery = busRecovery();
+    _recoveries_seen = recovery != NULL ? recovery->GetRecoveries() : 0;
+    if (_enable_pin == 0xFF) {
+        // Without an enable pin the device was not power cycled, its registers may hold anything. The first Flush() resynchronizes it
+        _dirty = registerMask() & ~(1UL << DEVICE_CONFIG0);
+    }
+
     // Enable the Chip_EN bit to start up the device
-    i2c_write_byte(_i2c_address, DEVICE_CONFIG0, 1 << 6);
+    uint8_t chipEnable = 1 << 6;
+    if (busWriteByte(_i2c_address, DEVICE_CONFIG0, chipEnable) != 0) {
+        // Not acknowledged, the next Flush() retries
+        StageRegister(DEVICE_CONFIG0, chipEnable);
+        return false;
+    }
+    updateShadow(DEVICE_CONFIG0, &chipEnable, 1);
 
     return true;
 }
@@ -83,8 +102,9 @@ bool LP50XX::Begin(uint8_t i2cAddress) {
 /**
  * @brief Resets the device by using the enable pin if available and resetting the registers
  * 
+ * @return int8_t 0 on success, otherwise the status of the last failed transaction. Failed registers stay dirty
  */
-void LP50XX::Reset() {
+int8_t LP50XX::Reset() {
     if (_enable_pin != 0xFF) {
         digitalWrite(_enable_pin, LOW);
         delay(10);
@@ -93,19 +113,29 @@ void LP50XX::Reset() {
         delayMicroseconds(500);
     }
     
-    ResetRegisters();
+    int8_t result = ResetRegisters();
 
     // Enable the Chip_EN bit to start up the device
-    i2c_write_byte(_i2c_address, DEVICE_CONFIG0, 1 << 6);
+    uint8_t chipEnable = 1 << 6;
+    int8_t status = busWriteByte(_i2c_address, DEVICE_CONFIG0, chipEnable);
+    updateShadow(DEVICE_CONFIG0, &chipEnable, 1, status);
+    return status != 0 ? status : result;
 }
 
 /**
  * @brief Resets the registers to their original values
  * 
  * @param addressType the I2C address type to write to 
+ * @return int8_t 0 on success. On failure the whole shadow image is dirty, so the next @ref Flush writes the defaults
  */
-void LP50XX::ResetRegisters(EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), RESET_REGISTERS, 0xFF);
+int8_t LP50XX::ResetRegisters(EAddressType addressType) {
+    int8_t status = busWriteByte(getAddress(addressType), RESET_REGISTERS, 0xFF);
+    resetShadow();
+    if (status != 0) {
+        // The registers may still hold anything, like after a Begin() without an enable pin
+        _dirty = registerMask() & ~(1UL << DEVICE_CONFIG0);
+    }
+    return status;
 }
 
 
@@ -118,117 +148,73 @@ void LP50XX::ResetRegisters(EAddressType addressType) {
  * 
  * @param configuration The configuration of the device, this can be made by bitwise OR ('|') the enum @ref LP50XX_Configuration
  * @param addressType the I2C address type to write to 
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. A failed value stays dirty
  */
-void LP50XX::Configure(uint8_t configuration, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), DEVICE_CONFIG1, configuration & 0x3F);
+int8_t LP50XX::Configure(uint8_t configuration, EAddressType addressType) {
+    configuration &= 0x3F;
+    int8_t status = busWriteByte(getAddress(addressType), DEVICE_CONFIG1, configuration);
+    updateShadow(DEVICE_CONFIG1, &configuration, 1, status);
+    return status;
 }
 
 /**
  * @brief Sets the PWM scaling used by the device
  * 
  * @param scaling The scaling of the device. @ref LOG_SCALE_OFF @ref LOG_SCALE_ON
+ * @return int8_t 0 on success, see @ref updateConfiguration
  */
-void LP50XX::SetScaling(uint8_t scaling) {
-    uint8_t buff;
-    i2c_read_byte(_i2c_address, DEVICE_CONFIG1, &buff);
-
-    scaling = scaling & 1 << 5;
-    if (scaling >> 5 & 1) {
-        buff |= 1 << 5;
-    } else {
-        buff &= ~(1 << 5);
-    }
-    i2c_write_byte(_i2c_address, DEVICE_CONFIG1, buff);
+int8_t LP50XX::SetScaling(uint8_t scaling) {
+    return updateConfiguration(LOG_SCALE_ON, scaling);
 }
 
 /**
  * @brief Sets the power saving mode of the device
  * 
  * @param powerSave The power saving mode. @ref POWER_SAVE_OFF @ref POWER_SAVE_ON
+ * @return int8_t 0 on success, see @ref updateConfiguration
  */
-void LP50XX::SetPowerSaving(uint8_t powerSave) {
-    uint8_t buff;
-    i2c_read_byte(_i2c_address, DEVICE_CONFIG1, &buff);
-
-    powerSave = powerSave & 1 << 4;
-    if (powerSave >> 4 & 1) {
-        buff |= 1 << 4;
-    } else {
-        buff &= ~(1 << 4);
-    }
-    i2c_write_byte(_i2c_address, DEVICE_CONFIG1, buff);
+int8_t LP50XX::SetPowerSaving(uint8_t powerSave) {
+    return updateConfiguration(POWER_SAVE_ON, powerSave);
 }
 
 /**
  * @brief Sets the auto increment mode of the device
  * 
  * @param autoInc The auto increment mode. @ref AUTO_INC_OFF @ref AUTO_INC_ON
+ * @return int8_t 0 on success, see @ref updateConfiguration
  */
-void LP50XX::SetAutoIncrement(uint8_t autoInc) {
-    uint8_t buff;
-    i2c_read_byte(_i2c_address, DEVICE_CONFIG1, &buff);
-
-    autoInc = autoInc & 1 << 3;
-    if (autoInc >> 3 & 1) {
-        buff |= 1 << 3;
-    } else {
-        buff &= ~(1 << 3);
-    }
-    i2c_write_byte(_i2c_address, DEVICE_CONFIG1, buff);
+int8_t LP50XX::SetAutoIncrement(uint8_t autoInc) {
+    return updateConfiguration(AUTO_INC_ON, autoInc);
 }
 
 /**
  * @brief Sets the PWM dithering of the device
  * 
  * @param dithering The dithering mode. @ref PWM_DITHERING_OFF @ref PWM_DITHERING_ON
+ * @return int8_t 0 on success, see @ref updateConfiguration
  */
-void LP50XX::SetPWMDithering(uint8_t dithering) {
-    uint8_t buff;
-    i2c_read_byte(_i2c_address, DEVICE_CONFIG1, &buff);
-
-    dithering = dithering & 1 << 2;
-    if (dithering >> 2 & 1) {
-        buff |= 1 << 2;
-    } else {
-        buff &= ~(1 << 2);
-    }
-    i2c_write_byte(_i2c_address, DEVICE_CONFIG1, buff);
+int8_t LP50XX::SetPWMDithering(uint8_t dithering) {
+    return updateConfiguration(PWM_DITHERING_ON, dithering);
 }
 
 /**
  * @brief Sets the max current option of the device
  * 
  * @param option The max current option. @ref MAX_CURRENT_25mA @ref MAX_CURRENT_35mA
+ * @return int8_t 0 on success, see @ref updateConfiguration
  */
-void LP50XX::SetMaxCurrentOption(uint8_t option) {
-    uint8_t buff;
-    i2c_read_byte(_i2c_address, DEVICE_CONFIG1, &buff);
-
-    option = option & 1 << 1;
-    if (option >> 1 & 1) {
-        buff |= 1 << 1;
-    } else {
-        buff &= ~(1 << 1);
-    }
-    i2c_write_byte(_i2c_address, DEVICE_CONFIG1, buff);
+int8_t LP50XX::SetMaxCurrentOption(uint8_t option) {
+    return updateConfiguration(MAX_CURRENT_35mA, option);
 }
 
 /**
  * @brief Turns all LED outputs ON or OFF
  * 
  * @param value The desired setting. @ref LED_GLOBAL_OFF @ref LED_GLOBAL_ON
+ * @return int8_t 0 on success, see @ref updateConfiguration
  */
-void LP50XX::SetGlobalLedOff(uint8_t value) {
-    uint8_t buff;
-    i2c_read_byte(_i2c_address, DEVICE_CONFIG1, &buff);
-
-    value = value & 1 << 0;
-    if (value >> 0 & 1) {
-        buff |= 1 << 0;
-    } else {
-        buff &= ~(1 << 0);
-    }
-    i2c_write_byte(_i2c_address, DEVICE_CONFIG1, buff);
+int8_t LP50XX::SetGlobalLedOff(uint8_t value) {
+    return updateConfiguration(LED_GLOBAL_OFF, value);
 }
 
 
@@ -251,6 +237,78 @@ void LP50XX::SetLEDConfiguration(LED_Configuration ledConfiguration) {
     _led_configuration = ledConfiguration;
 }
 
+/**
+ * @brief Sets the bus the device is connected to. Without a transport the I2C functions of @ref I2C_coms.h are used
+ * 
+ * @param transport The bus, NULL for the I2C functions of @ref I2C_coms.h
+ */
+void LP50XX::SetTransport(LP50XXTransport *transport) {
+    _transport = transport;
+}
+
+/**
+ * @brief Returns the bus the device is connected to
+ * 
+ * @return LP50XXTransport* The bus, NULL when the I2C functions of @ref I2C_coms.h are used
+ */
+LP50XXTransport *LP50XX::GetTransport() {
+    return _transport;
+}
+
+/**
+ * @brief Returns the retry policy of failed bus transactions, see @ref LP50XX_Retry.h
+ * 
+ * @return LP50XXRetryPolicy& The policy of the transport, @ref LP50XXRetryPolicy::Default without a transport
+ */
+LP50XXRetryPolicy &LP50XX::GetRetryPolicy() {
+    return _transport != NULL ? _transport->GetRetryPolicy() : LP50XXRetryPolicy::Default();
+}
+
+/**
+ * @brief Sets the variant of the device. The LED, output and register functions ignore indices the variant does not have
+ * 
+ * @param variant The variant, @ref VariantUnknown accepts the indices of the LP5012
+ */
+void LP50XX::SetVariant(EVariant variant) {
+    _variant = variant;
+}
+
+/**
+ * @brief Returns the variant of the device
+ * 
+ * @return EVariant The variant set with @ref SetVariant
+ */
+EVariant LP50XX::GetVariant() {
+    return _variant;
+}
+
+/**
+ * @brief Returns the number of RGB LEDs of the variant
+ * 
+ * @return uint8_t 3 for the LP5009, otherwise 4
+ */
+uint8_t LP50XX::GetLEDCount() {
+    return _variant == VariantLP5009 ? 3 : 4;
+}
+
+/**
+ * @brief Returns the number of outputs of the variant
+ * 
+ * @return uint8_t 9 for the LP5009, otherwise 12
+ */
+uint8_t LP50XX::GetOutputCount() {
+    return GetLEDCount() * 3;
+}
+
+/**
+ * @brief Returns the I2C address of the device
+ * 
+ * @return uint8_t 
+ */
+uint8_t LP50XX::GetI2CAddress() {
+    return _i2c_address;
+}
+
 /**
  * @brief Sets the I2C address
  * 
@@ -270,9 +328,12 @@ void LP50XX::SetI2CAddress(uint8_t address) {
  * @param addressType the I2C address type to write to
  * 
  * @note Code example could be `SetBankControl(LED_0 | LED_1 | LED_2 | LED_3);`
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. A failed value stays dirty
  */
-void LP50XX::SetBankControl(uint8_t leds, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), LED_CONFIG0, leds);
+int8_t LP50XX::SetBankControl(uint8_t leds, EAddressType addressType) {
+    int8_t status = busWriteByte(getAddress(addressType), LED_CONFIG0, leds);
+    updateShadow(LED_CONFIG0, &leds, 1, status);
+    return status;
 }
 
 /**
@@ -280,9 +341,12 @@ void LP50XX::SetBankControl(uint8_t leds, EAddressType addressType) {
  * 
  * @param brightness The brightness level from 0 to 0xFF
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. A failed value stays dirty
  */
-void LP50XX::SetBankBrightness(uint8_t brightness, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), BANK_BRIGHTNESS, brightness);
+int8_t LP50XX::SetBankBrightness(uint8_t brightness, EAddressType addressType) {
+    int8_t status = busWriteByte(getAddress(addressType), BANK_BRIGHTNESS, brightness);
+    updateShadow(BANK_BRIGHTNESS, &brightness, 1, status);
+    return status;
 }
 
 /**
@@ -290,9 +354,12 @@ void LP50XX::SetBankBrightness(uint8_t brightness, EAddressType addressType) {
  * 
  * @param value The color value from 0 to 0xFF
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. A failed value stays dirty
  */
-void LP50XX::SetBankColorA(uint8_t value, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), BANK_A_COLOR, value);
+int8_t LP50XX::SetBankColorA(uint8_t value, EAddressType addressType) {
+    int8_t status = busWriteByte(getAddress(addressType), BANK_A_COLOR, value);
+    updateShadow(BANK_A_COLOR, &value, 1, status);
+    return status;
 }
 
 /**
@@ -300,9 +367,12 @@ void LP50XX::SetBankColorA(uint8_t value, EAddressType addressType) {
  * 
  * @param value The color value from 0 to 0xFF
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. A failed value stays dirty
  */
-void LP50XX::SetBankColorB(uint8_t value, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), BANK_B_COLOR, value);
+int8_t LP50XX::SetBankColorB(uint8_t value, EAddressType addressType) {
+    int8_t status = busWriteByte(getAddress(addressType), BANK_B_COLOR, value);
+    updateShadow(BANK_B_COLOR, &value, 1, status);
+    return status;
 }
 
 /**
@@ -310,9 +380,12 @@ void LP50XX::SetBankColorB(uint8_t value, EAddressType addressType) {
  * 
  * @param value The color value from 0 to 0xFF
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. A failed value stays dirty
  */
-void LP50XX::SetBankColorC(uint8_t value, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), BANK_C_COLOR, value);
+int8_t LP50XX::SetBankColorC(uint8_t value, EAddressType addressType) {
+    int8_t status = busWriteByte(getAddress(addressType), BANK_C_COLOR, value);
+    updateShadow(BANK_C_COLOR, &value, 1, status);
+    return status;
 }
 
 /**
@@ -322,46 +395,20 @@ void LP50XX::SetBankColorC(uint8_t value, EAddressType addressType) {
  * @param g The green color value from 0 to 0xFF
  * @param b The blue color value from 0 to 0xFF
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. Failed values stay dirty
  */
-void LP50XX::SetBankColor(uint8_t r, uint8_t g, uint8_t b, EAddressType addressType) {
-    SetAutoIncrement(AUTO_INC_ON);
+int8_t LP50XX::SetBankColor(uint8_t r, uint8_t g, uint8_t b, EAddressType addressType) {
+    int8_t status = SetAutoIncrement(AUTO_INC_ON);
 
     uint8_t buff[3];
-    switch (_led_configuration)
-    {
-    case RGB:
-        buff[0] = r;
-        buff[1] = g;
-        buff[2] = b;
-        break;
-    case GRB:
-        buff[0] = g;
-        buff[1] = r;
-        buff[2] = b;
-        break;
-    case BGR:
-        buff[0] = b;
-        buff[1] = g;
-        buff[2] = r;
-        break;
-    case RBG:
-        buff[0] = r;
-        buff[1] = b;
-        buff[2] = g;
-        break;
-    case GBR:
-        buff[0] = g;
-        buff[1] = b;
-        buff[2] = r;
-        break;
-    case BRG:
-        buff[0] = b;
-        buff[1] = r;
-        buff[2] = g;
-        break;
-    }
+    orderColor(r, g, b, buff);
 
-    i2c_write_multi(getAddress(addressType), BANK_A_COLOR, buff, 3);
+    // Without auto increment the burst would only reach the first register
+    if (status == 0) {
+        status = busWrite(getAddress(addressType), BANK_A_COLOR, buff, 3);
+    }
+    updateShadow(BANK_A_COLOR, buff, 3, status);
+    return status;
 }
 
 
@@ -370,73 +417,67 @@ void LP50XX::SetBankColor(uint8_t r, uint8_t g, uint8_t b, EAddressType addressT
 /**
  * @brief Sets the brightness level of a single LED (3 outputs)
  * 
- * @param led The led to set. 0..3
+ * @param led The led to set. 0..2 on the LP5009, 0..3 on the LP5012
  * @param brighness The brightness level from 0 to 0xFF
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, 4 for an LED the variant does not have, otherwise a Wire.endTransmission()
+ * compatible error. A failed value stays dirty
  */
-void LP50XX::SetLEDBrightness(uint8_t led, uint8_t brighness, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType),  LED0_BRIGHTNESS+ led, brighness);
+int8_t LP50XX::SetLEDBrightness(uint8_t led, uint8_t brighness, EAddressType addressType) {
+    if (led >= GetLEDCount()) {
+        return 4;
+    }
+    int8_t status = busWriteByte(getAddress(addressType),  LED0_BRIGHTNESS+ led, brighness);
+    updateShadow(LED0_BRIGHTNESS + led, &brighness, 1, status);
+    return status;
 }
 
 /**
  * @brief Sets the color level of a single output
  * 
- * @param output The output to set. 0..11
+ * @param output The output to set. 0..8 on the LP5009, 0..11 on the LP5012
  * @param value The color value from 0 to 0xFF
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, 4 for an output the variant does not have, otherwise a Wire.endTransmission()
+ * compatible error. A failed value stays dirty
  */
-void LP50XX::SetOutputColor(uint8_t output, uint8_t value, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), OUT0_COLOR + output, value);
+int8_t LP50XX::SetOutputColor(uint8_t output, uint8_t value, EAddressType addressType) {
+    LP50XX_PROFILE_SCOPE(ProfileSetOutputColor);
+    if (output >= GetOutputCount()) {
+        return 4;
+    }
+    int8_t status = busWriteByte(getAddress(addressType), OUT0_COLOR + output, value);
+    updateShadow(OUT0_COLOR + output, &value, 1, status);
+    return status;
 }
 
 /**
  * @brief Sets the LED color according to the set LED configuration @ref SetLEDConfiguration
  * 
- * @param led The led to set. 0..3
+ * @param led The led to set. 0..2 on the LP5009, 0..3 on the LP5012
  * @param r The red color value from 0 to 0xFF
  * @param g The green color value from 0 to 0xFF
  * @param b The blue color value from 0 to 0xFF
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, 4 for an LED the variant does not have, otherwise a Wire.endTransmission()
+ * compatible error. Failed values stay dirty
  */
-void LP50XX::SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b, EAddressType addressType) {
-    SetAutoIncrement(AUTO_INC_ON);
+int8_t LP50XX::SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b, EAddressType addressType) {
+    LP50XX_PROFILE_SCOPE(ProfileSetLEDColor);
+    if (led >= GetLEDCount()) {
+        return 4;
+    }
+    int8_t status = SetAutoIncrement(AUTO_INC_ON);
 
     uint8_t buff[3];
-    switch (_led_configuration)
-    {
-    case RGB:
-        buff[0] = r;
-        buff[1] = g;
-        buff[2] = b;
-        break;
-    case GRB:
-        buff[0] = g;
-        buff[1] = r;
-        buff[2] = b;
-        break;
-    case BGR:
-        buff[0] = b;
-        buff[1] = g;
-        buff[2] = r;
-        break;
-    case RBG:
-        buff[0] = r;
-        buff[1] = b;
-        buff[2] = g;
-        break;
-    case GBR:
-        buff[0] = g;
-        buff[1] = b;
-        buff[2] = r;
-        break;
-    case BRG:
-        buff[0] = b;
-        buff[1] = r;
-        buff[2] = g;
-        break;
-    }
+    orderColor(r, g, b, buff);
 
-    i2c_write_multi(getAddress(addressType), OUT0_COLOR + (led * 3), buff, 3);
+    // Without auto increment the burst would only reach the first register
+    if (status == 0) {
+        status = busWrite(getAddress(addressType), OUT0_COLOR + (led * 3), buff, 3);
+    }
+    updateShadow(OUT0_COLOR + (led * 3), buff, 3, status);
+    return status;
 }
 
 
@@ -448,9 +489,12 @@ void LP50XX::SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b, EAddressT
  * @param reg The register to write to
  * @param value The value to write to the register
  * @param addressType the I2C address type to write to
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. A failed value stays dirty
  */
-void LP50XX::WriteRegister(uint8_t reg, uint8_t value, EAddressType addressType) {
-    i2c_write_byte(getAddress(addressType), reg, value);
+int8_t LP50XX::WriteRegister(uint8_t reg, uint8_t value, EAddressType addressType) {
+    int8_t status = busWriteByte(getAddress(addressType), reg, value);
+    updateShadow(reg, &value, 1, status);
+    return status;
 }
 
 /**
@@ -458,11 +502,248 @@ void LP50XX::WriteRegister(uint8_t reg, uint8_t value, EAddressType addressType)
  * 
  * @param reg The register to read from
  * @param value a reference to a @ref uint8_t value
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error and the value is undefined
+ */
+int8_t LP50XX::ReadRegister(uint8_t reg, uint8_t *value) {
+    return ReadRegisters(reg, value, 1);
+}
+
+/**
+ * @brief Reads consecutive registers. With auto increment enabled in the shadow image they are read in bursts of
+ * up to @ref LP50XX_I2C_MAX_READ registers, otherwise one register per transaction
+ * 
+ * @param reg The first register to read from
+ * @param values The buffer for the values
+ * @param count The number of registers
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error and the values from the failed read on are undefined
+ */
+int8_t LP50XX::ReadRegisters(uint8_t reg, uint8_t *values, uint8_t count) {
+    uint8_t burst = autoIncrement() ? LP50XX_I2C_MAX_READ : 1;
+    while (count > 0) {
+        uint8_t length = count < burst ? count : burst;
+        int8_t status = busRead(_i2c_address, reg, values, length);
+        if (status != 0) {
+            return status;
+        }
+
+        // Seed the shadow image with the device values unless a staged value is still pending
+        for (uint8_t i = 0; i < length; i++) {
+            if (reg + i < LP50XX_REGISTER_COUNT && !(_dirty >> (reg + i) & 1)) {
+                _registers[reg + i] = values[i];
+            }
+        }
+        reg += length;
+        values += length;
+        count -= length;
+    }
+    return 0;
+}
+
+/*----------------------- Snapshot functions --------------------------------*/
+
+/**
+ * @brief Reads the register map of the device into a snapshot with a single burst and seeds the shadow image
+ * with it, see @ref LP50XX_Snapshot.h
+ * 
+ * @param snapshot The snapshot, registers the variant does not have keep their reset value
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error and the snapshot is undefined
  */
-void LP50XX::ReadRegister(uint8_t reg, uint8_t *value) {
-    i2c_read_byte(_i2c_address, reg, value);
+int8_t LP50XX::CaptureSnapshot(LP50XXSnapshot &snapshot) {
+    uint8_t values[LP50XX_REGISTER_COUNT];
+    int8_t status = ReadRegisters(0, values, registerEnd());
+    snapshot.Clear(_variant);
+    uint32_t mask = registerMask();
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        if (mask >> reg & 1) {
+            snapshot._registers[reg] = values[reg];
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Writes a snapshot to the device and the shadow image. The map is written with a single burst when auto
+ * increment is enabled in the device and in the snapshot, otherwise by @ref Flush
+ * 
+ * @param snapshot The snapshot, it may be captured from another device
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. Failed registers stay dirty
+ */
+int8_t LP50XX::RestoreSnapshot(const LP50XXSnapshot &snapshot) {
+    bool burst = autoIncrement() && (snapshot._registers[DEVICE_CONFIG1] & AUTO_INC_ON);
+    uint32_t mask = registerMask();
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        if (mask >> reg & 1) {
+            _registers[reg] = snapshot._registers[reg];
+        }
+    }
+    _dirty = mask;
+    if (!burst) {
+        return Flush();
+    }
+
+    uint8_t count = registerEnd();
+    int8_t status = busWrite(_i2c_address, 0, _registers, count);
+    updateShadow(0, _registers, count, status);
+    return status;
+}
+
+
+/*----------------------- Buffered functions --------------------------------*/
+
+/**
+ * @brief Stages a register value in the shadow image. The register is only marked dirty when the value differs from the shadow image
+ * 
+ * @param reg The register to stage. Registers outside the shadow image or missing on the variant are ignored
+ * @param value The value to write to the register on the next @ref Flush
+ */
+void LP50XX::StageRegister(uint8_t reg, uint8_t value) {
+    if (reg >= LP50XX_REGISTER_COUNT || !(registerMask() >> reg & 1) || _registers[reg] == value) {
+        return;
+    }
+    _registers[reg] = value;
+    _dirty |= 1UL << reg;
 }
 
+/**
+ * @brief Stages the brightness level of a single LED (3 outputs)
+ * 
+ * @param led The led to set. 0..2 on the LP5009, 0..3 on the LP5012
+ * @param brightness The brightness level from 0 to 0xFF
+ */
+void LP50XX::StageLEDBrightness(uint8_t led, uint8_t brightness) {
+    if (led >= GetLEDCount()) {
+        return;
+    }
+    StageRegister(LED0_BRIGHTNESS + led, brightness);
+}
+
+/**
+ * @brief Stages the color level of a single output
+ * 
+ * @param output The output to set. 0..8 on the LP5009, 0..11 on the LP5012
+ * @param value The color value from 0 to 0xFF
+ */
+void LP50XX::StageOutputColor(uint8_t output, uint8_t value) {
+    if (output >= GetOutputCount()) {
+        return;
+    }
+    StageRegister(OUT0_COLOR + output, value);
+}
+
+/**
+ * @brief Stages the LED color according to the set LED configuration @ref SetLEDConfiguration
+ * 
+ * @param led The led to set. 0..2 on the LP5009, 0..3 on the LP5012
+ * @param r The red color value from 0 to 0xFF
+ * @param g The green color value from 0 to 0xFF
+ * @param b The blue color value from 0 to 0xFF
+ */
+void LP50XX::StageLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b) {
+    LP50XX_PROFILE_SCOPE(ProfileStageLEDColor);
+    if (led >= GetLEDCount()) {
+        return;
+    }
+    uint8_t buff[3];
+    orderColor(r, g, b, buff);
+
+    StageRegister(OUT0_COLOR + (led * 3), buff[0]);
+    StageRegister(OUT0_COLOR + (led * 3) + 1, buff[1]);
+    StageRegister(OUT0_COLOR + (led * 3) + 2, buff[2]);
+}
+
+/**
+ * @brief Writes all dirty registers of the shadow image to the device.
+ * Dirty registers are grouped into bursts, small clean gaps are rewritten when that is faster on the wire than
+ * another transaction, see @ref LP50XXBusTiming::GetMergeGap.
+ * After a recovery of the bus the whole shadow image is written, see @ref LP50XX_BusRecovery.h
+ * 
+ * @note Bursts are only used when auto increment is enabled in the shadow image, otherwise every register is written on its own
+ * 
+ * @return int8_t 0 on success, otherwise the status of the last failed transaction. Failed registers stay dirty
+ */
+int8_t LP50XX::Flush() {
+    LP50XX_PROFILE_SCOPE(ProfileFlush);
+    checkRecovery();
+    uint32_t recoveriesSeen = _recoveries_seen;
+    int8_t result = 0;
+    uint8_t reg = 0;
+    // Clean registers that take less time to rewrite than the start, addressing and stop of another burst
+    uint8_t mergeGap = (_transport != NULL ? _transport->GetTiming() : LP50XXBusTiming::Default()).GetMergeGap();
+
+    while (reg < LP50XX_REGISTER_COUNT && (_dirty >> reg)) {
+        if (!(_dirty >> reg & 1)) {
+            reg++;
+            continue;
+        }
+
+        // The configuration registers are written first and on their own, so a changed auto increment setting applies to the bursts after them
+        uint8_t end = reg + 1;
+        bool autoInc = autoIncrement();
+        if (autoInc && reg > DEVICE_CONFIG1) {
+            for (uint8_t next = end; next < LP50XX_REGISTER_COUNT && next - end <= mergeGap; next++) {
+                if (_dirty >> next & 1) {
+                    end = next + 1;
+                }
+            }
+        }
+
+        int8_t status = busWrite(_i2c_address, reg, &_registers[reg], end - reg);
+        if (status == 0) {
+            _dirty &= ~(((1UL << (end - reg)) - 1) << reg);
+        } else if (_recoveries_seen != recoveriesSeen) {
+            // The bus was recovered and the whole image is dirty, the next Flush() writes it in bursts again
+            return status;
+        } else {
+            result = status;
+        }
+        reg = end;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the registers of the shadow image that still have to be written to the device
+ * 
+ * @return uint32_t A bitmask where bit n represents register n
+ */
+uint32_t LP50XX::GetDirtyMask() {
+    return _dirty;
+}
+
+/**
+ * @brief Returns the value of a register as it is known in the shadow image, without any bus access
+ * 
+ * @param reg The register to return
+ * @return uint8_t The shadow value, 0 for registers outside the shadow image
+ */
+uint8_t LP50XX::GetShadowRegister(uint8_t reg) {
+    if (reg >= LP50XX_REGISTER_COUNT) {
+        return 0;
+    }
+    return _registers[reg];
+}
+
+/*----------------------- Telemetry functions -------------------------------*/
+
+#if LP50XX_TELEMETRY
+/**
+ * @brief Copies the counters of the bus accesses of this device, see @ref LP50XX_Telemetry.h
+ * 
+ * @param telemetry The buffer for the counters
+ */
+void LP50XX::GetTelemetry(LP50XXTelemetry *telemetry) {
+    *telemetry = _telemetry;
+}
+
+/**
+ * @brief Resets the counters of the bus accesses of this device
+ */
+void LP50XX::ResetTelemetry() {
+    _telemetry.Reset();
+}
+#endif
+
 /*------------------------- Helper functions --------------------------------*/
 
 /*
@@ -489,3 +770,263 @@ uint8_t LP50XX::getAddress(EAddressType addressType) {
     }
     return i2c_address;
 }
+
+/**
+ * @brief Returns the registers of the shadow image that exist on the variant
+ * 
+ * @return uint32_t A bitmask where bit n represents register n
+ */
+uint32_t LP50XX::registerMask() {
+    if (_variant == VariantLP5009) {
+        return ((1UL << LP5009_REGISTER_COUNT) - 1) & ~(1UL << LED3_BRIGHTNESS);
+    }
+    return (1UL << LP50XX_REGISTER_COUNT) - 1;
+}
+
+/**
+ * @brief Returns the end of the registers of the variant
+ * 
+ * @return uint8_t The last register of the shadow image of the variant plus one
+ */
+uint8_t LP50XX::registerEnd() {
+    return _variant == VariantLP5009 ? LP5009_REGISTER_COUNT : LP50XX_REGISTER_COUNT;
+}
+
+/**
+ * @brief Returns whether the device auto increments, as far as the shadow image knows
+ * 
+ * @return true when auto increment is enabled in the shadow image and not waiting to be written
+ */
+bool LP50XX::autoIncrement() {
+    return (_registers[DEVICE_CONFIG1] & AUTO_INC_ON) && !(_dirty >> DEVICE_CONFIG1 & 1);
+}
+
+/**
+ * @brief Writes consecutive registers through the transport, or the I2C functions of @ref I2C_coms.h without a transport.
+ * Failed writes are repeated as the retry policy allows, see @ref GetRetryPolicy
+ * 
+ * @param address The I2C address to write to
+ * @param reg The first register
+ * @param pdata The register values
+ * @param count The number of registers
+ * @return int8_t 0 on success, otherwise the status of the last attempt
+ */
+int8_t LP50XX::busWrite(uint8_t address, uint8_t reg, uint8_t *pdata, uint8_t count) {
+    LP50XX_PROFILE_SCOPE(ProfileBusWrite);
+    // The clock is only read when a failed attempt may be repeated, the default policy makes a single attempt
+    bool timed = LP50XX_TELEMETRY || GetRetryPolicy().GetMaxAttempts() > 1;
+    int8_t status;
+    uint8_t attempt = 0;
+    unsigned long start = 0;
+    for (;;) {
+        if (timed) {
+            start = micros();
+        }
+        if (_transport != NULL) {
+            status = _transport->Write(address, reg, pdata, count);
+        } else {
+            status = i2c_write_multi(address, reg, pdata, count);
+        }
+        uint32_t elapsedUs = timed ? micros() - start : 0;
+#if LP50XX_TELEMETRY
+        _telemetry.Record(TelemetryWrite, address, count, status, elapsedUs);
+#endif
+        if (status == 0 || !retry(status, ++attempt, elapsedUs)) {
+            break;
+        }
+    }
+    checkRecovery();
+    return status;
+}
+
+/**
+ * @brief Writes a single register, see @ref busWrite
+ * 
+ * @param address The I2C address to write to
+ * @param reg The register
+ * @param value The register value
+ * @return int8_t 0 on success
+ */
+int8_t LP50XX::busWriteByte(uint8_t address, uint8_t reg, uint8_t value) {
+    return busWrite(address, reg, &value, 1);
+}
+
+/**
+ * @brief Reads consecutive registers through the transport, or the I2C functions of @ref I2C_coms.h without a transport.
+ * Failed reads are repeated as the retry policy allows, see @ref GetRetryPolicy
+ * 
+ * @param address The I2C address to read from
+ * @param reg The first register
+ * @param pdata The buffer for the register values
+ * @param count The number of registers
+ * @return int8_t 0 on success, otherwise the status of the last attempt
+ */
+int8_t LP50XX::busRead(uint8_t address, uint8_t reg, uint8_t *pdata, uint8_t count) {
+    LP50XX_PROFILE_SCOPE(ProfileBusRead);
+    // The clock is only read when a failed attempt may be repeated, the default policy makes a single attempt
+    bool timed = LP50XX_TELEMETRY || GetRetryPolicy().GetMaxAttempts() > 1;
+    int8_t status;
+    uint8_t attempt = 0;
+    unsigned long start = 0;
+    for (;;) {
+        if (timed) {
+            start = micros();
+        }
+        if (_transport != NULL) {
+            status = _transport->Read(address, reg, pdata, count);
+        } else {
+            status = i2c_read_multi(address, reg, pdata, count);
+        }
+        uint32_t elapsedUs = timed ? micros() - start : 0;
+#if LP50XX_TELEMETRY
+        _telemetry.Record(TelemetryRead, address, count, status, elapsedUs);
+#endif
+        if (status == 0 || !retry(status, ++attempt, elapsedUs)) {
+            break;
+        }
+    }
+    checkRecovery();
+    return status;
+}
+
+/**
+ * @brief Asks the retry policy whether a failed transaction is repeated, see @ref LP50XXRetryPolicy::Retry
+ * 
+ * @param status The status of the failed attempt
+ * @param attempt The number of the attempt, 1 for the first one
+ * @param elapsedUs The time the attempt took, 0 when the policy makes a single attempt
+ * @return true when the transaction has to be repeated
+ */
+bool LP50XX::retry(int8_t status, uint8_t attempt, uint32_t elapsedUs) {
+    bool again = GetRetryPolicy().Retry(status, attempt, elapsedUs);
+#if LP50XX_TELEMETRY
+    if (again) {
+        _telemetry.retries++;
+    } else {
+        _telemetry.failures++;
+    }
+#endif
+    return again;
+}
+
+/**
+ * @brief Returns the recovery of the bus of the device
+ * 
+ * @return LP50XXBusRecovery* The recovery of the transport, the default recovery without a transport, NULL when the transport has none
+ */
+LP50XXBusRecovery *LP50XX::busRecovery() {
+    return _transport != NULL ? _transport->GetRecovery() : &LP50XXBusRecovery::Default();
+}
+
+/**
+ * @brief Marks the whole shadow image dirty when the bus was recovered since the last check. The device may have
+ * browned out and lost its registers, including the chip enable of DEVICE_CONFIG0
+ */
+void LP50XX::checkRecovery() {
+    LP50XXBusRecovery *recovery = busRecovery();
+    if (recovery == NULL || recovery->GetRecoveries() == _recoveries_seen) {
+        return;
+    }
+    _recoveries_seen = recovery->GetRecoveries();
+    _dirty = registerMask();
+}
+
+/**
+ * @brief Changes bits of DEVICE_CONFIG1 with a read-modify-write of the device register. When the device does not
+ * answer, the bits are changed in the shadow image and left dirty for the next @ref Flush
+ * 
+ * @param mask The bits to change, see @ref LP50XX_Configuration
+ * @param value The new value of the bits
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t LP50XX::updateConfiguration(uint8_t mask, uint8_t value) {
+    uint8_t buff;
+    int8_t status = busRead(_i2c_address, DEVICE_CONFIG1, &buff, 1);
+    if (status != 0) {
+        buff = _registers[DEVICE_CONFIG1];
+    }
+
+    buff = (buff & ~mask) | (value & mask);
+    if (status == 0) {
+        status = busWriteByte(_i2c_address, DEVICE_CONFIG1, buff);
+    }
+    updateShadow(DEVICE_CONFIG1, &buff, 1, status);
+    return status;
+}
+
+/**
+ * @brief Orders the r, g and b values according to the set LED configuration @ref SetLEDConfiguration
+ * 
+ * @param r The red color value from 0 to 0xFF
+ * @param g The green color value from 0 to 0xFF
+ * @param b The blue color value from 0 to 0xFF
+ * @param buff The buffer of 3 bytes to store the ordered values in
+ */
+void LP50XX::orderColor(uint8_t r, uint8_t g, uint8_t b, uint8_t *buff) {
+    switch (_led_configuration)
+    {
+    case RGB:
+    default:
+        buff[0] = r;
+        buff[1] = g;
+        buff[2] = b;
+        break;
+    case GRB:
+        buff[0] = g;
+        buff[1] = r;
+        buff[2] = b;
+        break;
+    case BGR:
+        buff[0] = b;
+        buff[1] = g;
+        buff[2] = r;
+        break;
+    case RBG:
+        buff[0] = r;
+        buff[1] = b;
+        buff[2] = g;
+        break;
+    case GBR:
+        buff[0] = g;
+        buff[1] = b;
+        buff[2] = r;
+        break;
+    case BRG:
+        buff[0] = b;
+        buff[1] = r;
+        buff[2] = g;
+        break;
+    }
+}
+
+/**
+ * @brief Sets the shadow image to the power-on defaults of the device and clears all dirty flags
+ */
+void LP50XX::resetShadow() {
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        _registers[reg] = LP50XXSnapshot::GetResetValue(_variant, reg);
+    }
+    _dirty = 0;
+}
+
+/**
+ * @brief Stores values that were written directly to the device in the shadow image and clears their dirty flags.
+ * Values of a failed write are marked dirty instead, so the next @ref Flush writes them
+ * 
+ * @param reg The first register that was written
+ * @param pdata The written values
+ * @param count The number of written registers
+ * @param status The status of the write, 0 on success
+ */
+void LP50XX::updateShadow(uint8_t reg, uint8_t *pdata, uint8_t count, int8_t status) {
+    uint32_t mask = registerMask();
+    while (count-- && reg < LP50XX_REGISTER_COUNT) {
+        _registers[reg] = *pdata++;
+        if (status == 0) {
+            _dirty &= ~(1UL << reg);
+        } else {
+            _dirty |= (1UL << reg) & mask;
+        }
+        reg++;
+    }
+}
@@ -11,8 +11,11 @@
 #ifndef __LP50XX_H
 #define __LP50XX_H
 
-#include <Arduino.h>
+#include "LP50XX_Platform.h"
+#include "LP50XX_Transport.h"
+#ifdef ARDUINO
 #include <Wire.h>
+#endif
 
 #define DEFAULT_ADDRESS 0x14
 #define BROADCAST_ADDRESS 0x0C
@@ -53,6 +56,12 @@ enum EAddressType {
     Broadcast
 };
 
+enum EVariant {
+    VariantUnknown,     // Present, the variant was not detected. Handled like the LP5012
+    VariantLP5009,
+    VariantLP5012
+};
+
 // Register definitions
 #define DEVICE_CONFIG0 0x00     // Chip_EN
 #define DEVICE_CONFIG1 0x01     // Configurations for Log_scale, Power_save, Auto_inc, PWM_dithering, Max_current_option and LED_Global_off
@@ -111,6 +120,11 @@ enum EAddressType {
 
 #define RESET_REGISTERS 0x17    // Reset all registers to defaults
 
+// Shadow register image
+#define LP50XX_REGISTER_COUNT 0x17  // Registers 0x00..0x16 are mirrored in the shadow image, RESET_REGISTERS is write only
+#define LP5009_REGISTER_COUNT 0x14  // The LP5009 ends after OUT8_COLOR and has no LED3_BRIGHTNESS
+
+class LP50XXSnapshot;
 
 /**
  * @brief Class to communicate with the LP5009 or LP5012
@@ -127,57 +141,120 @@ class LP50XX
          * Initialisation functions
          */
         bool Begin(uint8_t i2c_address = DEFAULT_ADDRESS); // Initialize the driver
-        void Reset();
-        void ResetRegisters(EAddressType addressType = EAddressType::Normal);
+        int8_t Reset();
+        int8_t ResetRegisters(EAddressType addressType = EAddressType::Normal);
 
         /**
          * Configuration functions
          */
-        void Configure(uint8_t configuration, EAddressType addressType = EAddressType::Normal);
-        void SetScaling(uint8_t scaling);
-        void SetPowerSaving(uint8_t powerSave);
-        void SetAutoIncrement(uint8_t autoInc);
-        void SetPWMDithering(uint8_t dithering);
-        void SetMaxCurrentOption(uint8_t option);
-        void SetGlobalLedOff(uint8_t value);
+        int8_t Configure(uint8_t configuration, EAddressType addressType = EAddressType::Normal);
+        int8_t SetScaling(uint8_t scaling);
+        int8_t SetPowerSaving(uint8_t powerSave);
+        int8_t SetAutoIncrement(uint8_t autoInc);
+        int8_t SetPWMDithering(uint8_t dithering);
+        int8_t SetMaxCurrentOption(uint8_t option);
+        int8_t SetGlobalLedOff(uint8_t value);
 
         void SetEnablePin(uint8_t enablePin);
         void SetLEDConfiguration(LED_Configuration ledConfiguration);
         void SetI2CAddress(uint8_t address);
+        uint8_t GetI2CAddress();
+        void SetTransport(LP50XXTransport *transport);
+        LP50XXTransport *GetTransport();
+        LP50XXRetryPolicy &GetRetryPolicy();
+        void SetVariant(EVariant variant);
+        EVariant GetVariant();
+        uint8_t GetLEDCount();
+        uint8_t GetOutputCount();
 
         /**
          * Bank control functions
          */
-        void SetBankControl(uint8_t leds, EAddressType addressType = EAddressType::Normal);
-        void SetBankBrightness(uint8_t brightness, EAddressType addressType = EAddressType::Normal);
-        void SetBankColorA(uint8_t value, EAddressType addressType = EAddressType::Normal);
-        void SetBankColorB(uint8_t value, EAddressType addressType = EAddressType::Normal);
-        void SetBankColorC(uint8_t value, EAddressType addressType = EAddressType::Normal);
-        void SetBankColor(uint8_t r, uint8_t g, uint8_t b, EAddressType addressType = EAddressType::Normal);
+        int8_t SetBankControl(uint8_t leds, EAddressType addressType = EAddressType::Normal);
+        int8_t SetBankBrightness(uint8_t brightness, EAddressType addressType = EAddressType::Normal);
+        int8_t SetBankColorA(uint8_t value, EAddressType addressType = EAddressType::Normal);
+        int8_t SetBankColorB(uint8_t value, EAddressType addressType = EAddressType::Normal);
+        int8_t SetBankColorC(uint8_t value, EAddressType addressType = EAddressType::Normal);
+        int8_t SetBankColor(uint8_t r, uint8_t g, uint8_t b, EAddressType addressType = EAddressType::Normal);
 
         /**
          * Output control functions
          */
-        void SetLEDBrightness(uint8_t led, uint8_t brighness, EAddressType addressType = EAddressType::Normal);
-        void SetOutputColor(uint8_t output, uint8_t value, EAddressType addressType = EAddressType::Normal);
-        void SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b, EAddressType addressType = EAddressType::Normal);
+        int8_t SetLEDBrightness(uint8_t led, uint8_t brighness, EAddressType addressType = EAddressType::Normal);
+        int8_t SetOutputColor(uint8_t output, uint8_t value, EAddressType addressType = EAddressType::Normal);
+        int8_t SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b, EAddressType addressType = EAddressType::Normal);
 
 
         /**
          * Low level functions
          */
-        void WriteRegister(uint8_t reg, uint8_t value, EAddressType addressType = EAddressType::Normal);
-        void ReadRegister(uint8_t reg, uint8_t *value);
+        int8_t WriteRegister(uint8_t reg, uint8_t value, EAddressType addressType = EAddressType::Normal);
+        int8_t ReadRegister(uint8_t reg, uint8_t *value);
+        int8_t ReadRegisters(uint8_t reg, uint8_t *values, uint8_t count);
+
+        /**
+         * Snapshot functions, see LP50XX_Snapshot.h
+         */
+        int8_t CaptureSnapshot(LP50XXSnapshot &snapshot);
+        int8_t RestoreSnapshot(const LP50XXSnapshot &snapshot);
+
+        /**
+         * Buffered functions
+         */
+        void StageRegister(uint8_t reg, uint8_t value);
+        void StageLEDBrightness(uint8_t led, uint8_t brightness);
+        void StageOutputColor(uint8_t output, uint8_t value);
+        void StageLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b);
+        int8_t Flush();
+        uint32_t GetDirtyMask();
+        uint8_t GetShadowRegister(uint8_t reg);
+
+#if LP50XX_TELEMETRY
+        /**
+         * Telemetry functions
+         */
+        void GetTelemetry(LP50XXTelemetry *telemetry);
+        void ResetTelemetry();
+#endif
 
     protected:
 
     private:
+        friend class LP50XXFrameBuffer;
+        friend class LP50XXChain;
+        friend class LP50XXVerifier;
+        friend class LP50XXMultiBusFlush;
+        friend class LP50XXDaemon;
+
         uint8_t     _i2c_address;
         uint8_t     _i2c_address_broadcast = BROADCAST_ADDRESS;
         uint8_t     _enable_pin = 0xFF;
         LED_Configuration     _led_configuration = RGB;
+        LP50XXTransport      *_transport = NULL;
+        EVariant              _variant = VariantUnknown;
+
+        uint8_t     _registers[LP50XX_REGISTER_COUNT];
+        uint32_t    _dirty = 0;
+        uint32_t    _recoveries_seen = 0;   // Recoveries of the bus the shadow image is synchronized with
+
+#if LP50XX_TELEMETRY
+        LP50XXTelemetry _telemetry;
+#endif
 
         uint8_t getAddress(EAddressType addressType);
+        uint32_t registerMask();
+        uint8_t registerEnd();
+        bool autoIncrement();
+        int8_t busWrite(uint8_t address, uint8_t reg, uint8_t *pdata, uint8_t count);
+        int8_t busWriteByte(uint8_t address, uint8_t reg, uint8_t value);
+        int8_t busRead(uint8_t address, uint8_t reg, uint8_t *pdata, uint8_t count);
+        bool retry(int8_t status, uint8_t attempt, uint32_t elapsedUs);
+        LP50XXBusRecovery *busRecovery();
+        void checkRecovery();
+        int8_t updateConfiguration(uint8_t mask, uint8_t value);
+        void orderColor(uint8_t r, uint8_t g, uint8_t b, uint8_t *buff);
+        void resetShadow();
+        void updateShadow(uint8_t reg, uint8_t *pdata, uint8_t count, int8_t status = 0);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ * @file LP50XX_Animation.cpp
+ * @brief Streaming decoder for the compressed animation stream, see @ref LP50XX_Animation.h for the format
+ */
+#include "LP50XX_Animation.h"
+#include "LP50XX.h"
+
+/**
+ * @brief This function instantiates the decoder
+ *
+ * @param devices The devices to decode into. Block n of every frame is staged into devices[n]
+ * @param deviceCount The number of devices
+ */
+LP50XXAnimationDecoder::LP50XXAnimationDecoder(LP50XX **devices, uint8_t deviceCount) {
+    _devices = devices;
+    _device_count = deviceCount;
+
+    Reset();
+}
+
+/**
+ * @brief Resets the decoder to the start of a stream. The next byte fed is the first header byte
+ */
+void LP50XXAnimationDecoder::Reset() {
+    _header_index = 0;
+    _stream_devices = 0;
+    _first_register = 0;
+    _register_count = 0;
+    _frame_count = 0;
+    _frame_index = 0;
+
+    _device = 0;
+    _position = 0;
+    _literal = 0;
+}
+
+/**
+ * @brief Feeds the next byte of the stream. Literal bytes are staged with @ref LP50XX::StageRegister,
+ * so only registers that actually change are marked dirty and written by the next @ref LP50XX::Flush
+ *
+ * @param data The next byte of the stream
+ * @return EAnimationStatus @ref AnimationFrameComplete or @ref AnimationComplete when a frame is staged
+ */
+EAnimationStatus LP50XXAnimationDecoder::Feed(uint8_t data) {
+    if (_header_index < LP50XX_ANIMATION_HEADER_SIZE) {
+        return parseHeader(data);
+    }
+    if (_frame_index >= _frame_count) {
+        return AnimationError;
+    }
+
+    if (_literal) {
+        _devices[_device]->StageRegister(_first_register + _position, data);
+        _literal--;
+        return advance(1);
+    }
+
+    uint8_t count = (data & ~LP50XX_ANIMATION_SKIP) + 1;
+    if (_position + count > _register_count) {
+        _frame_index = _frame_count;
+        return AnimationError;
+    }
+
+    if (data & LP50XX_ANIMATION_SKIP) {
+        return advance(count);
+    }
+    _literal = count;
+    return AnimationBusy;
+}
+
+/**
+ * @brief Returns the number of frames in the stream, 0 until the header is decoded
+ *
+ * @return uint16_t
+ */
+uint16_t LP50XXAnimationDecoder::GetFrameCount() {
+    return _frame_count;
+}
+
+/**
+ * @brief Returns the number of completely decoded frames
+ *
+ * @return uint16_t
+ */
+uint16_t LP50XXAnimationDecoder::GetFrameIndex() {
+    return _frame_index;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Parses a single header byte
+ *
+ * @param data The header byte
+ * @return EAnimationStatus
+ */
+EAnimationStatus LP50XXAnimationDecoder::parseHeader(uint8_t data) {
+    bool valid = true;
+    switch (_header_index)
+    {
+    case 0:
+        valid = data == 'L';
+        break;
+    case 1:
+        valid = data == 'A';
+        break;
+    case 2:
+        valid = data == LP50XX_ANIMATION_VERSION;
+        break;
+    case 3:
+        _stream_devices = data;
+        valid = data > 0 && data <= _device_count;
+        break;
+    case 4:
+        _first_register = data;
+        break;
+    case 5:
+        _register_count = data;
+        valid = data > 0 && _first_register + data <= LP50XX_ANIMATION_MAX_REGISTERS;
+        break;
+    case 6:
+        _frame_count = data;
+        break;
+    case 7:
+        _frame_count |= (uint16_t)data << 8;
+        break;
+    }
+
+    if (!valid) {
+        // Keep rejecting bytes until the decoder is reset
+        _header_index = LP50XX_ANIMATION_HEADER_SIZE;
+        _frame_count = 0;
+        return AnimationError;
+    }
+
+    _header_index++;
+    if (_header_index == LP50XX_ANIMATION_HEADER_SIZE && _frame_count == 0) {
+        return AnimationComplete;
+    }
+    return AnimationBusy;
+}
+
+/**
+ * @brief Advances the register position and moves to the next device or frame at the end of a block
+ *
+ * @param count The number of registers that were covered
+ * @return EAnimationStatus
+ */
+EAnimationStatus LP50XXAnimationDecoder::advance(uint8_t count) {
+    _position += count;
+    if (_position < _register_count) {
+        return AnimationBusy;
+    }
+
+    _position = 0;
+    if (++_device < _stream_devices) {
+        return AnimationBusy;
+    }
+
+    _device = 0;
+    _frame_index++;
+    return _frame_index == _frame_count ? AnimationComplete : AnimationFrameComplete;
+}
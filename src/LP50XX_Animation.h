@@ -0,0 +1,82 @@
+/**
+ * @file LP50XX_Animation.h
+ * @brief Compressed animation stream format for the LP5009 and LP5012
+ *
+ * A stream starts with a header, followed by the frames. Every frame holds one block per device and
+ * every block describes the register window of that device as a delta against the previous frame:
+ *
+ * | Byte      | Meaning                                                              |
+ * |-----------|----------------------------------------------------------------------|
+ * | 0x00-0x7F | Literal run, the next (byte + 1) bytes are written to the registers   |
+ * | 0x80-0xFF | Skip run, the next ((byte & 0x7F) + 1) registers are unchanged        |
+ *
+ * A block ends when the whole register window is covered. The first frame of a stream is always
+ * encoded without a previous frame, so decoding can start at the beginning of any stream.
+ *
+ * Header layout: 'L', 'A', version, device count, first register, register count, frame count (LSB, MSB)
+ */
+#ifndef __LP50XX_ANIMATION_H
+#define __LP50XX_ANIMATION_H
+
+#include <stdint.h>
+
+#define LP50XX_ANIMATION_VERSION 1
+#define LP50XX_ANIMATION_HEADER_SIZE 8
+#define LP50XX_ANIMATION_MAX_REGISTERS 0x17     // Equal to the size of the shadow image @ref LP50XX_REGISTER_COUNT
+#define LP50XX_ANIMATION_SKIP 0x80
+
+class LP50XX;
+
+enum EAnimationStatus {
+    AnimationBusy,          // More bytes are needed to complete the frame
+    AnimationFrameComplete, // A frame is staged in the devices and can be flushed
+    AnimationComplete,      // The last frame of the stream is staged in the devices and can be flushed
+    AnimationError          // The stream is invalid, call @ref LP50XXAnimationDecoder::Reset to start over
+};
+
+/**
+ * @brief Streaming decoder that stages the frames directly in the shadow image of the devices
+ *
+ * @note The decoder does not allocate or buffer, bytes can be fed from flash, a file or a serial port
+ */
+class LP50XXAnimationDecoder
+{
+    public:
+        LP50XXAnimationDecoder(LP50XX **devices, uint8_t deviceCount);
+
+        void Reset();
+        EAnimationStatus Feed(uint8_t data);
+
+        uint16_t GetFrameCount();
+        uint16_t GetFrameIndex();
+
+    private:
+        LP50XX    **_devices;
+        uint8_t     _device_count;
+
+        uint8_t     _header_index;
+        uint8_t     _stream_devices;
+        uint8_t     _first_register;
+        uint8_t     _register_count;
+        uint16_t    _frame_count;
+        uint16_t    _frame_index;
+
+        uint8_t     _device;
+        uint8_t     _position;
+        uint8_t     _literal;
+
+        EAnimationStatus parseHeader(uint8_t data);
+        EAnimationStatus advance(uint8_t count);
+};
+
+/**
+ * @brief Encoder for the compressed animation stream. It has no platform dependencies so it can be used by host tools as well
+ */
+class LP50XXAnimationEncoder
+{
+    public:
+        static uint8_t EncodeHeader(uint8_t deviceCount, uint8_t firstRegister, uint8_t registerCount, uint16_t frameCount, uint8_t *out);
+        static uint8_t EncodeDevice(const uint8_t *previous, const uint8_t *current, uint8_t registerCount, uint8_t *out);
+};
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file LP50XX_AnimationEncoder.cpp
+ * @brief Encoder for the compressed animation stream, see @ref LP50XX_Animation.h for the format
+ *
+ * @note This file has no platform dependencies, it is shared with the host tools in extras/tools
+ */
+#include "LP50XX_Animation.h"
+
+/**
+ * @brief Encodes the stream header
+ *
+ * @param deviceCount The number of device blocks in every frame
+ * @param firstRegister The first register of the register window
+ * @param registerCount The number of registers in the register window
+ * @param frameCount The number of frames in the stream
+ * @param out The buffer to write to, at least @ref LP50XX_ANIMATION_HEADER_SIZE bytes
+ * @return uint8_t The number of bytes written, 0 if the register window does not fit the shadow image
+ */
+uint8_t LP50XXAnimationEncoder::EncodeHeader(uint8_t deviceCount, uint8_t firstRegister, uint8_t registerCount, uint16_t frameCount, uint8_t *out) {
+    if (deviceCount == 0 || registerCount == 0 || firstRegister + registerCount > LP50XX_ANIMATION_MAX_REGISTERS) {
+        return 0;
+    }
+
+    out[0] = 'L';
+    out[1] = 'A';
+    out[2] = LP50XX_ANIMATION_VERSION;
+    out[3] = deviceCount;
+    out[4] = firstRegister;
+    out[5] = registerCount;
+    out[6] = frameCount & 0xFF;
+    out[7] = frameCount >> 8;
+    return LP50XX_ANIMATION_HEADER_SIZE;
+}
+
+/**
+ * @brief Encodes the block of a single device as a delta against the previous frame.
+ * A single unchanged register between changed registers is kept in the literal run, because a skip would cost more bytes than it saves
+ *
+ * @param previous The register window of the previous frame, NULL for the first frame
+ * @param current The register window of the current frame
+ * @param registerCount The number of registers in the register window
+ * @param out The buffer to write to, at least registerCount + 1 bytes
+ * @return uint8_t The number of bytes written
+ */
+uint8_t LP50XXAnimationEncoder::EncodeDevice(const uint8_t *previous, const uint8_t *current, uint8_t registerCount, uint8_t *out) {
+    uint8_t length = 0;
+    uint8_t reg = 0;
+
+    while (reg < registerCount) {
+        uint8_t start = reg;
+        while (previous && reg < registerCount && previous[reg] == current[reg]) {
+            reg++;
+        }
+        if (reg != start) {
+            out[length++] = LP50XX_ANIMATION_SKIP | (reg - start - 1);
+            continue;
+        }
+
+        // Extend the literal run until two unchanged registers follow each other
+        while (reg < registerCount) {
+            if (previous && previous[reg] == current[reg] && (reg + 1 == registerCount || previous[reg + 1] == current[reg + 1])) {
+                break;
+            }
+            reg++;
+        }
+        out[length++] = reg - start - 1;
+        while (start < reg) {
+            out[length++] = current[start++];
+        }
+    }
+
+    return length;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file LP50XX_BusRecovery.cpp
+ * @brief Contains the stuck bus recovery, see @ref LP50XX_BusRecovery.h
+ */
+#include "LP50XX_BusRecovery.h"
+#include "I2C_coms.h"
+
+LP50XXBusRecovery LP50XXBusRecovery::_default;
+
+/**
+ * @brief Instantiates the recovery
+ *
+ * @param sdaPin The pin of SDA, @ref LP50XX_RECOVERY_NO_PIN to disable the recovery
+ * @param sclPin The pin of SCL, @ref LP50XX_RECOVERY_NO_PIN to disable the recovery
+ * @param clockHz The clock set when the controller is started again, 0 for the default of the core
+ */
+LP50XXBusRecovery::LP50XXBusRecovery(uint8_t sdaPin, uint8_t sclPin, uint32_t clockHz) {
+    _sda_pin = sdaPin;
+    _scl_pin = sclPin;
+    _clock_hz = clockHz;
+}
+
+/*----------------------- Configuration functions ---------------------------*/
+
+/**
+ * @brief Sets the pins of the bus, they are only used during a recovery
+ *
+ * @param sdaPin The pin of SDA, @ref LP50XX_RECOVERY_NO_PIN to disable the recovery
+ * @param sclPin The pin of SCL, @ref LP50XX_RECOVERY_NO_PIN to disable the recovery
+ */
+void LP50XXBusRecovery::SetPins(uint8_t sdaPin, uint8_t sclPin) {
+    _sda_pin = sdaPin;
+    _scl_pin = sclPin;
+}
+
+/**
+ * @brief Returns whether the pins are set
+ *
+ * @return true when the bus is checked and recovered
+ */
+bool LP50XXBusRecovery::IsEnabled() {
+    return _sda_pin != LP50XX_RECOVERY_NO_PIN && _scl_pin != LP50XX_RECOVERY_NO_PIN;
+}
+
+/**
+ * @brief Sets the clock of the bus. Starting the controller again resets it to the default of the core
+ *
+ * @param clockHz The clock, 0 for the default of the core
+ */
+void LP50XXBusRecovery::SetClock(uint32_t clockHz) {
+    _clock_hz = clockHz;
+}
+
+/**
+ * @brief Returns the clock set after a recovery
+ *
+ * @return uint32_t The clock in Hz, 0 for the default of the core
+ */
+uint32_t LP50XXBusRecovery::GetClock() {
+    return _clock_hz;
+}
+
+/*----------------------- Recovery functions --------------------------------*/
+
+/**
+ * @brief Checks whether a device holds the bus. Between transactions both lines are high, a line that is still
+ * low after a bit time is stuck
+ *
+ * @return true when the bus is stuck, false when it is free or the recovery is disabled
+ */
+bool LP50XXBusRecovery::IsStuck() {
+    if (!IsEnabled() || (digitalRead(_sda_pin) == HIGH && digitalRead(_scl_pin) == HIGH)) {
+        return false;
+    }
+    delayMicroseconds(2 * LP50XX_RECOVERY_HALF_PERIOD_US);
+    return digitalRead(_sda_pin) == LOW || digitalRead(_scl_pin) == LOW;
+}
+
+/**
+ * @brief Clocks SCL until the device releases SDA and generates a STOP. The controller has to be stopped,
+ * see @ref Recover(TwoWire &)
+ *
+ * @return int8_t 0 when the bus is free, 4 when a line is still low or the recovery is disabled
+ */
+int8_t LP50XXBusRecovery::Recover() {
+    if (!IsEnabled()) {
+        return 4;
+    }
+    unsigned long start = micros();
+    _recoveries++;
+
+    release(_sda_pin);
+    release(_scl_pin);
+    uint8_t pulses = 0;
+    while (pulses < LP50XX_RECOVERY_PULSES && digitalRead(_sda_pin) == LOW) {
+        drive(_scl_pin);
+        delayMicroseconds(LP50XX_RECOVERY_HALF_PERIOD_US);
+        release(_scl_pin);
+        delayMicroseconds(LP50XX_RECOVERY_HALF_PERIOD_US);
+        pulses++;
+    }
+
+    // STOP, SDA rises while SCL is high
+    drive(_scl_pin);
+    delayMicroseconds(LP50XX_RECOVERY_HALF_PERIOD_US);
+    drive(_sda_pin);
+    delayMicroseconds(LP50XX_RECOVERY_HALF_PERIOD_US);
+    release(_scl_pin);
+    delayMicroseconds(LP50XX_RECOVERY_HALF_PERIOD_US);
+    release(_sda_pin);
+    delayMicroseconds(LP50XX_RECOVERY_HALF_PERIOD_US);
+
+    _last_pulses = pulses;
+    _last_duration_us = micros() - start;
+    if (digitalRead(_sda_pin) == LOW || digitalRead(_scl_pin) == LOW) {
+        _failures++;
+        return 4;
+    }
+    return 0;
+}
+
+#ifdef ARDUINO
+/**
+ * @brief Stops the controller, recovers the bus and starts the controller again with the clock and the timeout
+ * of @ref i2c_init
+ *
+ * @param wire The controller of the bus
+ * @return int8_t 0 when the bus is free, see @ref Recover
+ */
+int8_t LP50XXBusRecovery::Recover(TwoWire &wire) {
+    wire.end();
+    int8_t status = Recover();
+    wire.begin();
+    if (_clock_hz != 0) {
+        wire.setClock(_clock_hz);
+    }
+#if defined(WIRE_HAS_TIMEOUT)
+    wire.setWireTimeout(LP50XX_I2C_TIMEOUT_US, true);
+#endif
+    return status;
+}
+#endif
+
+/**
+ * @brief Returns the recoveries since construction. A device on the bus may have been reset by each of them
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXBusRecovery::GetRecoveries() {
+    return _recoveries;
+}
+
+/**
+ * @brief Returns the recoveries that did not free the bus
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXBusRecovery::GetFailures() {
+    return _failures;
+}
+
+/**
+ * @brief Returns the clocks the last recovery needed until SDA was released
+ *
+ * @return uint8_t 0 when only SCL was low or the STOP freed the bus
+ */
+uint8_t LP50XXBusRecovery::GetLastPulses() {
+    return _last_pulses;
+}
+
+/**
+ * @brief Returns the duration of the last recovery, without stopping and starting the controller
+ *
+ * @return uint32_t The duration in us
+ */
+uint32_t LP50XXBusRecovery::GetLastDuration() {
+    return _last_duration_us;
+}
+
+/**
+ * @brief Returns the recovery of the I2C functions of @ref I2C_coms.h
+ *
+ * @return LP50XXBusRecovery& The recovery, disabled until @ref SetPins is called
+ */
+LP50XXBusRecovery &LP50XXBusRecovery::Default() {
+    return _default;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Pulls a line low
+ *
+ * @param pin The pin of the line
+ */
+void LP50XXBusRecovery::drive(uint8_t pin) {
+    digitalWrite(pin, LOW);
+    pinMode(pin, OUTPUT);
+}
+
+/**
+ * @brief Releases a line to its pull-up resistor
+ *
+ * @param pin The pin of the line
+ */
+void LP50XXBusRecovery::release(uint8_t pin) {
+    pinMode(pin, INPUT);
+}
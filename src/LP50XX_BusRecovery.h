@@ -0,0 +1,82 @@
+/**
+ * @file LP50XX_BusRecovery.h
+ * @brief Detection and recovery of a bus that a device holds low
+ *
+ * A device that browns out in the middle of a transaction can hold SDA low until it receives the clocks of the
+ * rest of its byte. The controller then sees a busy bus: the Wire library times out or, without a timeout, blocks
+ * on every further call. With the pins of the bus set, the transports check the lines before every transaction
+ * and after every failed one. A line that stays low for a bit time is a stuck bus: the controller is stopped,
+ * up to @ref LP50XX_RECOVERY_PULSES clocks are sent on SCL until SDA is released, a STOP is generated and the
+ * controller is started again. The recovery takes about 100 us.
+ *
+ * Every recovery increments @ref LP50XXBusRecovery::GetRecoveries. A device on the bus may have lost its
+ * registers, so every @ref LP50XX of the bus marks its whole shadow image dirty and the next @ref LP50XX::Flush
+ * writes it again.
+ *
+ * @code
+ * LP50XXBusRecovery::Default().SetPins(SDA, SCL);     // The I2C functions of I2C_coms.h on Wire
+ *
+ * LP50XXBusRecovery recovery1(SDA1, SCL1, 400000);     // A transport on Wire1, restarted at 400 kHz
+ * transport1.SetRecovery(&recovery1);
+ * @endcode
+ *
+ * The pins are driven like open drain outputs, the bus needs its pull-up resistors. @ref LP50XXLinuxI2C does not
+ * use a recovery, the kernel driver of the controller recovers its bus.
+ */
+#ifndef __LP50XX_BUS_RECOVERY_H
+#define __LP50XX_BUS_RECOVERY_H
+
+#include "LP50XX_Platform.h"
+#ifdef ARDUINO
+#include <Wire.h>
+#endif
+
+#ifndef LP50XX_RECOVERY_PULSES
+#define LP50XX_RECOVERY_PULSES 9            // Clocks for the rest of a byte and its acknowledge
+#endif
+
+#define LP50XX_RECOVERY_HALF_PERIOD_US 5    // Half a clock of the recovery, standard mode
+#define LP50XX_RECOVERY_NO_PIN 0xFF
+
+/**
+ * @brief Stuck bus recovery of one bus
+ */
+class LP50XXBusRecovery
+{
+    public:
+        LP50XXBusRecovery(uint8_t sdaPin = LP50XX_RECOVERY_NO_PIN, uint8_t sclPin = LP50XX_RECOVERY_NO_PIN, uint32_t clockHz = 0);
+
+        void SetPins(uint8_t sdaPin, uint8_t sclPin);
+        bool IsEnabled();
+        void SetClock(uint32_t clockHz);
+        uint32_t GetClock();
+
+        bool IsStuck();
+        int8_t Recover();
+#ifdef ARDUINO
+        int8_t Recover(TwoWire &wire);
+#endif
+
+        uint32_t GetRecoveries();
+        uint32_t GetFailures();
+        uint8_t GetLastPulses();
+        uint32_t GetLastDuration();
+
+        static LP50XXBusRecovery &Default();
+
+    private:
+        uint8_t     _sda_pin;
+        uint8_t     _scl_pin;
+        uint32_t    _clock_hz;          // Clock set after the controller is started again, 0 for the default of the core
+        uint32_t    _recoveries = 0;
+        uint32_t    _failures = 0;
+        uint8_t     _last_pulses = 0;
+        uint32_t    _last_duration_us = 0;
+
+        static LP50XXBusRecovery _default;
+
+        void drive(uint8_t pin);
+        void release(uint8_t pin);
+};
+
+#endif
@@ -0,0 +1,220 @@
+/**
+ * @file LP50XX_BusTiming.cpp
+ * @brief Contains the wire time model, see @ref LP50XX_BusTiming.h
+ */
+#include "LP50XX_BusTiming.h"
+
+LP50XXBusTiming LP50XXBusTiming::_default;
+
+/**
+ * @brief Instantiates the model
+ *
+ * @param clockHz The SCL clock, e.g. @ref LP50XX_I2C_FAST
+ * @param stretchPercent The margin added to the byte time for clock stretching
+ */
+LP50XXBusTiming::LP50XXBusTiming(uint32_t clockHz, uint8_t stretchPercent) {
+    _clock_hz = clockHz;
+    _stretch_percent = stretchPercent;
+    update();
+}
+
+/*----------------------- Configuration functions ---------------------------*/
+
+/**
+ * @brief Sets the SCL clock, it should match the clock of the bus, e.g. Wire.setClock()
+ *
+ * @param clockHz The clock in Hz, 0 is ignored
+ */
+void LP50XXBusTiming::SetClock(uint32_t clockHz) {
+    if (clockHz == 0) {
+        return;
+    }
+    _clock_hz = clockHz;
+    update();
+}
+
+/**
+ * @brief Returns the SCL clock
+ *
+ * @return uint32_t The clock in Hz
+ */
+uint32_t LP50XXBusTiming::GetClock() {
+    return _clock_hz;
+}
+
+/**
+ * @brief Sets the margin for clock stretching
+ *
+ * @param percent The margin added to the byte time
+ */
+void LP50XXBusTiming::SetStretchMargin(uint8_t percent) {
+    _stretch_percent = percent;
+    update();
+}
+
+/**
+ * @brief Returns the margin for clock stretching
+ *
+ * @return uint8_t The margin in percent of the byte time
+ */
+uint8_t LP50XXBusTiming::GetStretchMargin() {
+    return _stretch_percent;
+}
+
+/*----------------------- Estimation functions ------------------------------*/
+
+/**
+ * @brief Returns the time of a register write: START, address, register, the values and STOP
+ *
+ * @param count The number of register values
+ * @return uint32_t The time in ns, including the bus free time after the STOP
+ */
+uint32_t LP50XXBusTiming::GetWriteTime(uint32_t count) {
+    return _hold_ns + (2 + count) * 9 * _bit_ns + _stop_ns;
+}
+
+/**
+ * @brief Returns the time of a register read: START, address, register, repeated START, address, the values and STOP
+ *
+ * @param count The number of register values
+ * @return uint32_t The time in ns, including the bus free time after the STOP
+ */
+uint32_t LP50XXBusTiming::GetReadTime(uint32_t count) {
+    return _hold_ns + 2 * 9 * _bit_ns + _restart_ns + (1 + count) * 9 * _bit_ns + _stop_ns;
+}
+
+/**
+ * @brief Returns the time of an address only write
+ *
+ * @return uint32_t The time in ns, including the bus free time after the STOP
+ */
+uint32_t LP50XXBusTiming::GetProbeTime() {
+    return _hold_ns + 9 * _bit_ns + _stop_ns;
+}
+
+/**
+ * @brief Returns the time of a transaction
+ *
+ * @param operation The operation, see @ref ETelemetryOperation or @ref ETraceOperation
+ * @param count The number of register values
+ * @return uint32_t The time in ns
+ */
+uint32_t LP50XXBusTiming::GetTime(uint8_t operation, uint32_t count) {
+    switch (operation)
+    {
+    case 1:
+        return GetReadTime(count);
+    case 2:
+        return GetProbeTime();
+    default:
+        return GetWriteTime(count);
+    }
+}
+
+/**
+ * @brief Returns the period of one clock including the stretch margin
+ *
+ * @return uint32_t The time in ns
+ */
+uint32_t LP50XXBusTiming::GetBitTime() {
+    return _bit_ns;
+}
+
+/**
+ * @brief Returns the time of a single byte including the acknowledge
+ *
+ * @return uint32_t The time in ns
+ */
+uint32_t LP50XXBusTiming::GetByteTime() {
+    return 9 * _bit_ns;
+}
+
+/**
+ * @brief Returns the hold time of a START, from SDA low to SCL low (tHD;STA)
+ *
+ * @return uint16_t The time in ns
+ */
+uint16_t LP50XXBusTiming::GetStartHoldTime() {
+    return _hold_ns;
+}
+
+/**
+ * @brief Returns the setup time of a repeated START, from SCL high to SDA low (tSU;STA)
+ *
+ * @return uint16_t The time in ns
+ */
+uint16_t LP50XXBusTiming::GetStartSetupTime() {
+    return _setup_ns;
+}
+
+/**
+ * @brief Returns the setup time of a STOP, from SCL high to SDA high (tSU;STO)
+ *
+ * @return uint16_t The time in ns
+ */
+uint16_t LP50XXBusTiming::GetStopSetupTime() {
+    return _stop_setup_ns;
+}
+
+/**
+ * @brief Returns the bus free time between a STOP and the next START (tBUF)
+ *
+ * @return uint16_t The time in ns
+ */
+uint16_t LP50XXBusTiming::GetBusFreeTime() {
+    return _bus_free_ns;
+}
+
+/**
+ * @brief Returns the number of clean registers between two dirty runs that take less time to rewrite than
+ * the START, address, register and STOP of a separate write
+ *
+ * @return uint8_t The number of registers
+ */
+uint8_t LP50XXBusTiming::GetMergeGap() {
+    return _merge_gap;
+}
+
+/**
+ * @brief Returns the model used for the I2C functions of @ref I2C_coms.h, fast mode unless changed
+ *
+ * @return LP50XXBusTiming&
+ */
+LP50XXBusTiming &LP50XXBusTiming::Default() {
+    return _default;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Derives the byte and condition times from the clock and the margin
+ */
+void LP50XXBusTiming::update() {
+    // I2C specification minimum tHD;STA, tSU;STA, tSU;STO and tBUF of the mode
+    if (_clock_hz <= LP50XX_I2C_STANDARD) {
+        _hold_ns = 4000;
+        _setup_ns = 4700;
+        _stop_setup_ns = 4000;
+        _bus_free_ns = 4700;
+    } else if (_clock_hz <= LP50XX_I2C_FAST) {
+        _hold_ns = 600;
+        _setup_ns = 600;
+        _stop_setup_ns = 600;
+        _bus_free_ns = 1300;
+    } else {
+        _hold_ns = 260;
+        _setup_ns = 260;
+        _stop_setup_ns = 260;
+        _bus_free_ns = 500;
+    }
+
+    _bit_ns = (uint32_t)(1000000000UL / _clock_hz) * (100 + _stretch_percent) / 100;
+    _restart_ns = _bit_ns / 2 + _setup_ns + _hold_ns;
+    _stop_ns = _bit_ns / 2 + _stop_setup_ns + _bus_free_ns;
+
+    uint32_t byteNs = 9 * _bit_ns;
+    uint32_t gap = (2 * byteNs + _hold_ns + _stop_ns) / byteNs;
+    _merge_gap = gap > 0xFF ? 0xFF : gap;
+}
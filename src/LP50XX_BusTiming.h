@@ -0,0 +1,72 @@
+/**
+ * @file LP50XX_BusTiming.h
+ * @brief Model of the time an I2C transaction takes on the wire
+ *
+ * Every byte takes 9 clocks (8 bits and the acknowledge), each clock low for the first and high for the second
+ * half. On top come the START, the repeated START of a read and the STOP followed by the bus free time, with the
+ * minimum timings of the I2C specification for the mode of the clock (standard mode up to 100 kHz, fast mode up to
+ * 400 kHz, fast mode plus above). A repeated START and a STOP first need half a clock low to change SDA. An optional
+ * margin is added to the clock period for clock stretching and slow masters.
+ *
+ * @code
+ * LP50XXBusTiming timing(LP50XX_I2C_FAST);
+ * uint32_t frameNs = 4 * timing.GetWriteTime(12); // Four devices with 12 outputs each
+ * @endcode
+ *
+ * Every transport has a model, see @ref LP50XXTransport::SetTiming. @ref LP50XX::Flush uses it to decide whether
+ * rewriting clean registers is cheaper than starting another transaction.
+ */
+#ifndef __LP50XX_BUS_TIMING_H
+#define __LP50XX_BUS_TIMING_H
+
+#include <stdint.h>
+
+#define LP50XX_I2C_STANDARD 100000UL    // Standard mode
+#define LP50XX_I2C_FAST 400000UL        // Fast mode
+#define LP50XX_I2C_FAST_PLUS 1000000UL  // Fast mode plus, the maximum of the LP5009 and LP5012
+
+/**
+ * @brief Timing model of one bus
+ */
+class LP50XXBusTiming
+{
+    public:
+        LP50XXBusTiming(uint32_t clockHz = LP50XX_I2C_FAST, uint8_t stretchPercent = 0);
+
+        void SetClock(uint32_t clockHz);
+        uint32_t GetClock();
+        void SetStretchMargin(uint8_t percent);
+        uint8_t GetStretchMargin();
+
+        uint32_t GetWriteTime(uint32_t count);
+        uint32_t GetReadTime(uint32_t count);
+        uint32_t GetProbeTime();
+        uint32_t GetTime(uint8_t operation, uint32_t count);
+        uint32_t GetBitTime();
+        uint32_t GetByteTime();
+        uint16_t GetStartHoldTime();
+        uint16_t GetStartSetupTime();
+        uint16_t GetStopSetupTime();
+        uint16_t GetBusFreeTime();
+        uint8_t GetMergeGap();
+
+        static LP50XXBusTiming &Default();
+
+    private:
+        uint32_t    _clock_hz;
+        uint8_t     _stretch_percent;
+        uint32_t    _bit_ns;            // One clock including the stretch margin
+        uint16_t    _hold_ns;           // tHD;STA, SDA low to SCL low of a START
+        uint16_t    _setup_ns;          // tSU;STA, SCL high to SDA low of a repeated START
+        uint16_t    _stop_setup_ns;     // tSU;STO, SCL high to SDA high of a STOP
+        uint16_t    _bus_free_ns;       // tBUF, STOP to the next START
+        uint32_t    _restart_ns;        // Half a clock low, setup and hold time of a repeated START
+        uint32_t    _stop_ns;           // Half a clock low, setup time of a STOP and the bus free time
+        uint8_t     _merge_gap;
+
+        static LP50XXBusTiming _default;
+
+        void update();
+};
+
+#endif
@@ -0,0 +1,307 @@
+/**
+ * @file LP50XX_C.cpp
+ * @brief C interface for foreign function callers, see @ref LP50XX_C.h
+ */
+#include "LP50XX_C.h"
+#include "LP50XX.h"
+#include "LP50XX_Snapshot.h"
+#if !defined(ARDUINO) && defined(__linux__)
+#include "LP50XX_LinuxI2C.h"
+#endif
+
+struct lp50xx_device {
+    LP50XX driver;
+
+    lp50xx_device(uint8_t enablePin) : driver(enablePin) {}
+    lp50xx_device() {}
+};
+
+/*----------------------- Handle functions ----------------------------------*/
+
+/**
+ * @brief Creates a device handle
+ *
+ * @param enable_pin The pin that is connected to the EN pin, @ref LP50XX_C_NO_PIN without one
+ * @return lp50xx_device* The handle, NULL when out of memory
+ */
+lp50xx_device *lp50xx_create(uint8_t enable_pin) {
+    if (enable_pin == LP50XX_C_NO_PIN) {
+        return new lp50xx_device();
+    }
+    return new lp50xx_device(enable_pin);
+}
+
+/**
+ * @brief Destroys a device handle
+ *
+ * @param device The handle, may be NULL
+ */
+void lp50xx_destroy(lp50xx_device *device) {
+    delete device;
+}
+
+/**
+ * @brief Initializes the bus and the device, see @ref LP50XX::Begin
+ *
+ * @param device The handle
+ * @param i2c_address The I2C address of the device
+ * @return int8_t 0 on success
+ */
+int8_t lp50xx_begin(lp50xx_device *device, uint8_t i2c_address) {
+    return device->driver.Begin(i2c_address) ? 0 : 4;
+}
+
+/**
+ * @brief Sets the order of the colors of the LEDs
+ *
+ * @param device The handle
+ * @param led_configuration The @ref LED_Configuration, 0 for RGB
+ */
+void lp50xx_set_led_configuration(lp50xx_device *device, uint8_t led_configuration) {
+    device->driver.SetLEDConfiguration((LED_Configuration)led_configuration);
+}
+
+/**
+ * @brief Sets the retry policy of failed transactions of all handles, see @ref LP50XX_Retry.h
+ *
+ * @param max_attempts The attempts per transaction including the first one
+ * @param backoff_us The wait before the second attempt, doubled for every further attempt
+ * @param frame_budget_us The time the repeats of a @ref lp50xx_flush_all may take, 0 for no limit
+ */
+void lp50xx_set_retry_policy(uint8_t max_attempts, uint16_t backoff_us, uint32_t frame_budget_us) {
+    LP50XXRetryPolicy &retry = LP50XXRetryPolicy::Default();
+    retry.SetMaxAttempts(max_attempts);
+    retry.SetBackoff(backoff_us);
+    retry.SetFrameBudget(frame_budget_us);
+}
+
+#if !defined(ARDUINO) && defined(__linux__)
+/**
+ * @brief Opens the i2c-dev bus used by all handles, call before @ref lp50xx_begin
+ *
+ * @param path The bus device, e.g. "/dev/i2c-1"
+ * @return int8_t 0 on success
+ */
+int8_t lp50xx_open_bus(const char *path) {
+    return LP50XXLinuxI2C::Default().Open(path) ? 0 : 4;
+}
+#endif
+
+/*----------------------- Staging functions ---------------------------------*/
+
+/**
+ * @brief Stages consecutive registers
+ *
+ * @param device The handle
+ * @param first_register The first register
+ * @param values The register values
+ * @param count The number of registers, registers beyond the register map are ignored
+ */
+void lp50xx_stage_registers(lp50xx_device *device, uint8_t first_register, const uint8_t *values, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        device->driver.StageRegister(first_register + i, values[i]);
+    }
+}
+
+/**
+ * @brief Stages consecutive outputs
+ *
+ * @param device The handle
+ * @param first_output The first output, 0..11
+ * @param values The color values
+ * @param count The number of outputs
+ */
+void lp50xx_stage_outputs(lp50xx_device *device, uint8_t first_output, const uint8_t *values, uint8_t count) {
+    if (first_output >= LP50XX_C_OUTPUTS) {
+        return;
+    }
+    if (count > LP50XX_C_OUTPUTS - first_output) {
+        count = LP50XX_C_OUTPUTS - first_output;
+    }
+    lp50xx_stage_registers(device, OUT0_COLOR + first_output, values, count);
+}
+
+/**
+ * @brief Stages consecutive LED colors in the LED configuration of the device
+ *
+ * @param device The handle
+ * @param first_led The first LED, 0..3
+ * @param rgb The colors, 3 bytes per LED in the order red, green, blue
+ * @param count The number of LEDs
+ */
+void lp50xx_stage_led_colors(lp50xx_device *device, uint8_t first_led, const uint8_t *rgb, uint8_t count) {
+    for (uint8_t led = first_led; led < LP50XX_C_LEDS && led < first_led + count; led++) {
+        device->driver.StageLEDColor(led, rgb[0], rgb[1], rgb[2]);
+        rgb += 3;
+    }
+}
+
+/**
+ * @brief Stages consecutive LED brightness levels
+ *
+ * @param device The handle
+ * @param first_led The first LED, 0..3
+ * @param values The brightness levels
+ * @param count The number of LEDs
+ */
+void lp50xx_stage_led_brightness(lp50xx_device *device, uint8_t first_led, const uint8_t *values, uint8_t count) {
+    for (uint8_t led = first_led; led < LP50XX_C_LEDS && led < first_led + count; led++) {
+        device->driver.StageLEDBrightness(led, values[led - first_led]);
+    }
+}
+
+/*----------------------- Flush functions -----------------------------------*/
+
+/**
+ * @brief Writes the dirty registers of a device, see @ref LP50XX::Flush
+ *
+ * @param device The handle
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t lp50xx_flush(lp50xx_device *device) {
+    return device->driver.Flush();
+}
+
+/**
+ * @brief Writes the dirty registers of several devices as one frame of their retry policies, see @ref LP50XX_Retry.h
+ *
+ * @param devices The handles
+ * @param device_count The number of handles
+ * @return int8_t 0 on success, otherwise the status of the last failed flush
+ */
+int8_t lp50xx_flush_all(lp50xx_device *const *devices, uint8_t device_count) {
+    int8_t result = 0;
+    for (uint8_t i = 0; i < device_count; i++) {
+        devices[i]->driver.GetRetryPolicy().BeginFrame();
+    }
+    for (uint8_t i = 0; i < device_count; i++) {
+        int8_t status = devices[i]->driver.Flush();
+        if (status != 0) {
+            result = status;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Stages all outputs of several devices and flushes them
+ *
+ * @param devices The handles
+ * @param device_count The number of handles
+ * @param values @ref LP50XX_C_OUTPUTS color values per device, device after device
+ * @return int8_t 0 on success, otherwise the status of the last failed flush
+ */
+int8_t lp50xx_write_outputs(lp50xx_device *const *devices, uint8_t device_count, const uint8_t *values) {
+    for (uint8_t i = 0; i < device_count; i++) {
+        lp50xx_stage_registers(devices[i], OUT0_COLOR, &values[i * LP50XX_C_OUTPUTS], LP50XX_C_OUTPUTS);
+    }
+    return lp50xx_flush_all(devices, device_count);
+}
+
+/**
+ * @brief Stages all LED colors of several devices and flushes them
+ *
+ * @param devices The handles
+ * @param device_count The number of handles
+ * @param rgb @ref LP50XX_C_LEDS colors of 3 bytes per device, device after device
+ * @return int8_t 0 on success, otherwise the status of the last failed flush
+ */
+int8_t lp50xx_write_led_colors(lp50xx_device *const *devices, uint8_t device_count, const uint8_t *rgb) {
+    for (uint8_t i = 0; i < device_count; i++) {
+        lp50xx_stage_led_colors(devices[i], 0, &rgb[i * LP50XX_C_LEDS * 3], LP50XX_C_LEDS);
+    }
+    return lp50xx_flush_all(devices, device_count);
+}
+
+/*----------------------- Direct functions ----------------------------------*/
+
+/**
+ * @brief Writes a single output immediately, see @ref LP50XX::SetOutputColor
+ *
+ * @param device The handle
+ * @param output The output, 0..11
+ * @param value The color value
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error. A failed value stays dirty
+ */
+int8_t lp50xx_set_output_color(lp50xx_device *device, uint8_t output, uint8_t value) {
+    return device->driver.SetOutputColor(output, value);
+}
+
+/**
+ * @brief Reads a register from the device
+ *
+ * @param device The handle
+ * @param reg The register
+ * @param value The read value
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t lp50xx_read_register(lp50xx_device *device, uint8_t reg, uint8_t *value) {
+    return device->driver.ReadRegister(reg, value);
+}
+
+/**
+ * @brief Reads consecutive registers from the device in bursts, see @ref LP50XX::ReadRegisters
+ *
+ * @param device The handle
+ * @param reg The first register
+ * @param values The buffer for the values
+ * @param count The number of registers
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t lp50xx_read_registers(lp50xx_device *device, uint8_t reg, uint8_t *values, uint8_t count) {
+    return device->driver.ReadRegisters(reg, values, count);
+}
+
+/**
+ * @brief Captures the register map of the device and stores it, see @ref LP50XX_Snapshot.h
+ *
+ * @param device The handle
+ * @param buffer The buffer, at least @ref LP50XX_C_SNAPSHOT_SIZE bytes
+ * @param length The length of the stored snapshot, 0 when the capture failed
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t lp50xx_save_snapshot(lp50xx_device *device, uint8_t *buffer, uint8_t *length) {
+    LP50XXSnapshot snapshot;
+    int8_t status = device->driver.CaptureSnapshot(snapshot);
+    *length = status == 0 ? snapshot.Serialize(buffer) : 0;
+    return status;
+}
+
+/**
+ * @brief Writes a stored snapshot to the device, it may be saved from another device
+ *
+ * @param device The handle
+ * @param buffer The stored snapshot
+ * @param length The length of the stored snapshot
+ * @return int8_t 0 on success, -1 for an invalid snapshot, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t lp50xx_restore_snapshot(lp50xx_device *device, const uint8_t *buffer, uint8_t length) {
+    LP50XXSnapshot snapshot;
+    if (!snapshot.Deserialize(buffer, length)) {
+        return -1;
+    }
+    return device->driver.RestoreSnapshot(snapshot);
+}
+
+/**
+ * @brief Returns the registers that still have to be written, see @ref LP50XX::GetDirtyMask
+ *
+ * @param device The handle
+ * @return uint32_t A bitmask where bit n represents register n
+ */
+uint32_t lp50xx_get_dirty_mask(lp50xx_device *device) {
+    return device->driver.GetDirtyMask();
+}
+
+/**
+ * @brief Copies the shadow image, starting at register 0
+ *
+ * @param device The handle
+ * @param registers The buffer
+ * @param count The number of registers to copy
+ */
+void lp50xx_get_shadow(lp50xx_device *device, uint8_t *registers, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        registers[i] = device->driver.GetShadowRegister(i);
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file LP50XX_C.h
+ * @brief C interface for foreign function callers, e.g. Python ctypes or cffi
+ *
+ * Devices are opaque handles. The functions take whole arrays, so one call stages a complete frame of a device
+ * or of several devices. Staging and flushing follow the buffered functions of the C++ API: only registers that
+ * differ from the shadow image become dirty and a flush writes them in as few bursts as possible.
+ *
+ * @code
+ * lp50xx_device *devices[2] = { lp50xx_create(LP50XX_C_NO_PIN), lp50xx_create(LP50XX_C_NO_PIN) };
+ * lp50xx_begin(devices[0], 0x14);
+ * lp50xx_begin(devices[1], 0x15);
+ *
+ * uint8_t frame[2 * LP50XX_C_OUTPUTS];
+ * lp50xx_write_outputs(devices, 2, frame); // One call per frame for both devices
+ * @endcode
+ */
+#ifndef __LP50XX_C_H
+#define __LP50XX_C_H
+
+#include <stdint.h>
+
+#define LP50XX_C_OUTPUTS 12     // Outputs per device
+#define LP50XX_C_LEDS 4         // RGB LEDs per device
+#define LP50XX_C_NO_PIN 0xFF    // No enable pin
+#define LP50XX_C_SNAPSHOT_SIZE 29   // Largest stored snapshot, equal to LP50XX_SNAPSHOT_MAX_SIZE
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Opaque device handle */
+typedef struct lp50xx_device lp50xx_device;
+
+/**
+ * Handle functions
+ */
+lp50xx_device *lp50xx_create(uint8_t enable_pin);
+void lp50xx_destroy(lp50xx_device *device);
+int8_t lp50xx_begin(lp50xx_device *device, uint8_t i2c_address);
+void lp50xx_set_led_configuration(lp50xx_device *device, uint8_t led_configuration);
+void lp50xx_set_retry_policy(uint8_t max_attempts, uint16_t backoff_us, uint32_t frame_budget_us);
+#if !defined(ARDUINO) && defined(__linux__)
+int8_t lp50xx_open_bus(const char *path);
+#endif
+
+/**
+ * Staging functions, no bus access
+ */
+void lp50xx_stage_registers(lp50xx_device *device, uint8_t first_register, const uint8_t *values, uint8_t count);
+void lp50xx_stage_outputs(lp50xx_device *device, uint8_t first_output, const uint8_t *values, uint8_t count);
+void lp50xx_stage_led_colors(lp50xx_device *device, uint8_t first_led, const uint8_t *rgb, uint8_t count);
+void lp50xx_stage_led_brightness(lp50xx_device *device, uint8_t first_led, const uint8_t *values, uint8_t count);
+
+/**
+ * Flush functions
+ */
+int8_t lp50xx_flush(lp50xx_device *device);
+int8_t lp50xx_flush_all(lp50xx_device *const *devices, uint8_t device_count);
+int8_t lp50xx_write_outputs(lp50xx_device *const *devices, uint8_t device_count, const uint8_t *values);
+int8_t lp50xx_write_led_colors(lp50xx_device *const *devices, uint8_t device_count, const uint8_t *rgb);
+
+/**
+ * Direct functions
+ */
+int8_t lp50xx_set_output_color(lp50xx_device *device, uint8_t output, uint8_t value);
+int8_t lp50xx_read_register(lp50xx_device *device, uint8_t reg, uint8_t *value);
+int8_t lp50xx_read_registers(lp50xx_device *device, uint8_t reg, uint8_t *values, uint8_t count);
+int8_t lp50xx_save_snapshot(lp50xx_device *device, uint8_t *buffer, uint8_t *length);
+int8_t lp50xx_restore_snapshot(lp50xx_device *device, const uint8_t *buffer, uint8_t length);
+uint32_t lp50xx_get_dirty_mask(lp50xx_device *device);
+void lp50xx_get_shadow(lp50xx_device *device, uint8_t *registers, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,288 @@
+/**
+ * @file LP50XX_Chain.cpp
+ * @brief Presents several LP5009/LP5012 as one strip of RGB pixels and raw outputs, see @ref LP50XX_Chain.h
+ */
+#include "LP50XX_Chain.h"
+#include "LP50XX_Profile.h"
+#if !defined(ARDUINO) && defined(__linux__)
+#include "LP50XX_LinuxI2C.h"
+#endif
+
+/**
+ * @brief This function instantiates an empty chain
+ */
+LP50XXChain::LP50XXChain() {
+
+}
+
+/**
+ * @brief Appends a device to the chain, devices have to be added before @ref Begin
+ *
+ * @param device The device, its enable pin, LED configuration and transport have to be set already
+ * @param i2cAddress The I2C address of the device, 0x14..0x17
+ * @param ledCount The number of RGB LEDs, 3 for the LP5009 and 4 for the LP5012. 0 takes the count of the variant of the device
+ * @return true when the device was added, false when the chain is full
+ */
+bool LP50XXChain::Add(LP50XX &device, uint8_t i2cAddress, uint8_t ledCount) {
+    if (ledCount == 0) {
+        ledCount = device.GetLEDCount();
+    }
+    if (_device_count == LP50XX_CHAIN_MAX_DEVICES || ledCount > 4) {
+        return false;
+    }
+    _devices[_device_count] = &device;
+    _addresses[_device_count] = i2cAddress;
+    _led_counts[_device_count] = ledCount;
+    _device_count++;
+    return true;
+}
+
+/**
+ * @brief Initializes all devices and builds the pixel table
+ *
+ * @return true when all devices were initialized
+ */
+bool LP50XXChain::Begin() {
+    bool result = true;
+    for (uint8_t i = 0; i < _device_count; i++) {
+        result &= _devices[i]->Begin(_addresses[i]);
+    }
+    buildTables();
+    return result;
+}
+
+/**
+ * @brief Stages the color of a pixel according to the LED configuration of its device
+ *
+ * @param pixel The pixel, 0..@ref GetPixelCount - 1
+ * @param r The red color value from 0 to 0xFF
+ * @param g The green color value from 0 to 0xFF
+ * @param b The blue color value from 0 to 0xFF
+ */
+void LP50XXChain::SetPixel(uint16_t pixel, uint8_t r, uint8_t g, uint8_t b) {
+    if (pixel >= _pixel_count) {
+        return;
+    }
+    const LP50XXPixelMap &map = _pixels[pixel];
+    LP50XX *device = _devices[map.device];
+    device->StageRegister(map.reg + (map.offsets & 0x03), r);
+    device->StageRegister(map.reg + (map.offsets >> 2 & 0x03), g);
+    device->StageRegister(map.reg + (map.offsets >> 4 & 0x03), b);
+}
+
+/**
+ * @brief Stages the brightness level of a pixel
+ *
+ * @param pixel The pixel, 0..@ref GetPixelCount - 1
+ * @param brightness The brightness level from 0 to 0xFF
+ */
+void LP50XXChain::SetPixelBrightness(uint16_t pixel, uint8_t brightness) {
+    if (pixel >= _pixel_count) {
+        return;
+    }
+    const LP50XXPixelMap &map = _pixels[pixel];
+    _devices[map.device]->StageRegister(LED0_BRIGHTNESS + (map.reg - OUT0_COLOR) / 3, brightness);
+}
+
+/**
+ * @brief Stages a single output
+ *
+ * @param output The output, 0..@ref GetOutputCount - 1
+ * @param value The color value from 0 to 0xFF
+ */
+void LP50XXChain::SetOutput(uint16_t output, uint8_t value) {
+    if (output >= _pixel_count * 3) {
+        return;
+    }
+    const LP50XXPixelMap &map = _pixels[output / 3];
+    _devices[map.device]->StageRegister(map.reg + output % 3, value);
+}
+
+/**
+ * @brief Stages the same color for all pixels
+ *
+ * @param r The red color value from 0 to 0xFF
+ * @param g The green color value from 0 to 0xFF
+ * @param b The blue color value from 0 to 0xFF
+ */
+void LP50XXChain::Fill(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint16_t pixel = 0; pixel < _pixel_count; pixel++) {
+        SetPixel(pixel, r, g, b);
+    }
+}
+
+/**
+ * @brief Writes the dirty registers of all devices, one batch per transport. Starts a frame of the retry policies
+ * of the devices, see @ref LP50XX_Retry.h. When a batch fails, the registers its devices wrote become dirty again
+ *
+ * @return int8_t 0 on success, otherwise the status of the last failed flush
+ */
+int8_t LP50XXChain::Flush() {
+    LP50XX_PROFILE_SCOPE(ProfileChainFlush);
+    int8_t result = 0;
+    LP50XXTransport *batch = NULL;
+    uint8_t batchStart = 0;
+    uint32_t written[LP50XX_CHAIN_MAX_DEVICES];
+
+    for (uint8_t i = 0; i < _device_count; i++) {
+        _devices[i]->GetRetryPolicy().BeginFrame();
+    }
+
+    for (uint8_t i = 0; i < _device_count; i++) {
+        LP50XX *device = _devices[_flush_order[i]];
+        if (transportOf(device) != batch) {
+            if (batch != NULL) {
+                int8_t status = endBatch(batch, batchStart, i, written);
+                if (status != 0) {
+                    result = status;
+                }
+            }
+            batch = transportOf(device);
+            batchStart = i;
+            if (batch != NULL) {
+                batch->BeginBatch();
+            }
+        }
+
+        device->checkRecovery();
+        uint32_t dirty = device->_dirty;
+        int8_t status = device->Flush();
+        written[i] = dirty & ~device->_dirty;
+        if (status != 0) {
+            result = status;
+        }
+    }
+
+    if (batch != NULL) {
+        int8_t status = endBatch(batch, batchStart, _device_count, written);
+        if (status != 0) {
+            result = status;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the number of RGB pixels of all devices
+ *
+ * @return uint16_t
+ */
+uint16_t LP50XXChain::GetPixelCount() {
+    return _pixel_count;
+}
+
+/**
+ * @brief Returns the number of outputs of all devices
+ *
+ * @return uint16_t
+ */
+uint16_t LP50XXChain::GetOutputCount() {
+    return _pixel_count * 3;
+}
+
+/**
+ * @brief Returns a device of the chain, e.g. to configure it
+ *
+ * @param index The index in the order the devices were added
+ * @return LP50XX* The device, NULL when the index is out of range
+ */
+LP50XX *LP50XXChain::GetDevice(uint8_t index) {
+    if (index >= _device_count) {
+        return NULL;
+    }
+    return _devices[index];
+}
+
+/**
+ * @brief Returns the table entry of a pixel, e.g. to build a derived table
+ *
+ * @param pixel The pixel, 0..@ref GetPixelCount - 1
+ * @return const LP50XXPixelMap* The entry, NULL when the pixel is out of range
+ */
+const LP50XXPixelMap *LP50XXChain::GetPixelMap(uint16_t pixel) {
+    if (pixel >= _pixel_count) {
+        return NULL;
+    }
+    return &_pixels[pixel];
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Builds the pixel table from the LED counts and configurations, and orders the devices by transport
+ */
+void LP50XXChain::buildTables() {
+    _pixel_count = 0;
+    for (uint8_t i = 0; i < _device_count; i++) {
+        // Ordering the color indices yields the color at every output of the LED
+        uint8_t order[3];
+        _devices[i]->orderColor(0, 1, 2, order);
+        uint8_t offsets = 0;
+        for (uint8_t output = 0; output < 3; output++) {
+            offsets |= output << (order[output] * 2);
+        }
+
+        for (uint8_t led = 0; led < _led_counts[i]; led++) {
+            _pixels[_pixel_count].device = i;
+            _pixels[_pixel_count].reg = OUT0_COLOR + led * 3;
+            _pixels[_pixel_count].offsets = offsets;
+            _pixel_count++;
+        }
+    }
+
+    // Stable grouping by transport, the devices of a bus stay in the order they were added
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < _device_count; i++) {
+        bool seen = false;
+        for (uint8_t j = 0; j < i; j++) {
+            seen |= transportOf(_devices[j]) == transportOf(_devices[i]);
+        }
+        if (seen) {
+            continue;
+        }
+        for (uint8_t j = i; j < _device_count; j++) {
+            if (transportOf(_devices[j]) == transportOf(_devices[i])) {
+                _flush_order[count++] = j;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns the transport a device writes through. Without a transport it writes through the I2C functions of
+ * @ref I2C_coms.h, which use @ref LP50XXLinuxI2C::Default on Linux
+ *
+ * @param device The device
+ * @return LP50XXTransport* The transport, NULL for the I2C functions of other platforms
+ */
+LP50XXTransport *LP50XXChain::transportOf(LP50XX *device) {
+    LP50XXTransport *transport = device->GetTransport();
+#if !defined(ARDUINO) && defined(__linux__)
+    if (transport == NULL) {
+        transport = &LP50XXLinuxI2C::Default();
+    }
+#endif
+    return transport;
+}
+
+/**
+ * @brief Ends the batch of a transport. A transport that queues the writes of a batch reports their status only
+ * here, so on failure all registers written in the batch are marked dirty again
+ *
+ * @param batch The transport
+ * @param first The first position in the flush order that belongs to the batch
+ * @param end The position after the last one of the batch
+ * @param written The registers every position wrote
+ * @return int8_t 0 on success, otherwise the status of @ref LP50XXTransport::EndBatch
+ */
+int8_t LP50XXChain::endBatch(LP50XXTransport *batch, uint8_t first, uint8_t end, const uint32_t *written) {
+    int8_t status = batch->EndBatch();
+    if (status != 0) {
+        for (uint8_t i = first; i < end; i++) {
+            _devices[_flush_order[i]]->_dirty |= written[i];
+        }
+    }
+    return status;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file LP50XX_Chain.h
+ * @brief Presents several LP5009/LP5012 as one strip of RGB pixels and raw outputs
+ *
+ * Pixels and outputs are numbered across all devices in the order they were added: the pixels of the first device
+ * come first, then those of the second, etc. Output n is channel n % 3 of pixel n / 3 as wired, without color ordering.
+ * The register of every pixel color is looked up in a table that is built once by @ref LP50XXChain::Begin.
+ *
+ * The set functions only stage the values, @ref LP50XXChain::Flush writes all devices in merged bursts and
+ * groups the devices by transport, so every bus gets one batch per frame. On Linux the devices without a transport
+ * are batched on @ref LP50XXLinuxI2C::Default, the bus of the I2C functions.
+ *
+ * @code
+ * chain.Add(device, 0x14);
+ * chain.Add(device2, 0x15);
+ * chain.Begin();
+ *
+ * chain.SetPixel(5, 255, 0, 0); // LED 1 of device2
+ * chain.Flush();
+ * @endcode
+ */
+#ifndef __LP50XX_CHAIN_H
+#define __LP50XX_CHAIN_H
+
+#include "LP50XX.h"
+
+#ifndef LP50XX_CHAIN_MAX_DEVICES
+#define LP50XX_CHAIN_MAX_DEVICES 8      // 4 addresses per bus, more with multiple buses
+#endif
+#define LP50XX_CHAIN_MAX_PIXELS (LP50XX_CHAIN_MAX_DEVICES * 4)
+
+/**
+ * @brief Location of a pixel, the color offsets are packed 2 bits each: red in bits 0-1, green in 2-3 and blue in 4-5
+ */
+struct LP50XXPixelMap {
+    uint8_t     device;     // Index in the chain
+    uint8_t     reg;        // First output register of the pixel
+    uint8_t     offsets;    // Red, green and blue register offset from reg
+};
+
+/**
+ * @brief A chain of devices with a flat pixel index
+ */
+class LP50XXChain
+{
+    public:
+        LP50XXChain();
+
+        bool Add(LP50XX &device, uint8_t i2cAddress, uint8_t ledCount = 0);
+        bool Begin();
+
+        void SetPixel(uint16_t pixel, uint8_t r, uint8_t g, uint8_t b);
+        void SetPixelBrightness(uint16_t pixel, uint8_t brightness);
+        void SetOutput(uint16_t output, uint8_t value);
+        void Fill(uint8_t r, uint8_t g, uint8_t b);
+        int8_t Flush();
+
+        uint16_t GetPixelCount();
+        uint16_t GetOutputCount();
+        LP50XX *GetDevice(uint8_t index);
+        const LP50XXPixelMap *GetPixelMap(uint16_t pixel);
+
+    private:
+        LP50XX         *_devices[LP50XX_CHAIN_MAX_DEVICES];
+        uint8_t         _addresses[LP50XX_CHAIN_MAX_DEVICES];
+        uint8_t         _led_counts[LP50XX_CHAIN_MAX_DEVICES];
+        uint8_t         _flush_order[LP50XX_CHAIN_MAX_DEVICES];   // Devices grouped by transport
+        uint8_t         _device_count = 0;
+
+        LP50XXPixelMap  _pixels[LP50XX_CHAIN_MAX_PIXELS];
+        uint16_t        _pixel_count = 0;
+
+        void buildTables();
+        LP50XXTransport *transportOf(LP50XX *device);
+        int8_t endBatch(LP50XXTransport *batch, uint8_t first, uint8_t end, const uint32_t *written);
+};
+
+#endif
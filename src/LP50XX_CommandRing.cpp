@@ -0,0 +1,177 @@
+/**
+ * @file LP50XX_CommandRing.cpp
+ * @brief Lock-free single-producer/single-consumer ring of LED commands, see @ref LP50XX_CommandRing.h
+ */
+#include "LP50XX_CommandRing.h"
+#include "LP50XX.h"
+
+/**
+ * @brief This function instantiates an empty ring
+ */
+LP50XXCommandRing::LP50XXCommandRing() {
+
+}
+
+/**
+ * @brief Pushes a command. Runs in constant time without locks
+ *
+ * @param command The command
+ * @return true when the command was queued, false when the ring is full and the command was dropped
+ */
+bool LP50XXCommandRing::Push(const LP50XXCommand &command) {
+    return push(command.device, command.type, command.index, command.value[0], command.value[1], command.value[2]);
+}
+
+/**
+ * @brief Pushes a @ref CommandRegister command
+ *
+ * @param device The device index
+ * @param reg The register to stage
+ * @param value The register value
+ * @return true when the command was queued
+ */
+bool LP50XXCommandRing::PushRegister(uint8_t device, uint8_t reg, uint8_t value) {
+    return push(device, CommandRegister, reg, value, 0, 0);
+}
+
+/**
+ * @brief Pushes a @ref CommandOutputColor command
+ *
+ * @param device The device index
+ * @param output The output to set. 0..11
+ * @param value The color value from 0 to 0xFF
+ * @return true when the command was queued
+ */
+bool LP50XXCommandRing::PushOutputColor(uint8_t device, uint8_t output, uint8_t value) {
+    return push(device, CommandOutputColor, output, value, 0, 0);
+}
+
+/**
+ * @brief Pushes a @ref CommandLEDColor command
+ *
+ * @param device The device index
+ * @param led The led to set. 0..3
+ * @param r The red color value from 0 to 0xFF
+ * @param g The green color value from 0 to 0xFF
+ * @param b The blue color value from 0 to 0xFF
+ * @return true when the command was queued
+ */
+bool LP50XXCommandRing::PushLEDColor(uint8_t device, uint8_t led, uint8_t r, uint8_t g, uint8_t b) {
+    return push(device, CommandLEDColor, led, r, g, b);
+}
+
+/**
+ * @brief Pushes a @ref CommandLEDBrightness command
+ *
+ * @param device The device index
+ * @param led The led to set. 0..3
+ * @param brightness The brightness level from 0 to 0xFF
+ * @return true when the command was queued
+ */
+bool LP50XXCommandRing::PushLEDBrightness(uint8_t device, uint8_t led, uint8_t brightness) {
+    return push(device, CommandLEDBrightness, led, brightness, 0, 0);
+}
+
+/**
+ * @brief Returns the number of commands that were dropped because the ring was full. Read by the producer
+ *
+ * @return uint16_t
+ */
+uint16_t LP50XXCommandRing::GetDropped() {
+    return _dropped;
+}
+
+/**
+ * @brief Takes the oldest command from the ring
+ *
+ * @param command The command to fill
+ * @return true when a command was taken, false when the ring is empty
+ */
+bool LP50XXCommandRing::Pop(LP50XXCommand *command) {
+    uint8_t tail = _tail;
+    if (tail == _head) {
+        return false;
+    }
+    LP50XX_RING_BARRIER();
+
+    *command = _commands[tail & (LP50XX_COMMAND_RING_SIZE - 1)];
+
+    LP50XX_RING_BARRIER();
+    _tail = tail + 1;
+    return true;
+}
+
+/**
+ * @brief Takes all queued commands and stages them in the devices. The devices are not flushed
+ *
+ * @param devices The devices the command device indices refer to
+ * @param deviceCount The number of devices, commands for other devices are discarded
+ * @return uint8_t The number of commands taken from the ring
+ */
+uint8_t LP50XXCommandRing::Drain(LP50XX **devices, uint8_t deviceCount) {
+    uint8_t count = 0;
+    LP50XXCommand command;
+    while (Pop(&command)) {
+        count++;
+        if (command.device >= deviceCount) {
+            continue;
+        }
+
+        LP50XX *device = devices[command.device];
+        switch (command.type)
+        {
+        case CommandRegister:
+            device->StageRegister(command.index, command.value[0]);
+            break;
+        case CommandOutputColor:
+            device->StageOutputColor(command.index, command.value[0]);
+            break;
+        case CommandLEDColor:
+            device->StageLEDColor(command.index, command.value[0], command.value[1], command.value[2]);
+            break;
+        case CommandLEDBrightness:
+            device->StageLEDBrightness(command.index, command.value[0]);
+            break;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Returns the number of queued commands
+ *
+ * @return uint8_t
+ */
+uint8_t LP50XXCommandRing::GetCount() {
+    return (uint8_t)(_head - _tail);
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Writes the command into the free slot and publishes it by advancing the head
+ *
+ * @return true when the command was queued
+ */
+bool LP50XXCommandRing::push(uint8_t device, uint8_t type, uint8_t index, uint8_t value0, uint8_t value1, uint8_t value2) {
+    uint8_t head = _head;
+    if ((uint8_t)(head - _tail) == LP50XX_COMMAND_RING_SIZE) {
+        _dropped++;
+        return false;
+    }
+    LP50XX_RING_BARRIER();
+
+    LP50XXCommand &command = _commands[head & (LP50XX_COMMAND_RING_SIZE - 1)];
+    command.device = device;
+    command.type = type;
+    command.index = index;
+    command.value[0] = value0;
+    command.value[1] = value1;
+    command.value[2] = value2;
+
+    LP50XX_RING_BARRIER();
+    _head = head + 1;
+    return true;
+}
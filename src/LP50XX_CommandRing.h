@@ -0,0 +1,95 @@
+/**
+ * @file LP50XX_CommandRing.h
+ * @brief Lock-free single-producer/single-consumer ring of LED commands
+ *
+ * The LP50XX functions access the bus and must not be called from interrupts or from multiple tasks.
+ * Instead every producer (an ISR, a task, the main loop) gets its own ring and pushes commands in constant time.
+ * The context that owns the bus drains the rings, which stages the commands in the devices, and then flushes:
+ *
+ * @code
+ * void buttonISR() {
+ *     buttonRing.PushLEDColor(0, 1, 255, 0, 0);
+ * }
+ *
+ * void loop() {
+ *     buttonRing.Drain(devices, 2);
+ *     loopRing.Drain(devices, 2);
+ *     device.Flush();
+ *     device2.Flush();
+ * }
+ * @endcode
+ */
+#ifndef __LP50XX_COMMAND_RING_H
+#define __LP50XX_COMMAND_RING_H
+
+#include <stdint.h>
+
+#ifndef LP50XX_COMMAND_RING_SIZE
+#define LP50XX_COMMAND_RING_SIZE 16     // Commands per ring, a power of two up to 128
+#endif
+
+#if (LP50XX_COMMAND_RING_SIZE & (LP50XX_COMMAND_RING_SIZE - 1)) || LP50XX_COMMAND_RING_SIZE > 128
+#error "LP50XX_COMMAND_RING_SIZE has to be a power of two up to 128"
+#endif
+
+// Orders the slot accesses against the index updates. The AVR is single core and does not reorder memory accesses
+#if defined(__AVR__)
+#define LP50XX_RING_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define LP50XX_RING_BARRIER() __sync_synchronize()
+#endif
+
+class LP50XX;
+
+enum ECommandType {
+    CommandRegister,        // Stages value[0] in register index
+    CommandOutputColor,     // Stages value[0] as color of output index
+    CommandLEDColor,        // Stages value[0..2] as r, g, b of LED index
+    CommandLEDBrightness    // Stages value[0] as brightness of LED index
+};
+
+/**
+ * @brief A single LED command
+ */
+struct LP50XXCommand {
+    uint8_t     device;     // Index in the device list passed to @ref LP50XXCommandRing::Drain
+    uint8_t     type;       // See @ref ECommandType
+    uint8_t     index;      // Register, output or LED
+    uint8_t     value[3];
+};
+
+/**
+ * @brief Ring of commands with exactly one producer and one consumer
+ */
+class LP50XXCommandRing
+{
+    public:
+        LP50XXCommandRing();
+
+        /**
+         * Producer functions, safe to call from interrupts
+         */
+        bool Push(const LP50XXCommand &command);
+        bool PushRegister(uint8_t device, uint8_t reg, uint8_t value);
+        bool PushOutputColor(uint8_t device, uint8_t output, uint8_t value);
+        bool PushLEDColor(uint8_t device, uint8_t led, uint8_t r, uint8_t g, uint8_t b);
+        bool PushLEDBrightness(uint8_t device, uint8_t led, uint8_t brightness);
+        uint16_t GetDropped();
+
+        /**
+         * Consumer functions, called by the context that owns the bus
+         */
+        bool Pop(LP50XXCommand *command);
+        uint8_t Drain(LP50XX **devices, uint8_t deviceCount);
+        uint8_t GetCount();
+
+    private:
+        LP50XXCommand       _commands[LP50XX_COMMAND_RING_SIZE];
+        volatile uint8_t    _head = 0;      // Written by the producer only
+        volatile uint8_t    _tail = 0;      // Written by the consumer only
+        uint16_t            _dropped = 0;   // Written by the producer only
+
+        bool push(uint8_t device, uint8_t type, uint8_t index, uint8_t value0, uint8_t value1, uint8_t value2);
+};
+
+#endif
@@ -0,0 +1,422 @@
+/**
+ * @file LP50XX_Daemon.cpp
+ * @brief Multi-client LED server for Linux, see @ref LP50XX_Daemon.h
+ */
+#if !defined(ARDUINO) && defined(__linux__)
+
+#include "LP50XX_Daemon.h"
+#include "LP50XX_LinuxI2C.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @brief This function instantiates the server
+ *
+ * @param devices The devices to serve, commands refer to devices[index]
+ * @param deviceCount The number of devices, up to @ref LP50XX_DAEMON_MAX_DEVICES
+ */
+LP50XXDaemon::LP50XXDaemon(LP50XX **devices, uint8_t deviceCount) {
+    _devices = devices;
+    _device_count = deviceCount > LP50XX_DAEMON_MAX_DEVICES ? LP50XX_DAEMON_MAX_DEVICES : deviceCount;
+    _path[0] = 0;
+
+    for (uint8_t i = 0; i < LP50XX_DAEMON_MAX_CLIENTS; i++) {
+        _clients[i].fd = -1;
+    }
+    memset(_owners, LP50XX_DAEMON_NO_OWNER, sizeof(_owners));
+    ResetStats();
+}
+
+LP50XXDaemon::~LP50XXDaemon() {
+    End();
+}
+
+/**
+ * @brief Creates the socket, an existing socket file at the path is replaced
+ *
+ * @param path The path of the Unix socket, e.g. "/run/lp50xx.sock"
+ * @return true when the server is listening
+ */
+bool LP50XXDaemon::Begin(const char *path) {
+    End();
+
+    struct sockaddr_un local = {};
+    local.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(local.sun_path)) {
+        return false;
+    }
+    strcpy(local.sun_path, path);
+
+    _socket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (_socket < 0) {
+        return false;
+    }
+    unlink(path);
+    if (bind(_socket, (struct sockaddr *)&local, sizeof(local)) != 0 || listen(_socket, LP50XX_DAEMON_MAX_CLIENTS) != 0) {
+        close(_socket);
+        _socket = -1;
+        return false;
+    }
+    strcpy(_path, path);
+
+    _deadline_us = micros() + _period_us;
+    _pending = false;
+    ResetStats();
+    return true;
+}
+
+/**
+ * @brief Disconnects all clients and removes the socket
+ */
+void LP50XXDaemon::End() {
+    for (uint8_t i = 0; i < LP50XX_DAEMON_MAX_CLIENTS; i++) {
+        if (_clients[i].fd >= 0) {
+            disconnect(i);
+        }
+    }
+    if (_socket >= 0) {
+        close(_socket);
+        unlink(_path);
+        _socket = -1;
+    }
+}
+
+/**
+ * @brief Sets the length of the frame window
+ *
+ * @param fps The number of frames per second, the devices are flushed at most once per frame
+ */
+void LP50XXDaemon::SetFrameRate(uint16_t fps) {
+    if (fps == 0) {
+        return;
+    }
+    _period_us = 1000000UL / fps;
+}
+
+/**
+ * @brief Accepts clients and stages their messages until the end of the current frame window, then flushes the
+ * devices if anything was written and answers the pending SYNC commands. Call this in a loop, it blocks for at most one frame window
+ *
+ * @return uint16_t The number of messages that were received in this frame window
+ */
+uint16_t LP50XXDaemon::Poll() {
+    uint16_t messages = _stats.messages + _stats.rejected;
+
+    for (;;) {
+        long remaining = (long)(_deadline_us - micros());
+        if (remaining <= 0 || _socket < 0) {
+            break;
+        }
+
+        struct pollfd pfds[LP50XX_DAEMON_MAX_CLIENTS + 1];
+        uint8_t clients[LP50XX_DAEMON_MAX_CLIENTS];
+        nfds_t count = 0;
+        pfds[count++] = { _socket, POLLIN, 0 };
+        for (uint8_t i = 0; i < LP50XX_DAEMON_MAX_CLIENTS; i++) {
+            if (_clients[i].fd >= 0) {
+                clients[count - 1] = i;
+                pfds[count++] = { _clients[i].fd, POLLIN, 0 };
+            }
+        }
+
+        if (poll(pfds, count, (remaining + 999) / 1000) <= 0) {
+            continue;
+        }
+        for (nfds_t i = 1; i < count; i++) {
+            if (pfds[i].revents) {
+                receive(clients[i - 1]);
+            }
+        }
+        if (pfds[0].revents & POLLIN) {
+            accept();
+        }
+    }
+
+    bool sync = false;
+    for (uint8_t i = 0; i < LP50XX_DAEMON_MAX_CLIENTS; i++) {
+        sync |= _clients[i].fd >= 0 && _clients[i].sync;
+    }
+    if (_pending || sync) {
+        int8_t status = FlushFrame();
+        if (status != 0) {
+            _stats.flushErrors++;
+        }
+        _stats.frames++;
+        _pending = false;
+
+        uint8_t reply[2] = { LP50XX_DAEMON_SYNC, (uint8_t)status };
+        for (uint8_t i = 0; i < LP50XX_DAEMON_MAX_CLIENTS; i++) {
+            if (_clients[i].fd >= 0 && _clients[i].sync) {
+                _clients[i].sync = false;
+                send(_clients[i].fd, reply, sizeof(reply), MSG_DONTWAIT | MSG_NOSIGNAL);
+            }
+        }
+    }
+
+    // Keep the frame windows on a fixed grid, unless the flush took longer than a whole window
+    _deadline_us += _period_us;
+    if ((long)(_deadline_us - micros()) < 0) {
+        _deadline_us = micros() + _period_us;
+    }
+    return _stats.messages + _stats.rejected - messages;
+}
+
+/**
+ * @brief Executes the commands of a single message. The message is validated first, an invalid message is not executed at all
+ *
+ * @param client The client slot of the sender
+ * @param pdata The message
+ * @param length The length of the message
+ * @return true when the message was valid
+ */
+bool LP50XXDaemon::ProcessMessage(uint8_t client, const uint8_t *pdata, size_t length) {
+    if (client >= LP50XX_DAEMON_MAX_CLIENTS || !validate(pdata, length)) {
+        _stats.rejected++;
+        return false;
+    }
+
+    size_t index = 0;
+    while (index < length) {
+        switch (pdata[index])
+        {
+        case LP50XX_DAEMON_PRIORITY:
+            _clients[client].priority = pdata[index + 1];
+            index += 2;
+            break;
+        case LP50XX_DAEMON_WRITE:
+            stage(client, pdata[index + 1], pdata[index + 2], &pdata[index + 4], pdata[index + 3]);
+            index += 4 + pdata[index + 3];
+            break;
+        case LP50XX_DAEMON_RELEASE:
+            release(client, pdata[index + 1], pdata[index + 2], pdata[index + 3]);
+            index += 4;
+            break;
+        default:
+            _clients[client].sync = true;
+            index += 1;
+            break;
+        }
+    }
+
+    _stats.messages++;
+    return true;
+}
+
+/**
+ * @brief Flushes all devices, the devices of a bus as one batch. A transport that queues the writes of a batch
+ * reports their status only at its end, so on failure all registers written in the batch are marked dirty again
+ *
+ * @return int8_t 0 on success, otherwise the status of the last failed flush or batch
+ */
+int8_t LP50XXDaemon::FlushFrame() {
+    int8_t result = 0;
+    uint32_t written[LP50XX_DAEMON_MAX_DEVICES];
+
+    for (uint8_t i = 0; i < _device_count; i++) {
+        // Every bus is flushed once, when its first device comes up
+        LP50XXTransport *transport = transportOf(i);
+        bool seen = false;
+        for (uint8_t j = 0; j < i; j++) {
+            seen |= transportOf(j) == transport;
+        }
+        if (seen) {
+            continue;
+        }
+
+        transport->BeginBatch();
+        for (uint8_t j = i; j < _device_count; j++) {
+            if (transportOf(j) != transport) {
+                continue;
+            }
+            LP50XX *device = _devices[j];
+            device->checkRecovery();
+            uint32_t dirty = device->_dirty;
+            int8_t status = device->Flush();
+            written[j] = dirty & ~device->_dirty;
+            if (status != 0) {
+                result = status;
+            }
+        }
+        int8_t status = transport->EndBatch();
+        if (status != 0) {
+            for (uint8_t j = i; j < _device_count; j++) {
+                if (transportOf(j) == transport) {
+                    _devices[j]->_dirty |= written[j];
+                }
+            }
+            result = status;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the server statistics
+ *
+ * @param stats The statistics to fill
+ */
+void LP50XXDaemon::GetStats(LP50XXDaemonStats *stats) {
+    *stats = _stats;
+    stats->clients = 0;
+    for (uint8_t i = 0; i < LP50XX_DAEMON_MAX_CLIENTS; i++) {
+        if (_clients[i].fd >= 0) {
+            stats->clients++;
+        }
+    }
+    stats->elapsedUs = micros() - _stats_start_us;
+}
+
+/**
+ * @brief Resets the server statistics
+ */
+void LP50XXDaemon::ResetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+    _stats_start_us = micros();
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Accepts all waiting clients, clients beyond @ref LP50XX_DAEMON_MAX_CLIENTS are closed immediately
+ */
+void LP50XXDaemon::accept() {
+    int fd;
+    while ((fd = accept4(_socket, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0) {
+        uint8_t slot = 0;
+        while (slot < LP50XX_DAEMON_MAX_CLIENTS && _clients[slot].fd >= 0) {
+            slot++;
+        }
+        if (slot == LP50XX_DAEMON_MAX_CLIENTS) {
+            close(fd);
+            continue;
+        }
+        _clients[slot].fd = fd;
+        _clients[slot].priority = 0;
+        _clients[slot].sync = false;
+    }
+}
+
+/**
+ * @brief Closes a client and releases all its registers. Values it wrote stay on the devices
+ *
+ * @param client The client slot
+ */
+void LP50XXDaemon::disconnect(uint8_t client) {
+    close(_clients[client].fd);
+    _clients[client].fd = -1;
+    for (uint8_t device = 0; device < _device_count; device++) {
+        release(client, device, 0, LP50XX_REGISTER_COUNT);
+    }
+}
+
+/**
+ * @brief Receives all queued messages of a client
+ *
+ * @param client The client slot
+ */
+void LP50XXDaemon::receive(uint8_t client) {
+    uint8_t message[LP50XX_DAEMON_MAX_MESSAGE];
+    for (;;) {
+        ssize_t length = recv(_clients[client].fd, message, sizeof(message), MSG_DONTWAIT);
+        if (length > 0) {
+            ProcessMessage(client, message, length);
+        } else if (length == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            disconnect(client);
+            return;
+        } else {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Checks that a message only holds complete commands for existing devices and registers
+ *
+ * @param pdata The message
+ * @param length The length of the message
+ * @return true when the message is valid
+ */
+bool LP50XXDaemon::validate(const uint8_t *pdata, size_t length) {
+    size_t index = 0;
+    while (index < length) {
+        switch (pdata[index])
+        {
+        case LP50XX_DAEMON_PRIORITY:
+            index += 2;
+            break;
+        case LP50XX_DAEMON_WRITE:
+        case LP50XX_DAEMON_RELEASE:
+            if (index + 4 > length || pdata[index + 1] >= _device_count ||
+                pdata[index + 2] + pdata[index + 3] > LP50XX_REGISTER_COUNT) {
+                return false;
+            }
+            index += pdata[index] == LP50XX_DAEMON_WRITE ? 4 + pdata[index + 3] : 4;
+            break;
+        case LP50XX_DAEMON_SYNC:
+            index += 1;
+            break;
+        default:
+            return false;
+        }
+    }
+    return index == length;
+}
+
+/**
+ * @brief Stages the registers the client owns or may take over
+ *
+ * @param client The client slot
+ * @param device The device index
+ * @param reg The first register
+ * @param pdata The register values
+ * @param count The number of registers
+ */
+void LP50XXDaemon::stage(uint8_t client, uint8_t device, uint8_t reg, const uint8_t *pdata, uint8_t count) {
+    uint8_t *owners = _owners[device];
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t owner = owners[reg + i];
+        if (owner != client && owner != LP50XX_DAEMON_NO_OWNER && _clients[client].priority <= _clients[owner].priority) {
+            _stats.denied++;
+            continue;
+        }
+        owners[reg + i] = client;
+        _devices[device]->StageRegister(reg + i, pdata[i]);
+        _stats.writes++;
+    }
+    _pending = true;
+}
+
+/**
+ * @brief Returns the bus of a device, the I2C functions of @ref I2C_coms.h use @ref LP50XXLinuxI2C::Default
+ *
+ * @param device The device index
+ * @return LP50XXTransport* The transport
+ */
+LP50XXTransport *LP50XXDaemon::transportOf(uint8_t device) {
+    LP50XXTransport *transport = _devices[device]->GetTransport();
+    return transport != NULL ? transport : &LP50XXLinuxI2C::Default();
+}
+
+/**
+ * @brief Releases the registers the client owns
+ *
+ * @param client The client slot
+ * @param device The device index
+ * @param reg The first register
+ * @param count The number of registers
+ */
+void LP50XXDaemon::release(uint8_t client, uint8_t device, uint8_t reg, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (_owners[device][reg + i] == client) {
+            _owners[device][reg + i] = LP50XX_DAEMON_NO_OWNER;
+        }
+    }
+}
+
+#endif
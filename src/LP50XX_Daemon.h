@@ -0,0 +1,107 @@
+/**
+ * @file LP50XX_Daemon.h
+ * @brief Multi-client LED server for Linux on a Unix domain socket
+ *
+ * The server owns the devices and their buses. Clients connect to a SOCK_SEQPACKET Unix socket and send messages,
+ * every message holds one or more commands:
+ *
+ * | Command                       | Bytes                                         |
+ * |-------------------------------|-----------------------------------------------|
+ * | @ref LP50XX_DAEMON_PRIORITY   | 0x01, priority                                |
+ * | @ref LP50XX_DAEMON_WRITE      | 0x02, device, register, count, count values   |
+ * | @ref LP50XX_DAEMON_RELEASE    | 0x03, device, register, count                 |
+ * | @ref LP50XX_DAEMON_SYNC       | 0x04                                          |
+ *
+ * A write stages the values in the shadow image of the device. All writes within one frame window are merged and
+ * the devices are flushed once at the end of the window, so the bus traffic per frame does not grow with the number
+ * of clients. The devices of a bus are flushed as one batch (see @ref LP50XXTransport::BeginBatch). A SYNC is answered
+ * with 0x04 and the flush status once the frame holding the preceding writes is flushed, the status includes the end
+ * of the batch.
+ *
+ * Every register has an owner: the first client that writes it. Writes of other clients are ignored, unless their
+ * priority (default 0) is higher than the priority of the owner, then they take over the register. Registers are
+ * released with RELEASE or when the owner disconnects. A message with an invalid command is rejected as a whole.
+ */
+#ifndef __LP50XX_DAEMON_H
+#define __LP50XX_DAEMON_H
+
+#include <stddef.h>
+#include "LP50XX.h"
+
+#define LP50XX_DAEMON_PRIORITY 0x01
+#define LP50XX_DAEMON_WRITE 0x02
+#define LP50XX_DAEMON_RELEASE 0x03
+#define LP50XX_DAEMON_SYNC 0x04
+
+#define LP50XX_DAEMON_MAX_CLIENTS 64
+#define LP50XX_DAEMON_MAX_DEVICES 16
+#define LP50XX_DAEMON_MAX_MESSAGE 1024
+#define LP50XX_DAEMON_DEFAULT_FPS 100
+#define LP50XX_DAEMON_NO_OWNER 0xFF
+
+/**
+ * @brief Server statistics, all counters start at @ref LP50XXDaemon::Begin or @ref LP50XXDaemon::ResetStats
+ */
+struct LP50XXDaemonStats {
+    uint32_t    clients;        // Currently connected clients
+    uint32_t    messages;       // Accepted messages
+    uint32_t    rejected;       // Messages with an invalid command
+    uint32_t    writes;         // Staged register values
+    uint32_t    denied;         // Register values ignored because another client owns the register
+    uint32_t    frames;         // Frame windows that ended with a flush
+    uint32_t    flushErrors;    // Frames where at least one device failed to flush
+    uint64_t    elapsedUs;      // Time since the counters started
+};
+
+/**
+ * @brief Serves the devices to multiple clients and flushes their merged updates once per frame
+ */
+class LP50XXDaemon
+{
+    public:
+        LP50XXDaemon(LP50XX **devices, uint8_t deviceCount);
+        ~LP50XXDaemon();
+
+        bool Begin(const char *path);
+        void End();
+        void SetFrameRate(uint16_t fps);
+
+        uint16_t Poll();
+        bool ProcessMessage(uint8_t client, const uint8_t *pdata, size_t length);
+        int8_t FlushFrame();
+
+        void GetStats(LP50XXDaemonStats *stats);
+        void ResetStats();
+
+    private:
+        struct Client {
+            int         fd;
+            uint8_t     priority;
+            bool        sync;
+        };
+
+        LP50XX    **_devices;
+        uint8_t     _device_count;
+        int         _socket = -1;
+        char        _path[108];
+
+        Client      _clients[LP50XX_DAEMON_MAX_CLIENTS];
+        uint8_t     _owners[LP50XX_DAEMON_MAX_DEVICES][LP50XX_REGISTER_COUNT];
+
+        unsigned long   _period_us = 1000000UL / LP50XX_DAEMON_DEFAULT_FPS;
+        unsigned long   _deadline_us = 0;
+        bool            _pending = false;
+
+        LP50XXDaemonStats   _stats;
+        unsigned long       _stats_start_us = 0;
+
+        void accept();
+        void disconnect(uint8_t client);
+        void receive(uint8_t client);
+        bool validate(const uint8_t *pdata, size_t length);
+        void stage(uint8_t client, uint8_t device, uint8_t reg, const uint8_t *pdata, uint8_t count);
+        LP50XXTransport *transportOf(uint8_t device);
+        void release(uint8_t client, uint8_t device, uint8_t reg, uint8_t count);
+};
+
+#endif
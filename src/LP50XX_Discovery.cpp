@@ -0,0 +1,135 @@
+/**
+ * @file LP50XX_Discovery.cpp
+ * @brief Finds the LP5009/LP5012 devices on one or more buses, see @ref LP50XX_Discovery.h
+ */
+#include "LP50XX_Discovery.h"
+#include "I2C_coms.h"
+
+#define VARIANT_TEST_VALUE 0x5A
+
+/**
+ * @brief Scans a bus for devices
+ *
+ * @param transport The bus, NULL for the I2C functions of @ref I2C_coms.h (i2c_init() is called)
+ * @param devices The table to fill
+ * @param maxCount The size of the table
+ * @param detectVariant Whether to detect the variant of every device, 4 register accesses per device
+ * @return uint8_t The number of devices found
+ */
+uint8_t LP50XXDiscovery::Scan(LP50XXTransport *transport, LP50XXDeviceInfo *devices, uint8_t maxCount, bool detectVariant) {
+    if (transport == NULL) {
+        i2c_init();
+    }
+    if (!Probe(transport, BROADCAST_ADDRESS)) {
+        return 0;
+    }
+
+    uint8_t count = 0;
+    for (uint8_t address = LP50XX_FIRST_ADDRESS; address < LP50XX_FIRST_ADDRESS + LP50XX_ADDRESS_COUNT && count < maxCount; address++) {
+        if (!Probe(transport, address)) {
+            continue;
+        }
+        devices[count].transport = transport;
+        devices[count].address = address;
+        devices[count].variant = detectVariant ? DetectVariant(transport, address) : VariantUnknown;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Scans several buses, the devices are listed bus after bus. A scan takes at most 5 probes per bus
+ * plus the variant detection of the devices found
+ *
+ * @param transports The buses, an entry may be NULL for the I2C functions of @ref I2C_coms.h
+ * @param busCount The number of buses
+ * @param devices The table to fill
+ * @param maxCount The size of the table
+ * @param detectVariant Whether to detect the variant of every device
+ * @return uint8_t The number of devices found
+ */
+uint8_t LP50XXDiscovery::ScanBuses(LP50XXTransport **transports, uint8_t busCount, LP50XXDeviceInfo *devices, uint8_t maxCount, bool detectVariant) {
+    uint8_t count = 0;
+    for (uint8_t bus = 0; bus < busCount && count < maxCount; bus++) {
+        count += Scan(transports[bus], &devices[count], maxCount - count, detectVariant);
+    }
+    return count;
+}
+
+/**
+ * @brief Checks whether a device acknowledges an address
+ *
+ * @param transport The bus, NULL for the I2C functions of @ref I2C_coms.h
+ * @param address The I2C address
+ * @return true when the address was acknowledged
+ */
+bool LP50XXDiscovery::Probe(LP50XXTransport *transport, uint8_t address) {
+    if (transport != NULL) {
+        return transport->Probe(address) == 0;
+    }
+    return i2c_probe(address) == 0;
+}
+
+/**
+ * @brief Detects the variant of a device from whether LED3_BRIGHTNESS can be written
+ *
+ * @param transport The bus, NULL for the I2C functions of @ref I2C_coms.h
+ * @param address The I2C address of the device
+ * @return EVariant @ref VariantUnknown when a register access failed
+ */
+EVariant LP50XXDiscovery::DetectVariant(LP50XXTransport *transport, uint8_t address) {
+    uint8_t original;
+    uint8_t readBack;
+    if (read(transport, address, LED3_BRIGHTNESS, &original) != 0) {
+        return VariantUnknown;
+    }
+
+    uint8_t test = original ^ VARIANT_TEST_VALUE;
+    if (write(transport, address, LED3_BRIGHTNESS, test) != 0 || read(transport, address, LED3_BRIGHTNESS, &readBack) != 0) {
+        return VariantUnknown;
+    }
+    if (readBack != test) {
+        return VariantLP5009;
+    }
+
+    write(transport, address, LED3_BRIGHTNESS, original);
+    return VariantLP5012;
+}
+
+/**
+ * @brief Returns the number of RGB LEDs of a variant
+ *
+ * @param variant The @ref EVariant
+ * @return uint8_t 3 for the LP5009, otherwise 4
+ */
+uint8_t LP50XXDiscovery::GetLEDCount(uint8_t variant) {
+    return variant == VariantLP5009 ? 3 : 4;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Writes a register through the transport, or the I2C functions of @ref I2C_coms.h without a transport
+ *
+ * @return int8_t 0 on success
+ */
+int8_t LP50XXDiscovery::write(LP50XXTransport *transport, uint8_t address, uint8_t reg, uint8_t value) {
+    if (transport != NULL) {
+        return transport->Write(address, reg, &value, 1);
+    }
+    return i2c_write_byte(address, reg, value);
+}
+
+/**
+ * @brief Reads a register through the transport, or the I2C functions of @ref I2C_coms.h without a transport
+ *
+ * @return int8_t 0 on success
+ */
+int8_t LP50XXDiscovery::read(LP50XXTransport *transport, uint8_t address, uint8_t reg, uint8_t *value) {
+    if (transport != NULL) {
+        return transport->Read(address, reg, value, 1);
+    }
+    return i2c_read_byte(address, reg, value);
+}
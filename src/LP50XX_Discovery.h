@@ -0,0 +1,55 @@
+/**
+ * @file LP50XX_Discovery.h
+ * @brief Finds the LP5009/LP5012 devices on one or more buses
+ *
+ * A scan first probes the broadcast address, which every LP50XX acknowledges, so a bus without devices costs a
+ * single transaction. Otherwise the addresses 0x14..0x17 are probed with address only writes. The bus timeout
+ * of @ref LP50XX_I2C_TIMEOUT_US bounds every probe where the platform supports it.
+ *
+ * The LP5009 and LP5012 have no ID register. When requested the variant is detected from LED3_BRIGHTNESS, which
+ * only exists on the LP5012: a test value is written, read back and the original value is restored.
+ *
+ * @code
+ * LP50XXDeviceInfo found[4];
+ * uint8_t count = LP50XXDiscovery::Scan(NULL, found, 4);
+ * for (uint8_t i = 0; i < count; i++) {
+ *     devices[i].SetVariant((EVariant)found[i].variant);
+ *     chain.Add(devices[i], found[i].address);
+ * }
+ * @endcode
+ */
+#ifndef __LP50XX_DISCOVERY_H
+#define __LP50XX_DISCOVERY_H
+
+#include "LP50XX.h"
+
+#define LP50XX_FIRST_ADDRESS 0x14
+#define LP50XX_ADDRESS_COUNT 4
+
+/**
+ * @brief A device that was found
+ */
+struct LP50XXDeviceInfo {
+    LP50XXTransport    *transport;  // The bus, NULL for the I2C functions of @ref I2C_coms.h
+    uint8_t             address;
+    uint8_t             variant;    // See @ref EVariant
+};
+
+/**
+ * @brief Bus scanning functions
+ */
+class LP50XXDiscovery
+{
+    public:
+        static uint8_t Scan(LP50XXTransport *transport, LP50XXDeviceInfo *devices, uint8_t maxCount, bool detectVariant = true);
+        static uint8_t ScanBuses(LP50XXTransport **transports, uint8_t busCount, LP50XXDeviceInfo *devices, uint8_t maxCount, bool detectVariant = true);
+        static bool Probe(LP50XXTransport *transport, uint8_t address);
+        static EVariant DetectVariant(LP50XXTransport *transport, uint8_t address);
+        static uint8_t GetLEDCount(uint8_t variant);
+
+    private:
+        static int8_t write(LP50XXTransport *transport, uint8_t address, uint8_t reg, uint8_t value);
+        static int8_t read(LP50XXTransport *transport, uint8_t address, uint8_t reg, uint8_t *value);
+};
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * @file LP50XX_FrameBuffer.cpp
+ * @brief Page flipped frame buffer for a single LP50XX, see @ref LP50XX_FrameBuffer.h
+ */
+#include "LP50XX_FrameBuffer.h"
+
+#define LP50XX_FRAME_FRESH 0x80     // Set in _published by Commit, cleared when Flush takes the page
+#define LP50XX_FRAME_INDEX 0x03
+
+/**
+ * @brief This function instantiates the frame buffer with the register defaults of the device
+ *
+ * @param device The device the frames are flushed to
+ */
+LP50XXFrameBuffer::LP50XXFrameBuffer(LP50XX &device) : _device(device) {
+    memset(_pages, 0x00, sizeof(_pages));
+    for (uint8_t page = 0; page < 3; page++) {
+        _pages[page][BANK_BRIGHTNESS - LP50XX_FRAME_FIRST] = 0xFF;
+        for (uint8_t led = 0; led < 4; led++) {
+            _pages[page][LED0_BRIGHTNESS + led - LP50XX_FRAME_FIRST] = 0xFF;
+        }
+    }
+}
+
+/*----------------------- Renderer functions --------------------------------*/
+
+/**
+ * @brief Copies the shadow image of the device into the back page, e.g. after @ref LP50XX::Begin or direct writes.
+ * Must not run while the flusher is active
+ */
+void LP50XXFrameBuffer::Load() {
+    for (uint8_t i = 0; i < LP50XX_FRAME_SIZE; i++) {
+        _pages[_back][i] = _device.GetShadowRegister(LP50XX_FRAME_FIRST + i);
+    }
+}
+
+/**
+ * @brief Sets a register in the back page
+ *
+ * @param reg The register, LED_CONFIG0 up to OUT11_COLOR. Other registers are ignored
+ * @param value The register value
+ */
+void LP50XXFrameBuffer::SetRegister(uint8_t reg, uint8_t value) {
+    if (reg < LP50XX_FRAME_FIRST || reg >= LP50XX_REGISTER_COUNT) {
+        return;
+    }
+    _pages[_back][reg - LP50XX_FRAME_FIRST] = value;
+}
+
+/**
+ * @brief Sets the brightness level of a single LED (3 outputs) in the back page
+ *
+ * @param led The led to set. 0..3
+ * @param brightness The brightness value from 0 to 0xFF
+ */
+void LP50XXFrameBuffer::SetLEDBrightness(uint8_t led, uint8_t brightness) {
+    SetRegister(LED0_BRIGHTNESS + led, brightness);
+}
+
+/**
+ * @brief Sets the color level of a single output in the back page
+ *
+ * @param output The output to set. 0..11
+ * @param value The color value from 0 to 0xFF
+ */
+void LP50XXFrameBuffer::SetOutputColor(uint8_t output, uint8_t value) {
+    SetRegister(OUT0_COLOR + output, value);
+}
+
+/**
+ * @brief Sets the LED color in the back page according to the LED configuration of the device
+ *
+ * @param led The led to set. 0..3
+ * @param r The red color value from 0 to 0xFF
+ * @param g The green color value from 0 to 0xFF
+ * @param b The blue color value from 0 to 0xFF
+ */
+void LP50XXFrameBuffer::SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t buff[3];
+    _device.orderColor(r, g, b, buff);
+
+    SetRegister(OUT0_COLOR + (led * 3), buff[0]);
+    SetRegister(OUT0_COLOR + (led * 3) + 1, buff[1]);
+    SetRegister(OUT0_COLOR + (led * 3) + 2, buff[2]);
+}
+
+/**
+ * @brief Returns a register of the back page
+ *
+ * @param reg The register, LED_CONFIG0 up to OUT11_COLOR
+ * @return uint8_t The value, 0 for other registers
+ */
+uint8_t LP50XXFrameBuffer::GetRegister(uint8_t reg) {
+    if (reg < LP50XX_FRAME_FIRST || reg >= LP50XX_REGISTER_COUNT) {
+        return 0;
+    }
+    return _pages[_back][reg - LP50XX_FRAME_FIRST];
+}
+
+/**
+ * @brief Publishes the back page as the next frame. Wait-free, a frame that was not flushed yet is replaced.
+ * The new back page starts as a copy of the committed frame, so rendering can continue incrementally
+ */
+void LP50XXFrameBuffer::Commit() {
+    uint8_t committed = _back;
+    _back = exchangePublished(committed | LP50XX_FRAME_FRESH) & LP50XX_FRAME_INDEX;
+
+    // The committed page is only read from here on, by both sides
+    memcpy(_pages[_back], _pages[committed], LP50XX_FRAME_SIZE);
+}
+
+/*----------------------- Flusher functions ---------------------------------*/
+
+/**
+ * @brief Takes the latest committed frame, if any, and writes the registers that differ from the last sent frame.
+ * Without a new frame only registers of a previously failed flush are written
+ *
+ * @return int8_t 0 on success, otherwise the status of @ref LP50XX::Flush
+ */
+int8_t LP50XXFrameBuffer::Flush() {
+    if (_published & LP50XX_FRAME_FRESH) {
+        _front = exchangePublished(_front) & LP50XX_FRAME_INDEX;
+
+        for (uint8_t i = 0; i < LP50XX_FRAME_SIZE; i++) {
+            _device.StageRegister(LP50XX_FRAME_FIRST + i, _pages[_front][i]);
+        }
+        _frames++;
+    }
+    return _device.Flush();
+}
+
+/**
+ * @brief Returns the number of committed frames that were taken by @ref Flush. Frames replaced before a flush are not counted
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXFrameBuffer::GetFrameCount() {
+    return _frames;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Swaps the published page index, the only state shared by the renderer and the flusher
+ *
+ * @param value The new index and fresh flag
+ * @return uint8_t The previous index and fresh flag
+ */
+uint8_t LP50XXFrameBuffer::exchangePublished(uint8_t value) {
+    uint8_t previous;
+#if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+    previous = _published;
+    _published = value;
+    SREG = sreg;
+#elif defined(ARDUINO) && defined(__arm__)
+    // The Cortex-M0 has no exclusive access instructions
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    previous = _published;
+    _published = value;
+    __set_PRIMASK(primask);
+#else
+    previous = __atomic_exchange_n(&_published, value, __ATOMIC_ACQ_REL);
+#endif
+    return previous;
+}
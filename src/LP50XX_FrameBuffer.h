@@ -0,0 +1,67 @@
+/**
+ * @file LP50XX_FrameBuffer.h
+ * @brief Page flipped frame buffer for a single LP50XX, so a flush never sends a half rendered frame
+ *
+ * The renderer only writes the back page and publishes it with @ref LP50XXFrameBuffer::Commit, which swaps the page
+ * index in one atomic exchange. @ref LP50XXFrameBuffer::Flush takes the latest committed page as front page, stages
+ * it in the shadow image of the device (only registers that differ from what was sent become dirty) and flushes.
+ *
+ * A third page is kept as the published page between the two, so neither side ever waits for the other:
+ * the renderer can commit while a flush is still reading the front page, and the renderer is never blocked by the bus.
+ * The renderer and the flusher may run in different threads, tasks or an interrupt and the main loop.
+ *
+ * @code
+ * // Renderer
+ * frame.SetLEDColor(0, 255, 0, 0);
+ * frame.SetLEDColor(1, 0, 255, 0);
+ * frame.Commit();
+ *
+ * // Flusher
+ * frame.Flush();
+ * @endcode
+ */
+#ifndef __LP50XX_FRAME_BUFFER_H
+#define __LP50XX_FRAME_BUFFER_H
+
+#include "LP50XX.h"
+
+#define LP50XX_FRAME_FIRST LED_CONFIG0                              // First register of a frame, the device configuration is not part of it
+#define LP50XX_FRAME_SIZE (LP50XX_REGISTER_COUNT - LP50XX_FRAME_FIRST)
+
+/**
+ * @brief Front/back register pages of one device
+ */
+class LP50XXFrameBuffer
+{
+    public:
+        LP50XXFrameBuffer(LP50XX &device);
+
+        /**
+         * Renderer functions
+         */
+        void Load();
+        void SetRegister(uint8_t reg, uint8_t value);
+        void SetLEDBrightness(uint8_t led, uint8_t brightness);
+        void SetOutputColor(uint8_t output, uint8_t value);
+        void SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b);
+        uint8_t GetRegister(uint8_t reg);
+        void Commit();
+
+        /**
+         * Flusher functions
+         */
+        int8_t Flush();
+        uint32_t GetFrameCount();
+
+    private:
+        LP50XX             &_device;
+        uint8_t             _pages[3][LP50XX_FRAME_SIZE];
+        uint8_t             _back = 0;              // Owned by the renderer
+        uint8_t             _front = 1;             // Owned by the flusher
+        volatile uint8_t    _published = 2;         // Page index, with LP50XX_FRAME_FRESH when it was not flushed yet
+        uint32_t            _frames = 0;            // Flushed frames, owned by the flusher
+
+        uint8_t exchangePublished(uint8_t value);
+};
+
+#endif
@@ -0,0 +1,193 @@
+/**
+ * @file LP50XX_Grid.cpp
+ * @brief Maps a 2D panel of RGB pixels onto the pixels of a chain, see @ref LP50XX_Grid.h
+ */
+#include "LP50XX_Grid.h"
+
+/**
+ * @brief This function instantiates an empty panel
+ *
+ * @param chain The chain, it has to be started with @ref LP50XXChain::Begin before the panel
+ */
+LP50XXGrid::LP50XXGrid(LP50XXChain &chain) : _chain(chain) {
+
+}
+
+/**
+ * @brief Builds a panel that is a single tile starting at chain pixel 0
+ *
+ * @param width The width of the panel
+ * @param height The height of the panel
+ * @param wiring LP50XX_WIRING_... flags
+ * @param rotation The @ref ERotation of the wiring on the panel
+ * @return true when the panel fits in @ref LP50XX_GRID_MAX_CELLS
+ */
+bool LP50XXGrid::Begin(uint8_t width, uint8_t height, uint8_t wiring, uint8_t rotation) {
+    LP50XXTile tile = { 0, 0, width, height, 0, wiring, rotation };
+    return Begin(width, height, &tile, 1);
+}
+
+/**
+ * @brief Compiles the tiles into the cell table. Cells without a tile, or with a chain pixel beyond the end of the chain, stay dark
+ *
+ * @param width The width of the panel
+ * @param height The height of the panel
+ * @param tiles The tiles
+ * @param tileCount The number of tiles
+ * @return true when the panel fits in @ref LP50XX_GRID_MAX_CELLS and all tiles are inside the panel
+ */
+bool LP50XXGrid::Begin(uint8_t width, uint8_t height, const LP50XXTile *tiles, uint8_t tileCount) {
+    if ((uint16_t)width * height > LP50XX_GRID_MAX_CELLS) {
+        return false;
+    }
+    _width = width;
+    _height = height;
+    memset(_cells, 0, sizeof(_cells));
+
+    bool result = true;
+    for (uint8_t t = 0; t < tileCount; t++) {
+        const LP50XXTile &tile = tiles[t];
+        if (tile.x + tile.width > width || tile.y + tile.height > height) {
+            result = false;
+            continue;
+        }
+
+        // The wiring runs in the unrotated tile, which is transposed for 90 and 270 degrees
+        bool transposed = tile.rotation == Rotation90 || tile.rotation == Rotation270;
+        uint8_t wiredWidth = transposed ? tile.height : tile.width;
+        uint8_t wiredHeight = transposed ? tile.width : tile.height;
+
+        for (uint16_t i = 0; i < (uint16_t)tile.width * tile.height; i++) {
+            uint8_t column;
+            uint8_t row;
+            if (tile.wiring & LP50XX_WIRING_COLUMNS) {
+                column = i / wiredHeight;
+                row = i % wiredHeight;
+                if ((tile.wiring & LP50XX_WIRING_SERPENTINE) && (column & 1)) {
+                    row = wiredHeight - 1 - row;
+                }
+            } else {
+                row = i / wiredWidth;
+                column = i % wiredWidth;
+                if ((tile.wiring & LP50XX_WIRING_SERPENTINE) && (row & 1)) {
+                    column = wiredWidth - 1 - column;
+                }
+            }
+
+            uint8_t x;
+            uint8_t y;
+            switch (tile.rotation)
+            {
+            case Rotation0:
+            default:
+                x = column;
+                y = row;
+                break;
+            case Rotation90:
+                x = wiredHeight - 1 - row;
+                y = column;
+                break;
+            case Rotation180:
+                x = wiredWidth - 1 - column;
+                y = wiredHeight - 1 - row;
+                break;
+            case Rotation270:
+                x = row;
+                y = wiredWidth - 1 - column;
+                break;
+            }
+
+            const LP50XXPixelMap *map = _chain.GetPixelMap(tile.firstPixel + i);
+            if (map == NULL) {
+                continue;
+            }
+            LP50XXCell &cell = _cells[(uint16_t)(tile.y + y) * width + tile.x + x];
+            cell.device = _chain.GetDevice(map->device);
+            cell.red = map->reg + (map->offsets & 0x03);
+            cell.green = map->reg + (map->offsets >> 2 & 0x03);
+            cell.blue = map->reg + (map->offsets >> 4 & 0x03);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Stages the color of a panel pixel
+ *
+ * @param x The column, 0 is left
+ * @param y The row, 0 is top
+ * @param r The red color value from 0 to 0xFF
+ * @param g The green color value from 0 to 0xFF
+ * @param b The blue color value from 0 to 0xFF
+ */
+void LP50XXGrid::SetPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b) {
+    if (x >= _width || y >= _height) {
+        return;
+    }
+    const LP50XXCell &cell = _cells[(uint16_t)y * _width + x];
+    if (cell.device == NULL) {
+        return;
+    }
+    cell.device->StageRegister(cell.red, r);
+    cell.device->StageRegister(cell.green, g);
+    cell.device->StageRegister(cell.blue, b);
+}
+
+/**
+ * @brief Stages the same color for all pixels of the panel
+ *
+ * @param r The red color value from 0 to 0xFF
+ * @param g The green color value from 0 to 0xFF
+ * @param b The blue color value from 0 to 0xFF
+ */
+void LP50XXGrid::Fill(uint8_t r, uint8_t g, uint8_t b) {
+    const LP50XXCell *cell = _cells;
+    for (uint16_t i = (uint16_t)_width * _height; i > 0; i--, cell++) {
+        if (cell->device != NULL) {
+            cell->device->StageRegister(cell->red, r);
+            cell->device->StageRegister(cell->green, g);
+            cell->device->StageRegister(cell->blue, b);
+        }
+    }
+}
+
+/**
+ * @brief Writes the staged pixels, see @ref LP50XXChain::Flush
+ *
+ * @return int8_t 0 on success, otherwise the status of the last failed flush
+ */
+int8_t LP50XXGrid::Flush() {
+    return _chain.Flush();
+}
+
+/**
+ * @brief Returns the width of the panel
+ *
+ * @return uint8_t
+ */
+uint8_t LP50XXGrid::GetWidth() {
+    return _width;
+}
+
+/**
+ * @brief Returns the height of the panel
+ *
+ * @return uint8_t
+ */
+uint8_t LP50XXGrid::GetHeight() {
+    return _height;
+}
+
+/**
+ * @brief Returns the table entry of a panel cell, e.g. for effects that write the registers themselves
+ *
+ * @param x The column, 0 is left
+ * @param y The row, 0 is top
+ * @return const LP50XXCell* The entry, NULL outside of the panel
+ */
+const LP50XXCell *LP50XXGrid::GetCell(uint8_t x, uint8_t y) {
+    if (x >= _width || y >= _height) {
+        return NULL;
+    }
+    return &_cells[(uint16_t)y * _width + x];
+}
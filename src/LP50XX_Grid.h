@@ -0,0 +1,90 @@
+/**
+ * @file LP50XX_Grid.h
+ * @brief Maps a 2D panel of RGB pixels onto the pixels of a @ref LP50XXChain
+ *
+ * A panel consists of one or more tiles. Every tile describes where its first chain pixel is, how its pixels are
+ * wired (rows or columns, straight or serpentine) and how it is rotated on the panel. @ref LP50XXGrid::Begin compiles
+ * the tiles once into a table that holds the device and the red, green and blue register of every cell, so
+ * @ref LP50XXGrid::SetPixel is a single table lookup.
+ *
+ * @code
+ * // Two 4x2 tiles next to each other, the second one is mounted upside down
+ * const LP50XXTile tiles[] = {
+ *     { 0, 0, 4, 2, 0, LP50XX_WIRING_SERPENTINE, Rotation0 },
+ *     { 4, 0, 4, 2, 8, LP50XX_WIRING_SERPENTINE, Rotation180 },
+ * };
+ * grid.Begin(8, 2, tiles, 2);
+ * grid.SetPixel(x, y, 255, 0, 0);
+ * grid.Flush();
+ * @endcode
+ */
+#ifndef __LP50XX_GRID_H
+#define __LP50XX_GRID_H
+
+#include "LP50XX_Chain.h"
+
+#ifndef LP50XX_GRID_MAX_CELLS
+#define LP50XX_GRID_MAX_CELLS LP50XX_CHAIN_MAX_PIXELS
+#endif
+
+#define LP50XX_WIRING_ROWS 0x00         // The wiring runs along the rows, left to right
+#define LP50XX_WIRING_COLUMNS 0x01      // The wiring runs along the columns, top to bottom
+#define LP50XX_WIRING_SERPENTINE 0x02   // Every second row or column runs backwards
+
+enum ERotation {
+    Rotation0,
+    Rotation90,     // Clockwise
+    Rotation180,
+    Rotation270
+};
+
+/**
+ * @brief A rectangular part of the panel with consecutive chain pixels
+ */
+struct LP50XXTile {
+    uint8_t     x;          // Left column on the panel
+    uint8_t     y;          // Top row on the panel
+    uint8_t     width;      // Width on the panel, after rotation
+    uint8_t     height;     // Height on the panel, after rotation
+    uint16_t    firstPixel; // Chain pixel at the start of the wiring
+    uint8_t     wiring;     // LP50XX_WIRING_... flags
+    uint8_t     rotation;   // See @ref ERotation
+};
+
+/**
+ * @brief Location of a panel cell
+ */
+struct LP50XXCell {
+    LP50XX     *device;     // NULL when no pixel is mounted at the cell
+    uint8_t     red;
+    uint8_t     green;
+    uint8_t     blue;
+};
+
+/**
+ * @brief A 2D panel on top of a chain
+ */
+class LP50XXGrid
+{
+    public:
+        LP50XXGrid(LP50XXChain &chain);
+
+        bool Begin(uint8_t width, uint8_t height, uint8_t wiring = LP50XX_WIRING_ROWS, uint8_t rotation = Rotation0);
+        bool Begin(uint8_t width, uint8_t height, const LP50XXTile *tiles, uint8_t tileCount);
+
+        void SetPixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b);
+        void Fill(uint8_t r, uint8_t g, uint8_t b);
+        int8_t Flush();
+
+        uint8_t GetWidth();
+        uint8_t GetHeight();
+        const LP50XXCell *GetCell(uint8_t x, uint8_t y);
+
+    private:
+        LP50XXChain    &_chain;
+        LP50XXCell      _cells[LP50XX_GRID_MAX_CELLS];
+        uint8_t         _width = 0;
+        uint8_t         _height = 0;
+};
+
+#endif
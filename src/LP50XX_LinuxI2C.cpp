@@ -0,0 +1,343 @@
+/**
+ * @file LP50XX_LinuxI2C.cpp
+ * @brief I2C transport for Linux i2c-dev, see @ref LP50XX_LinuxI2C.h
+ */
+#if !defined(ARDUINO) && defined(__linux__)
+
+#include "LP50XX_LinuxI2C.h"
+#include "LP50XX_Platform.h"
+#include "LP50XX_Trace.h"
+#include "LP50XX_Profile.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// Status codes follow Wire.endTransmission()
+#define STATUS_OK 0
+#define STATUS_TOO_LONG 1
+#define STATUS_NACK 2
+#define STATUS_OTHER 4
+#define STATUS_TIMEOUT 5
+
+static int systemIoctl(int fd, unsigned long request, void *arg) {
+    return ioctl(fd, request, arg);
+}
+
+/**
+ * @brief This function instantiates the transport
+ *
+ * @param ioctlFunction The ioctl to use, NULL for the system ioctl
+ */
+LP50XXLinuxI2C::LP50XXLinuxI2C(LP50XXIoctl ioctlFunction) {
+    _ioctl = ioctlFunction ? ioctlFunction : systemIoctl;
+}
+
+LP50XXLinuxI2C::~LP50XXLinuxI2C() {
+    Close();
+}
+
+/**
+ * @brief Opens an i2c-dev bus
+ *
+ * @param path The bus device, e.g. "/dev/i2c-1"
+ * @return true when the bus is opened
+ */
+bool LP50XXLinuxI2C::Open(const char *path) {
+    Close();
+
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    _fd = fd;
+    _owns_fd = true;
+    return true;
+}
+
+/**
+ * @brief Uses an already opened file descriptor, e.g. together with an injected ioctl when there is no I2C hardware
+ *
+ * @param fd The file descriptor, it is not closed by the transport
+ */
+void LP50XXLinuxI2C::Attach(int fd) {
+    Close();
+
+    _fd = fd;
+    _owns_fd = false;
+}
+
+/**
+ * @brief Submits any queued writes and closes the bus
+ */
+void LP50XXLinuxI2C::Close() {
+    if (_fd >= 0) {
+        submitQueued();
+        if (_owns_fd) {
+            close(_fd);
+        }
+    }
+    _fd = -1;
+    _owns_fd = false;
+    _batching = false;
+}
+
+/**
+ * @brief Returns whether a bus is opened or attached
+ *
+ * @return true when a bus is available
+ */
+bool LP50XXLinuxI2C::IsOpen() {
+    return _fd >= 0;
+}
+
+/**
+ * @brief Replaces the ioctl, e.g. to run the default transport on a simulated bus
+ *
+ * @param ioctlFunction The ioctl to use, NULL for the system ioctl
+ */
+void LP50XXLinuxI2C::SetIoctl(LP50XXIoctl ioctlFunction) {
+    _ioctl = ioctlFunction ? ioctlFunction : systemIoctl;
+}
+
+/**
+ * @brief Writes consecutive registers. Inside a batch the write is queued and returns 0, its status is reported by @ref EndBatch
+ *
+ * @param deviceAddress The I2C address of the device
+ * @param registerAddress The first register to write
+ * @param pdata The register values
+ * @param count The number of register values
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t LP50XXLinuxI2C::Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+    LP50XX_PROFILE_SCOPE(ProfileI2CWrite);
+    if (count + 1 > LP50XX_LINUX_I2C_MAX_WRITE) {
+        return STATUS_TOO_LONG;
+    }
+
+    if (_queued == LP50XX_LINUX_I2C_MAX_MESSAGES) {
+        submitEarly();
+    }
+
+    uint16_t offset = _queued_bytes;
+    _buffer[offset] = registerAddress;
+    memcpy(&_buffer[offset + 1], pdata, count);
+    _addresses[_queued] = deviceAddress;
+    _offsets[_queued] = offset;
+    _lengths[_queued] = count + 1;
+    _queued++;
+    _queued_bytes += count + 1;
+
+    if (_batching) {
+        return STATUS_OK;
+    }
+    return submitQueued();
+}
+
+/**
+ * @brief Reads consecutive registers with a repeated start, as a single ioctl. The queued writes of a batch are submitted first
+ *
+ * @param deviceAddress The I2C address of the device
+ * @param registerAddress The first register to read
+ * @param pdata The buffer for the register values
+ * @param count The number of registers to read
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t LP50XXLinuxI2C::Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    LP50XX_PROFILE_SCOPE(ProfileI2CRead);
+    submitEarly();
+
+    struct i2c_msg messages[2];
+    messages[0].addr = deviceAddress;
+    messages[0].flags = 0;
+    messages[0].len = 1;
+    messages[0].buf = &registerAddress;
+    messages[1].addr = deviceAddress;
+    messages[1].flags = I2C_M_RD;
+    messages[1].len = count;
+    messages[1].buf = pdata;
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t result = transfer(messages, 2);
+#if LP50XX_TELEMETRY
+    _telemetry.Record(TelemetryRead, deviceAddress, count, result, micros() - start);
+#endif
+    LP50XX_TRACE_RECORD(TraceRead, deviceAddress, registerAddress, pdata, count, result);
+    return result;
+}
+
+/**
+ * @brief Checks whether a device acknowledges its address with a zero length write. The queued writes of a batch are
+ * submitted first
+ *
+ * @param deviceAddress The I2C address to probe
+ * @return int8_t 0 when the device acknowledged, 2 on a NACK
+ */
+int8_t LP50XXLinuxI2C::Probe(uint8_t deviceAddress) {
+    submitEarly();
+
+    uint8_t unused = 0;
+    struct i2c_msg message;
+    message.addr = deviceAddress;
+    message.flags = 0;
+    message.len = 0;
+    message.buf = &unused;
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t result = transfer(&message, 1);
+#if LP50XX_TELEMETRY
+    _telemetry.Record(TelemetryProbe, deviceAddress, 0, result, micros() - start);
+#endif
+    LP50XX_TRACE_RECORD(TraceProbe, deviceAddress, 0, NULL, 0, result);
+    return result;
+}
+
+/**
+ * @brief Starts queueing writes until @ref EndBatch
+ */
+void LP50XXLinuxI2C::BeginBatch() {
+    _batching = true;
+    _batch_status = STATUS_OK;
+}
+
+/**
+ * @brief Submits all queued writes as one ioctl and stops queueing
+ *
+ * @return int8_t 0 when all writes of the batch succeeded, also those submitted early, otherwise a
+ * Wire.endTransmission() compatible error
+ */
+int8_t LP50XXLinuxI2C::EndBatch() {
+    LP50XX_PROFILE_SCOPE(ProfileI2CWrite);
+    _batching = false;
+    int8_t result = submitQueued();
+    if (result == STATUS_OK) {
+        result = _batch_status;
+    }
+    _batch_status = STATUS_OK;
+    return result;
+}
+
+/**
+ * @brief Returns the number of ioctls since the last @ref ResetCounters
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXLinuxI2C::GetSyscallCount() {
+    return _syscalls;
+}
+
+/**
+ * @brief Returns the number of I2C messages since the last @ref ResetCounters
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXLinuxI2C::GetMessageCount() {
+    return _messages;
+}
+
+/**
+ * @brief Resets the ioctl and message counters
+ */
+void LP50XXLinuxI2C::ResetCounters() {
+    _syscalls = 0;
+    _messages = 0;
+}
+
+/**
+ * @brief Returns the transport used by the I2C functions of @ref I2C_coms.h
+ *
+ * @return LP50XXLinuxI2C&
+ */
+LP50XXLinuxI2C &LP50XXLinuxI2C::Default() {
+    static LP50XXLinuxI2C bus;
+    return bus;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Submits the queued writes of a batch before its end. They were queued by other calls, so their status is
+ * kept for @ref EndBatch instead of being returned to the current caller
+ */
+void LP50XXLinuxI2C::submitEarly() {
+    int8_t result = submitQueued();
+    if (result != STATUS_OK && _batch_status == STATUS_OK) {
+        _batch_status = result;
+    }
+}
+
+/**
+ * @brief Submits the queued writes as one ioctl
+ *
+ * @return int8_t
+ */
+int8_t LP50XXLinuxI2C::submitQueued() {
+    if (_queued == 0) {
+        return STATUS_OK;
+    }
+
+    struct i2c_msg messages[LP50XX_LINUX_I2C_MAX_MESSAGES];
+    for (uint8_t i = 0; i < _queued; i++) {
+        messages[i].addr = _addresses[i];
+        messages[i].flags = 0;
+        messages[i].len = _lengths[i];
+        messages[i].buf = &_buffer[_offsets[i]];
+    }
+    uint8_t count = _queued;
+    _queued = 0;
+    _queued_bytes = 0;
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t result = transfer(messages, count);
+#if LP50XX_TELEMETRY
+    // The messages of one ioctl share its status and time
+    unsigned long latency = (micros() - start) / count;
+    for (uint8_t i = 0; i < count; i++) {
+        _telemetry.Record(TelemetryWrite, _addresses[i], _lengths[i] - 1, result, latency);
+    }
+#endif
+#if LP50XX_TRACE
+    for (uint8_t i = 0; i < count; i++) {
+        LP50XXTrace::Record(TraceWrite, _addresses[i], _buffer[_offsets[i]], &_buffer[_offsets[i] + 1], _lengths[i] - 1, result);
+    }
+#endif
+    return result;
+}
+
+/**
+ * @brief Performs the I2C_RDWR ioctl
+ *
+ * @param messages The i2c_msg array
+ * @param count The number of messages
+ * @return int8_t
+ */
+int8_t LP50XXLinuxI2C::transfer(void *messages, uint32_t count) {
+    if (_fd < 0) {
+        return STATUS_OTHER;
+    }
+
+    struct i2c_rdwr_ioctl_data data;
+    data.msgs = (struct i2c_msg *)messages;
+    data.nmsgs = count;
+
+    _syscalls++;
+    _messages += count;
+    if (_ioctl(_fd, I2C_RDWR, &data) < 0) {
+        if (errno == ETIMEDOUT) {
+            return STATUS_TIMEOUT;
+        }
+        return errno == ENXIO || errno == EREMOTEIO ? STATUS_NACK : STATUS_OTHER;
+    }
+    return STATUS_OK;
+}
+
+#endif
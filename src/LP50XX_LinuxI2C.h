@@ -0,0 +1,90 @@
+/**
+ * @file LP50XX_LinuxI2C.h
+ * @brief I2C transport for Linux i2c-dev (/dev/i2c-N) based on the I2C_RDWR ioctl
+ *
+ * Every write and every register read is a single ioctl. Between @ref LP50XXLinuxI2C::BeginBatch and
+ * @ref LP50XXLinuxI2C::EndBatch writes are queued and submitted together as one multi-message ioctl,
+ * also when they are addressed to different devices:
+ *
+ * @code
+ * bus.BeginBatch();
+ * device.Flush();
+ * device2.Flush();
+ * bus.EndBatch(); // One ioctl for both devices
+ * @endcode
+ *
+ * Writes inside a batch return 0 before they are on the bus, only the status of EndBatch counts for them. When the
+ * queue is full or a read needs the bus, the queued writes are submitted early and their status is reported by
+ * EndBatch as well. A batch user that clears state on a successful write, like the dirty bits of @ref LP50XX::Flush,
+ * restores it when EndBatch fails, see @ref LP50XXChain::Flush.
+ *
+ * The I2C functions of @ref I2C_coms.h use @ref LP50XXLinuxI2C::Default on Linux.
+ */
+#ifndef __LP50XX_LINUX_I2C_H
+#define __LP50XX_LINUX_I2C_H
+
+#include <stdint.h>
+#include "LP50XX_Transport.h"
+
+#ifndef LP50XX_LINUX_I2C_DEVICE
+#define LP50XX_LINUX_I2C_DEVICE "/dev/i2c-1"   // Bus opened by i2c_init() when no bus was opened before
+#endif
+#define LP50XX_LINUX_I2C_MAX_MESSAGES 42        // I2C_RDWR_IOCTL_MAX_MSGS of the kernel
+#define LP50XX_LINUX_I2C_MAX_WRITE 24           // Register address and a full register map
+
+/**
+ * @brief The ioctl used by the transport, can be replaced to run without I2C hardware
+ */
+typedef int (*LP50XXIoctl)(int fd, unsigned long request, void *arg);
+
+/**
+ * @brief Linux i2c-dev transport
+ */
+class LP50XXLinuxI2C : public LP50XXTransport
+{
+    public:
+        LP50XXLinuxI2C(LP50XXIoctl ioctlFunction = 0);
+        ~LP50XXLinuxI2C();
+
+        bool Open(const char *path);
+        void Attach(int fd);
+        void Close();
+        bool IsOpen();
+        void SetIoctl(LP50XXIoctl ioctlFunction);
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count);
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count);
+        int8_t Probe(uint8_t deviceAddress);
+
+        void BeginBatch();
+        int8_t EndBatch();
+
+        uint32_t GetSyscallCount();
+        uint32_t GetMessageCount();
+        void ResetCounters();
+
+        static LP50XXLinuxI2C &Default();
+
+    private:
+        LP50XXIoctl _ioctl;
+        int         _fd = -1;
+        bool        _owns_fd = false;
+
+        bool        _batching = false;
+        uint8_t     _queued = 0;
+        uint16_t    _queued_bytes = 0;
+        int8_t      _batch_status = 0;          // First failure of the writes of the batch that were submitted early
+        uint8_t     _buffer[LP50XX_LINUX_I2C_MAX_MESSAGES * LP50XX_LINUX_I2C_MAX_WRITE];
+        uint16_t    _addresses[LP50XX_LINUX_I2C_MAX_MESSAGES];
+        uint16_t    _offsets[LP50XX_LINUX_I2C_MAX_MESSAGES];
+        uint16_t    _lengths[LP50XX_LINUX_I2C_MAX_MESSAGES];
+
+        uint32_t    _syscalls = 0;
+        uint32_t    _messages = 0;
+
+        int8_t submitQueued();
+        void submitEarly();
+        int8_t transfer(void *messages, uint32_t count);
+};
+
+#endif
@@ -0,0 +1,256 @@
+/**
+ * @file LP50XX_MultiBus.cpp
+ * @brief Flushes devices on multiple I2C buses in parallel, see @ref LP50XX_MultiBus.h
+ */
+#include "LP50XX_MultiBus.h"
+
+/**
+ * @brief This function instantiates the coordinator without any devices
+ */
+LP50XXMultiBusFlush::LP50XXMultiBusFlush() {
+    memset(_buses, 0, sizeof(_buses));
+}
+
+LP50XXMultiBusFlush::~LP50XXMultiBusFlush() {
+    End();
+}
+
+/**
+ * @brief Adds a device to the group of its transport. Devices have to be added before @ref Begin
+ *
+ * @param device The device, its transport has to be set already
+ * @return true when the device was added, false when the bus or device limit is reached or the workers are running
+ */
+bool LP50XXMultiBusFlush::Add(LP50XX *device) {
+    if (_running) {
+        return false;
+    }
+
+    uint8_t index = 0;
+    while (index < _bus_count && _buses[index].transport != device->GetTransport()) {
+        index++;
+    }
+    if (index == _bus_count) {
+        if (_bus_count == LP50XX_MULTIBUS_MAX_BUSES) {
+            return false;
+        }
+        _buses[index].owner = this;
+        _buses[index].transport = device->GetTransport();
+        _buses[index].count = 0;
+        _bus_count++;
+    }
+
+    LP50XXBusGroup &bus = _buses[index];
+    if (bus.count == LP50XX_MULTIBUS_MAX_DEVICES) {
+        return false;
+    }
+    bus.devices[bus.count++] = device;
+    return true;
+}
+
+/**
+ * @brief Starts one worker for every bus but the first
+ *
+ * @return true when the workers are running, false on platforms without workers
+ */
+bool LP50XXMultiBusFlush::Begin() {
+    if (_running) {
+        return true;
+    }
+
+#if defined(LP50XX_MULTIBUS_THREADS)
+    _running = true;
+    for (uint8_t i = 1; i < _bus_count; i++) {
+        _threads[i] = std::thread(&LP50XXMultiBusFlush::worker, this, i);
+    }
+    return true;
+#elif defined(LP50XX_MULTIBUS_FREERTOS)
+    _done = xSemaphoreCreateCounting(LP50XX_MULTIBUS_MAX_BUSES, 0);
+    if (_done == NULL) {
+        return false;
+    }
+    _running = true;
+    for (uint8_t i = 1; i < _bus_count; i++) {
+        xTaskCreate(worker, "LP50XX bus", LP50XX_MULTIBUS_STACK_SIZE, &_buses[i], uxTaskPriorityGet(NULL), &_tasks[i]);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Stops the workers, the buses are flushed one after the other afterwards
+ */
+void LP50XXMultiBusFlush::End() {
+    if (!_running) {
+        return;
+    }
+
+#if defined(LP50XX_MULTIBUS_THREADS)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _start.notify_all();
+    for (uint8_t i = 1; i < _bus_count; i++) {
+        _threads[i].join();
+    }
+#elif defined(LP50XX_MULTIBUS_FREERTOS)
+    _running = false;
+    for (uint8_t i = 1; i < _bus_count; i++) {
+        xTaskNotifyGive(_tasks[i]);
+        xSemaphoreTake(_done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(_done);
+    _done = NULL;
+#endif
+}
+
+/**
+ * @brief Flushes all devices. The buses are flushed in parallel when the workers are running,
+ * the frame is complete when this function returns
+ *
+ * @return int8_t 0 on success, otherwise the status of a failed flush
+ */
+int8_t LP50XXMultiBusFlush::Flush() {
+    if (_bus_count == 0) {
+        return 0;
+    }
+
+    if (_running && _bus_count > 1) {
+#if defined(LP50XX_MULTIBUS_THREADS)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending = _bus_count - 1;
+            _generation++;
+        }
+        _start.notify_all();
+
+        _buses[0].result = flushBus(_buses[0]);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _pending == 0; });
+#elif defined(LP50XX_MULTIBUS_FREERTOS)
+        for (uint8_t i = 1; i < _bus_count; i++) {
+            xTaskNotifyGive(_tasks[i]);
+        }
+
+        _buses[0].result = flushBus(_buses[0]);
+
+        for (uint8_t i = 1; i < _bus_count; i++) {
+            xSemaphoreTake(_done, portMAX_DELAY);
+        }
+#endif
+    } else {
+        for (uint8_t i = 0; i < _bus_count; i++) {
+            _buses[i].result = flushBus(_buses[i]);
+        }
+    }
+
+    int8_t result = 0;
+    for (uint8_t i = 0; i < _bus_count; i++) {
+        if (_buses[i].result != 0) {
+            result = _buses[i].result;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the number of buses
+ *
+ * @return uint8_t
+ */
+uint8_t LP50XXMultiBusFlush::GetBusCount() {
+    return _bus_count;
+}
+
+/*
+ *  PRIVATE
+ */
+
+#if defined(LP50XX_MULTIBUS_THREADS)
+/**
+ * @brief Worker thread, flushes its bus once for every started frame
+ *
+ * @param index The bus of the worker
+ */
+void LP50XXMultiBusFlush::worker(uint8_t index) {
+    uint32_t generation = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _start.wait(lock, [&] { return !_running || _generation != generation; });
+        if (!_running) {
+            return;
+        }
+        generation = _generation;
+
+        lock.unlock();
+        _buses[index].result = flushBus(_buses[index]);
+        lock.lock();
+
+        if (--_pending == 0) {
+            _done.notify_one();
+        }
+    }
+}
+#elif defined(LP50XX_MULTIBUS_FREERTOS)
+/**
+ * @brief Worker task, flushes its bus once for every notification
+ *
+ * @param parameter The @ref LP50XXBusGroup of the worker
+ */
+void LP50XXMultiBusFlush::worker(void *parameter) {
+    LP50XXBusGroup &bus = *(LP50XXBusGroup *)parameter;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!bus.owner->_running) {
+            xSemaphoreGive(bus.owner->_done);
+            vTaskDelete(NULL);
+            return;
+        }
+        bus.result = flushBus(bus);
+        xSemaphoreGive(bus.owner->_done);
+    }
+}
+#endif
+
+/**
+ * @brief Flushes all devices of a bus as one batch and starts a frame of the retry policy of the bus. A transport
+ * that queues the writes of a batch reports their status only at its end, so on failure all registers written in
+ * the batch are marked dirty again
+ *
+ * @param bus The bus
+ * @return int8_t 0 on success, otherwise the status of a failed flush
+ */
+int8_t LP50XXMultiBusFlush::flushBus(LP50XXBusGroup &bus) {
+    int8_t result = 0;
+    uint32_t written[LP50XX_MULTIBUS_MAX_DEVICES];
+    for (uint8_t i = 0; i < bus.count; i++) {
+        bus.devices[i]->GetRetryPolicy().BeginFrame();
+    }
+    if (bus.transport != NULL) {
+        bus.transport->BeginBatch();
+    }
+    for (uint8_t i = 0; i < bus.count; i++) {
+        LP50XX *device = bus.devices[i];
+        device->checkRecovery();
+        uint32_t dirty = device->_dirty;
+        int8_t status = device->Flush();
+        written[i] = dirty & ~device->_dirty;
+        if (status != 0) {
+            result = status;
+        }
+    }
+    if (bus.transport != NULL) {
+        int8_t status = bus.transport->EndBatch();
+        if (status != 0) {
+            for (uint8_t i = 0; i < bus.count; i++) {
+                bus.devices[i]->_dirty |= written[i];
+            }
+            result = status;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file LP50XX_MultiBus.h
+ * @brief Flushes devices on multiple I2C buses in parallel
+ *
+ * The devices are grouped by their transport (see @ref LP50XX::SetTransport), every group is one bus.
+ * After @ref LP50XXMultiBusFlush::Begin every bus but the first gets its own worker, a std::thread on Linux or a
+ * FreeRTOS task on the ESP32, and the first bus is flushed by the caller. @ref LP50XXMultiBusFlush::Flush only
+ * returns when every bus is done. On other platforms, or before Begin, the buses are flushed one after the other.
+ */
+#ifndef __LP50XX_MULTIBUS_H
+#define __LP50XX_MULTIBUS_H
+
+#include "LP50XX.h"
+
+#if !defined(ARDUINO) && defined(__linux__)
+#define LP50XX_MULTIBUS_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#elif defined(ESP32)
+#define LP50XX_MULTIBUS_FREERTOS
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+#define LP50XX_MULTIBUS_MAX_BUSES 4
+#define LP50XX_MULTIBUS_MAX_DEVICES 8      // Per bus, 4 addresses per bus unless multiplexers are used
+#define LP50XX_MULTIBUS_STACK_SIZE 2048    // FreeRTOS worker stack size in bytes
+
+class LP50XXMultiBusFlush;
+
+/**
+ * @brief The devices of one bus
+ */
+struct LP50XXBusGroup {
+    LP50XXMultiBusFlush    *owner;
+    LP50XXTransport        *transport;
+    LP50XX                 *devices[LP50XX_MULTIBUS_MAX_DEVICES];
+    uint8_t                 count;
+    int8_t                  result;
+};
+
+/**
+ * @brief Flush coordinator with one worker per bus
+ */
+class LP50XXMultiBusFlush
+{
+    public:
+        LP50XXMultiBusFlush();
+        ~LP50XXMultiBusFlush();
+
+        bool Add(LP50XX *device);
+        bool Begin();
+        void End();
+
+        int8_t Flush();
+        uint8_t GetBusCount();
+
+    private:
+        LP50XXBusGroup  _buses[LP50XX_MULTIBUS_MAX_BUSES];
+        uint8_t         _bus_count = 0;
+        bool            _running = false;
+
+#if defined(LP50XX_MULTIBUS_THREADS)
+        std::thread             _threads[LP50XX_MULTIBUS_MAX_BUSES];
+        std::mutex              _mutex;
+        std::condition_variable _start;
+        std::condition_variable _done;
+        uint32_t                _generation = 0;
+        uint8_t                 _pending = 0;
+
+        void worker(uint8_t index);
+#elif defined(LP50XX_MULTIBUS_FREERTOS)
+        TaskHandle_t            _tasks[LP50XX_MULTIBUS_MAX_BUSES];
+        SemaphoreHandle_t       _done = NULL;
+
+        static void worker(void *parameter);
+#endif
+
+        static int8_t flushBus(LP50XXBusGroup &bus);
+};
+
+#endif
@@ -0,0 +1,393 @@
+/**
+ * @file LP50XX_Mux.cpp
+ * @brief Support for devices behind TCA9548A/PCA9548A style I2C multiplexers, see @ref LP50XX_Mux.h
+ */
+#include "LP50XX_Mux.h"
+#include "I2C_coms.h"
+
+LP50XXMux *LP50XXMux::_first = NULL;
+
+/*----------------------- Multiplexer functions -----------------------------*/
+
+/**
+ * @brief This function instantiates a multiplexer
+ *
+ * @param address The I2C address of the multiplexer, 0x70..0x77
+ * @param upstream The bus of the multiplexer, NULL for the I2C functions of @ref I2C_coms.h
+ */
+LP50XXMux::LP50XXMux(uint8_t address, LP50XXTransport *upstream) {
+    _address = address;
+    _upstream = upstream;
+
+    _next = _first;
+    _first = this;
+}
+
+LP50XXMux::~LP50XXMux() {
+    LP50XXMux **link = &_first;
+    while (*link != NULL && *link != this) {
+        link = &(*link)->_next;
+    }
+    if (*link != NULL) {
+        *link = _next;
+    }
+}
+
+/**
+ * @brief Disables all channels, so the cached state is known
+ *
+ * @return int8_t 0 on success
+ */
+int8_t LP50XXMux::Begin() {
+    return writeControl(0);
+}
+
+/**
+ * @brief Enables the given channels and disables all other multiplexers on the same bus. Nothing is written when
+ * the cached state already matches
+ *
+ * @param channels Bit n enables channel n
+ * @return int8_t 0 on success
+ */
+int8_t LP50XXMux::Select(uint8_t channels) {
+    int8_t result = 0;
+    if (channels != 0) {
+        for (LP50XXMux *mux = _first; mux != NULL; mux = mux->_next) {
+            if (mux != this && mux->_upstream == _upstream && (mux->_selected != 0 || !mux->_known)) {
+                int8_t status = mux->writeControl(0);
+                if (status != 0) {
+                    result = status;
+                }
+            }
+        }
+    }
+
+    if (!_known || _selected != channels) {
+        int8_t status = writeControl(channels);
+        if (status != 0) {
+            result = status;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the cached state of the control register
+ *
+ * @return uint8_t Bit n is set when channel n is enabled
+ */
+uint8_t LP50XXMux::GetSelected() {
+    return _selected;
+}
+
+/**
+ * @brief Returns the bus of the multiplexer
+ *
+ * @return LP50XXTransport* NULL for the I2C functions of @ref I2C_coms.h
+ */
+LP50XXTransport *LP50XXMux::GetUpstream() {
+    return _upstream;
+}
+
+/**
+ * @brief Returns the number of control register writes since the last @ref ResetSwitchCount
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXMux::GetSwitchCount() {
+    return _switches;
+}
+
+/**
+ * @brief Resets the control register write counter
+ */
+void LP50XXMux::ResetSwitchCount() {
+    _switches = 0;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Writes the control register, it has no register address so the channels are sent in its place
+ *
+ * @param channels Bit n enables channel n
+ * @return int8_t 0 on success, on failure the state is unknown
+ */
+int8_t LP50XXMux::writeControl(uint8_t channels) {
+    _switches++;
+    int8_t status = upstreamWrite(_address, channels, &channels, 0);
+    _selected = channels;
+    _known = status == 0;
+    return status;
+}
+
+/**
+ * @brief Writes through the upstream transport, or the I2C functions of @ref I2C_coms.h without one
+ *
+ * @return int8_t 0 on success
+ */
+int8_t LP50XXMux::upstreamWrite(uint8_t address, uint8_t reg, const uint8_t *pdata, uint32_t count) {
+    if (_upstream != NULL) {
+        return _upstream->Write(address, reg, pdata, count);
+    }
+    return i2c_write_multi(address, reg, (uint8_t *)pdata, count);
+}
+
+/**
+ * @brief Reads through the upstream transport, or the I2C functions of @ref I2C_coms.h without one
+ *
+ * @return int8_t 0 on success
+ */
+int8_t LP50XXMux::upstreamRead(uint8_t address, uint8_t reg, uint8_t *pdata, uint32_t count) {
+    if (_upstream != NULL) {
+        return _upstream->Read(address, reg, pdata, count);
+    }
+    return i2c_read_multi(address, reg, pdata, count);
+}
+
+/*----------------------- Channel functions ---------------------------------*/
+
+/**
+ * @brief This function instantiates a transport behind a multiplexer
+ *
+ * @param mux The multiplexer
+ * @param channels Bit n for channel n. With several channels a broadcast write reaches the devices behind all of them
+ */
+LP50XXMuxChannel::LP50XXMuxChannel(LP50XXMux &mux, uint8_t channels) : _mux(mux) {
+    _channels = channels;
+}
+
+/**
+ * @brief Selects the channels if necessary and writes consecutive registers
+ *
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t LP50XXMuxChannel::Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t status = select(deviceAddress);
+    if (status == 0) {
+        status = _mux.upstreamWrite(deviceAddress, registerAddress, pdata, count);
+    }
+#if LP50XX_TELEMETRY
+    _telemetry.Record(TelemetryWrite, deviceAddress, count, status, micros() - start);
+#endif
+    return status;
+}
+
+/**
+ * @brief Selects the channels if necessary and reads consecutive registers
+ *
+ * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+ */
+int8_t LP50XXMuxChannel::Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t status = select(deviceAddress);
+    if (status == 0) {
+        status = _mux.upstreamRead(deviceAddress, registerAddress, pdata, count);
+    }
+#if LP50XX_TELEMETRY
+    _telemetry.Record(TelemetryRead, deviceAddress, count, status, micros() - start);
+#endif
+    return status;
+}
+
+/**
+ * @brief Selects the channels if necessary and probes a device address
+ *
+ * @return int8_t 0 when the device acknowledged
+ */
+int8_t LP50XXMuxChannel::Probe(uint8_t deviceAddress) {
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t status = select(deviceAddress);
+    if (status == 0) {
+        status = _mux._upstream != NULL ? _mux._upstream->Probe(deviceAddress) : i2c_probe(deviceAddress);
+    }
+#if LP50XX_TELEMETRY
+    _telemetry.Record(TelemetryProbe, deviceAddress, 0, status, micros() - start);
+#endif
+    return status;
+}
+
+/**
+ * @brief Starts a batch on the upstream transport
+ */
+void LP50XXMuxChannel::BeginBatch() {
+    if (_mux._upstream != NULL) {
+        _mux._upstream->BeginBatch();
+    }
+}
+
+/**
+ * @brief Ends a batch on the upstream transport
+ *
+ * @return int8_t 0 on success
+ */
+int8_t LP50XXMuxChannel::EndBatch() {
+    if (_mux._upstream != NULL) {
+        return _mux._upstream->EndBatch();
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the multiplexer of the channel
+ *
+ * @return LP50XXMux&
+ */
+LP50XXMux &LP50XXMuxChannel::GetMux() {
+    return _mux;
+}
+
+/**
+ * @brief Returns the channels
+ *
+ * @return uint8_t Bit n for channel n
+ */
+uint8_t LP50XXMuxChannel::GetChannels() {
+    return _channels;
+}
+
+/**
+ * @brief Switches the multiplexer unless the enabled channels already reach the device. Additional enabled channels
+ * are kept for normal addresses, they were enabled together because they have no device at the same address
+ *
+ * @param deviceAddress The address that will be accessed
+ * @return int8_t 0 on success
+ */
+int8_t LP50XXMuxChannel::select(uint8_t deviceAddress) {
+    if (_mux._known) {
+        if (deviceAddress == BROADCAST_ADDRESS ? _mux._selected == _channels : (_mux._selected & _channels) == _channels) {
+            return 0;
+        }
+    }
+    return _mux.Select(_channels);
+}
+
+/*----------------------- Flush functions -----------------------------------*/
+
+/**
+ * @brief This function instantiates a flusher without any devices
+ */
+LP50XXMuxFlush::LP50XXMuxFlush() {
+
+}
+
+/**
+ * @brief Adds a device and sets its transport to the channel
+ *
+ * @param device The device
+ * @param channel The channel the device is connected to, a single channel
+ * @return true when the device was added, false when the flusher is full
+ */
+bool LP50XXMuxFlush::Add(LP50XX &device, LP50XXMuxChannel &channel) {
+    if (_device_count == LP50XX_MUX_MAX_DEVICES) {
+        return false;
+    }
+    device.SetTransport(&channel);
+    _devices[_device_count] = &device;
+    _channels[_device_count] = &channel;
+    _device_count++;
+    return true;
+}
+
+/**
+ * @brief Flushes all dirty devices. The multiplexer that is currently switched is flushed first, then every other
+ * multiplexer once. Per multiplexer as many channels as possible are enabled together. Starts a frame of the retry
+ * policies of the devices, see @ref LP50XX_Retry.h
+ *
+ * @return int8_t 0 on success, otherwise the status of the last failed flush
+ */
+int8_t LP50XXMuxFlush::Flush() {
+    bool pending[LP50XX_MUX_MAX_DEVICES];
+    uint8_t remaining = 0;
+    for (uint8_t i = 0; i < _device_count; i++) {
+        pending[i] = _devices[i]->GetDirtyMask() != 0;
+        remaining += pending[i];
+        _devices[i]->GetRetryPolicy().BeginFrame();
+    }
+
+    int8_t result = 0;
+    while (remaining > 0) {
+        // Continue on a multiplexer that is switched already, otherwise take the first pending device
+        LP50XXMux *mux = NULL;
+        for (uint8_t i = 0; i < _device_count && mux == NULL; i++) {
+            if (pending[i] && _channels[i]->GetMux().GetSelected() != 0) {
+                mux = &_channels[i]->GetMux();
+            }
+        }
+        for (uint8_t i = 0; i < _device_count && mux == NULL; i++) {
+            if (pending[i]) {
+                mux = &_channels[i]->GetMux();
+            }
+        }
+
+        // Keep the enabled channels, then add the channels of pending devices that do not conflict
+        uint8_t selected = 0;
+        for (uint8_t i = 0; i < _device_count; i++) {
+            if (pending[i] && &_channels[i]->GetMux() == mux && (mux->GetSelected() & _channels[i]->GetChannels()) == _channels[i]->GetChannels()) {
+                selected = mux->GetSelected();
+                break;
+            }
+        }
+        for (uint8_t i = 0; i < _device_count; i++) {
+            uint8_t channels = _channels[i]->GetChannels();
+            if (pending[i] && &_channels[i]->GetMux() == mux && (selected & channels) != channels &&
+                (selected == 0 || !conflicts(selected, *mux, channels))) {
+                selected |= channels;
+            }
+        }
+
+        int8_t status = mux->Select(selected);
+        if (status != 0) {
+            result = status;
+        }
+
+        for (uint8_t i = 0; i < _device_count; i++) {
+            uint8_t channels = _channels[i]->GetChannels();
+            if (pending[i] && &_channels[i]->GetMux() == mux && (selected & channels) == channels) {
+                status = _devices[i]->Flush();
+                if (status != 0) {
+                    result = status;
+                }
+                pending[i] = false;
+                remaining--;
+            }
+        }
+    }
+    return result;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Checks whether enabling additional channels exposes two devices at the same address
+ *
+ * @param selected The channels that will be enabled anyway
+ * @param mux The multiplexer
+ * @param channels The additional channels
+ * @return true when a device behind the additional channels shares its address with a device behind the selected channels
+ */
+bool LP50XXMuxFlush::conflicts(uint8_t selected, LP50XXMux &mux, uint8_t channels) {
+    for (uint8_t i = 0; i < _device_count; i++) {
+        if (&_channels[i]->GetMux() != &mux || !(_channels[i]->GetChannels() & channels & ~selected)) {
+            continue;
+        }
+        for (uint8_t j = 0; j < _device_count; j++) {
+            if (j != i && &_channels[j]->GetMux() == &mux && (_channels[j]->GetChannels() & selected) &&
+                _devices[j]->GetI2CAddress() == _devices[i]->GetI2CAddress()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file LP50XX_Mux.h
+ * @brief Support for devices behind TCA9548A/PCA9548A style I2C multiplexers
+ *
+ * An @ref LP50XXMux is one multiplexer on a bus, an @ref LP50XXMuxChannel is a transport for the devices behind
+ * one or more of its channels. The multiplexer caches its control register, a channel is only switched when the
+ * cached state does not already reach the device. Selecting a channel of one multiplexer disables all other
+ * multiplexers on the same bus, so all four device addresses can be used behind every channel.
+ *
+ * @ref LP50XXMuxFlush flushes devices behind multiplexers with as few channel switches as possible: clean devices
+ * are skipped, the currently selected channels are flushed first, every multiplexer is visited once and channels
+ * without conflicting device addresses are enabled together.
+ *
+ * @code
+ * LP50XXMux mux(0x70);
+ * LP50XXMuxChannel channel0(mux, 1 << 0);
+ * LP50XXMuxChannel channel1(mux, 1 << 1);
+ *
+ * flusher.Add(device, channel0);   // Sets the transport of the device
+ * flusher.Add(device2, channel1);
+ * device.Begin(0x14);
+ * device2.Begin(0x14);
+ * @endcode
+ *
+ * @note All devices behind the multiplexers have to be known to the flusher, otherwise channels may be enabled
+ * together although an unknown device shares an address.
+ */
+#ifndef __LP50XX_MUX_H
+#define __LP50XX_MUX_H
+
+#include "LP50XX.h"
+
+#define LP50XX_MUX_DEFAULT_ADDRESS 0x70
+#ifndef LP50XX_MUX_MAX_DEVICES
+#define LP50XX_MUX_MAX_DEVICES 32
+#endif
+
+/**
+ * @brief One multiplexer with a cached control register
+ */
+class LP50XXMux
+{
+    public:
+        LP50XXMux(uint8_t address = LP50XX_MUX_DEFAULT_ADDRESS, LP50XXTransport *upstream = NULL);
+        ~LP50XXMux();
+
+        int8_t Begin();
+        int8_t Select(uint8_t channels);
+        uint8_t GetSelected();
+        LP50XXTransport *GetUpstream();
+
+        uint32_t GetSwitchCount();
+        void ResetSwitchCount();
+
+    private:
+        friend class LP50XXMuxChannel;
+
+        uint8_t             _address;
+        LP50XXTransport    *_upstream;
+        uint8_t             _selected = 0;
+        bool                _known = false;     // The control register is unknown until the first write
+        uint32_t            _switches = 0;
+
+        LP50XXMux          *_next;              // All multiplexers, to disable the others on the same bus
+        static LP50XXMux   *_first;
+
+        int8_t writeControl(uint8_t channels);
+        int8_t upstreamWrite(uint8_t address, uint8_t reg, const uint8_t *pdata, uint32_t count);
+        int8_t upstreamRead(uint8_t address, uint8_t reg, uint8_t *pdata, uint32_t count);
+};
+
+/**
+ * @brief Transport for the devices behind one or more channels of a multiplexer
+ */
+class LP50XXMuxChannel : public LP50XXTransport
+{
+    public:
+        LP50XXMuxChannel(LP50XXMux &mux, uint8_t channels);
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count);
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count);
+        int8_t Probe(uint8_t deviceAddress);
+        void BeginBatch();
+        int8_t EndBatch();
+
+        LP50XXMux &GetMux();
+        uint8_t GetChannels();
+
+    private:
+        LP50XXMux  &_mux;
+        uint8_t     _channels;
+
+        int8_t select(uint8_t deviceAddress);
+};
+
+/**
+ * @brief Flushes devices behind multiplexers in an order that minimizes the channel switches
+ */
+class LP50XXMuxFlush
+{
+    public:
+        LP50XXMuxFlush();
+
+        bool Add(LP50XX &device, LP50XXMuxChannel &channel);
+        int8_t Flush();
+
+    private:
+        LP50XX             *_devices[LP50XX_MUX_MAX_DEVICES];
+        LP50XXMuxChannel   *_channels[LP50XX_MUX_MAX_DEVICES];
+        uint8_t             _device_count = 0;
+
+        bool conflicts(uint8_t selected, LP50XXMux &mux, uint8_t channels);
+};
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file LP50XX_Platform.cpp
+ * @brief Platform functions for builds outside of Arduino, see @ref LP50XX_Platform.h
+ */
+#include "LP50XX_Platform.h"
+
+#if !defined(ARDUINO) && defined(__linux__)
+#include <time.h>
+
+__attribute__((weak)) void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+__attribute__((weak)) void digitalWrite(uint8_t pin, uint8_t value) {
+    (void)pin;
+    (void)value;
+}
+
+__attribute__((weak)) int digitalRead(uint8_t pin) {
+    (void)pin;
+    return HIGH;
+}
+
+static void sleepMicroseconds(unsigned long us) {
+    struct timespec ts;
+    ts.tv_sec = us / 1000000UL;
+    ts.tv_nsec = (us % 1000000UL) * 1000UL;
+    while (nanosleep(&ts, &ts) != 0) {
+        // Interrupted by a signal, sleep the remaining time
+    }
+}
+
+void delay(unsigned long ms) {
+    sleepMicroseconds(ms * 1000UL);
+}
+
+void delayMicroseconds(unsigned int us) {
+    sleepMicroseconds(us);
+}
+
+unsigned long millis() {
+    return micros() / 1000UL;
+}
+
+unsigned long micros() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long)ts.tv_sec * 1000000UL + ts.tv_nsec / 1000UL;
+}
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file LP50XX_Platform.h
+ * @brief Contains the platform functions used by the library
+ *
+ * On Arduino these are provided by the core. On other platforms (e.g. Linux) the timing functions are provided by
+ * LP50XX_Platform.cpp, the GPIO functions default to no-ops and can be overridden by the developer
+ */
+#ifndef _LP50XX_PLATFORM_H_
+#define _LP50XX_PLATFORM_H_
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+
+/** @brief pinMode() definition.\n
+ * To be implemented by the developer, defaults to a no-op
+ */
+void pinMode(uint8_t pin, uint8_t mode);
+/** @brief digitalWrite() definition.\n
+ * To be implemented by the developer, defaults to a no-op
+ */
+void digitalWrite(uint8_t pin, uint8_t value);
+/** @brief digitalRead() definition.\n
+ * To be implemented by the developer, defaults to HIGH
+ */
+int digitalRead(uint8_t pin);
+/** @brief delay() definition.\n
+ * 
+ */
+void delay(unsigned long ms);
+/** @brief delayMicroseconds() definition.\n
+ * 
+ */
+void delayMicroseconds(unsigned int us);
+/** @brief millis() definition.\n
+ * 
+ */
+unsigned long millis();
+/** @brief micros() definition.\n
+ * 
+ */
+unsigned long micros();
+#endif
+
+#endif
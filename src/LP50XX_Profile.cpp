@@ -0,0 +1,199 @@
+/**
+ * @file LP50XX_Profile.cpp
+ * @brief Contains the profile statistics, see @ref LP50XX_Profile.h
+ */
+#include "LP50XX_Profile.h"
+
+#if LP50XX_PROFILE
+
+#include <stdio.h>
+#ifdef LP50XX_PROFILE_TSC
+#include <time.h>
+#endif
+
+LP50XXProfileStats LP50XXProfile::_stats[ProfileSiteCount];
+uint32_t LP50XXProfile::_frequency = 0;
+uint32_t LP50XXProfile::_overhead = 0;
+
+#ifdef ARDUINO
+LP50XXProfileScope *LP50XXProfileScope::_current = NULL;
+#else
+thread_local LP50XXProfileScope *LP50XXProfileScope::_current = NULL;
+#endif
+
+static const char *const siteNames[ProfileSiteCount] = {
+    "SetLEDColor",
+    "SetOutputColor",
+    "StageLEDColor",
+    "Flush",
+    "Chain Flush",
+    "Bus write",
+    "Bus read",
+    "I2C write",
+    "I2C read"
+};
+
+/**
+ * @brief Starts the cycle counter where it has to be enabled, measures its frequency and resets the statistics
+ */
+void LP50XXProfile::Begin() {
+#if defined(LP50XX_PROFILE_DWT)
+    *(volatile uint32_t *)0xE000EDFC |= 1UL << 24;     // CoreDebug DEMCR TRCENA
+    *(volatile uint32_t *)0xE0001004 = 0;               // DWT_CYCCNT
+    *(volatile uint32_t *)0xE0001000 |= 1;              // DWT_CTRL CYCCNTENA
+#endif
+    _frequency = measureFrequency();
+
+    // Smallest difference of two consecutive counter reads
+    _overhead = 0xFFFFFFFF;
+    for (uint8_t i = 0; i < 64; i++) {
+        uint32_t start = GetCounter();
+        uint32_t elapsed = GetCounter() - start;
+        if (elapsed < _overhead) {
+            _overhead = elapsed;
+        }
+    }
+    Reset();
+}
+
+/**
+ * @brief Resets the statistics of all sites
+ */
+void LP50XXProfile::Reset() {
+    memset(_stats, 0, sizeof(_stats));
+}
+
+/**
+ * @brief Copies the statistics of a site
+ *
+ * @param site The @ref EProfileSite
+ * @param stats The copy, all zero for an unknown site
+ */
+void LP50XXProfile::Get(uint8_t site, LP50XXProfileStats *stats) {
+    if (site >= ProfileSiteCount) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = _stats[site];
+}
+
+/**
+ * @brief Returns the name of a site for reports
+ *
+ * @param site The @ref EProfileSite
+ * @return const char* The name, "?" for an unknown site
+ */
+const char *LP50XXProfile::GetSiteName(uint8_t site) {
+    return site < ProfileSiteCount ? siteNames[site] : "?";
+}
+
+/**
+ * @brief Returns the ticks of the counter per second, measured by @ref Begin on computers with a time stamp counter
+ *
+ * @return uint32_t The frequency in Hz
+ */
+uint32_t LP50XXProfile::GetFrequency() {
+    return _frequency;
+}
+
+/**
+ * @brief Returns the ticks between two consecutive counter reads, measured by @ref Begin. Every measurement
+ * contains it at least once
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXProfile::GetOverhead() {
+    return _overhead;
+}
+
+/**
+ * @brief Adds a measurement to a site, called by @ref LP50XXProfileScope
+ *
+ * @param site The @ref EProfileSite
+ * @param elapsed The ticks from the start to the end of the site
+ * @param self The ticks not spent in the sites called
+ */
+void LP50XXProfile::Record(uint8_t site, uint32_t elapsed, uint32_t self) {
+    LP50XXProfileStats &stats = _stats[site];
+    if (stats.count == 0 || elapsed < stats.min) {
+        stats.min = elapsed;
+    }
+    if (elapsed > stats.max) {
+        stats.max = elapsed;
+    }
+    stats.count++;
+    stats.total += elapsed;
+    stats.self += self;
+}
+
+/**
+ * @brief Prints a table of all sites that were reached: count, min, mean and max in ticks and the mean self time
+ *
+ * @param out The output, e.g. Serial
+ */
+#ifdef ARDUINO
+void LP50XXProfile::Report(Print &out) {
+#else
+void LP50XXProfile::Report(FILE *out) {
+#endif
+    char line[80];
+    for (uint8_t header = 0; header < 2; header++) {
+        if (header == 0) {
+            snprintf(line, sizeof(line), "LP50XX profile: %lu ticks/s, overhead %lu\r\n", (unsigned long)_frequency,
+                     (unsigned long)_overhead);
+        } else {
+            snprintf(line, sizeof(line), "%-16s%8s%10s%10s%10s%10s\r\n", "site", "count", "min", "mean", "max", "self");
+        }
+#ifdef ARDUINO
+        out.print(line);
+#else
+        fputs(line, out);
+#endif
+    }
+    for (uint8_t site = 0; site < ProfileSiteCount; site++) {
+        const LP50XXProfileStats &stats = _stats[site];
+        if (stats.count == 0) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "%-16s%8lu%10lu%10lu%10lu%10lu\r\n", siteNames[site], (unsigned long)stats.count,
+                 (unsigned long)stats.min, (unsigned long)(stats.total / stats.count), (unsigned long)stats.max,
+                 (unsigned long)(stats.self / stats.count));
+#ifdef ARDUINO
+        out.print(line);
+#else
+        fputs(line, out);
+#endif
+    }
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Returns the frequency of the counter
+ *
+ * @return uint32_t The frequency in Hz
+ */
+uint32_t LP50XXProfile::measureFrequency() {
+#if defined(LP50XX_PROFILE_DWT) || defined(LP50XX_PROFILE_CCOUNT)
+    return F_CPU;
+#elif defined(LP50XX_PROFILE_TSC)
+    // The time stamp counter runs at a constant rate, count it for 20 ms of the monotonic clock
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t ticks = __rdtsc();
+    uint64_t elapsedNs;
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsedNs = (uint64_t)(now.tv_sec - start.tv_sec) * 1000000000ULL + now.tv_nsec - start.tv_nsec;
+    } while (elapsedNs < 20000000ULL);
+    return (__rdtsc() - ticks) * 1000000000ULL / elapsedNs;
+#elif defined(LP50XX_PROFILE_CLOCK)
+    return 1000000000UL;
+#else
+    return 1000000UL;
+#endif
+}
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @file LP50XX_Profile.h
+ * @brief Scoped profiling of the driver hot paths with a cycle counter
+ *
+ * With LP50XX_PROFILE set to 1 the hot paths of @ref LP50XX, @ref LP50XXChain and the I2C layer measure their
+ * duration and aggregate count, min, mean and max per site. Every measurement also knows the time spent in the
+ * sites it called, so the self time of @ref ProfileFlush is the CPU time of the driver and @ref ProfileI2CWrite
+ * is the time waiting on the bus. Without LP50XX_PROFILE the hooks compile to nothing.
+ *
+ * The counter is the DWT cycle counter on Cortex-M3 and up, the CCOUNT register on the ESP32, the time stamp
+ * counter on x86 computers, clock_gettime() in ns on other computers and micros() everywhere else, see
+ * @ref LP50XXProfile::GetFrequency. The statistics are not synchronized, profile from one thread or task at a time.
+ *
+ * @code
+ * LP50XXProfile::Begin();
+ * // ... run frames
+ * LP50XXProfile::Report(Serial);
+ * @endcode
+ */
+#ifndef __LP50XX_PROFILE_H
+#define __LP50XX_PROFILE_H
+
+#include "LP50XX_Platform.h"
+#ifndef ARDUINO
+#include <stdio.h>
+#endif
+
+#ifndef LP50XX_PROFILE
+#define LP50XX_PROFILE 0                // 1 to measure the driver hot paths
+#endif
+
+#if defined(ARDUINO) && defined(__arm__) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__))
+#define LP50XX_PROFILE_DWT
+#elif defined(__XTENSA__)
+#define LP50XX_PROFILE_CCOUNT
+#elif !defined(ARDUINO) && (defined(__x86_64__) || defined(__i386__))
+#define LP50XX_PROFILE_TSC
+#include <x86intrin.h>
+#elif !defined(ARDUINO) && defined(__linux__)
+#define LP50XX_PROFILE_CLOCK
+#include <time.h>
+#endif
+
+#if LP50XX_PROFILE
+#define LP50XX_PROFILE_SCOPE(site) LP50XXProfileScope lp50xxProfileScope(site)
+#else
+#define LP50XX_PROFILE_SCOPE(site) do { } while (0)
+#endif
+
+enum EProfileSite {
+    ProfileSetLEDColor,
+    ProfileSetOutputColor,
+    ProfileStageLEDColor,
+    ProfileFlush,
+    ProfileChainFlush,
+    ProfileBusWrite,            // Driver side of a register write, including the I2C layer
+    ProfileBusRead,
+    ProfileI2CWrite,            // I2C functions and transports, the time on the bus
+    ProfileI2CRead,
+    ProfileSiteCount
+};
+
+/**
+ * @brief Aggregated measurements of one site, in counter ticks
+ */
+struct LP50XXProfileStats {
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    total;          // Including the sites called
+    uint64_t    self;           // Excluding the sites called
+};
+
+/**
+ * @brief The global profile
+ */
+class LP50XXProfile
+{
+    public:
+        static void Begin();
+        static void Reset();
+        static void Get(uint8_t site, LP50XXProfileStats *stats);
+        static const char *GetSiteName(uint8_t site);
+        static uint32_t GetFrequency();
+        static uint32_t GetOverhead();
+#ifdef ARDUINO
+        static void Report(Print &out);
+#else
+        static void Report(FILE *out);
+#endif
+        static void Record(uint8_t site, uint32_t elapsed, uint32_t self);
+
+        /**
+         * @brief Returns the counter, it wraps
+         *
+         * @return uint32_t The counter in ticks of @ref GetFrequency
+         */
+        static inline uint32_t GetCounter() {
+#if defined(LP50XX_PROFILE_DWT)
+            return *(volatile uint32_t *)0xE0001004;   // DWT_CYCCNT
+#elif defined(LP50XX_PROFILE_CCOUNT)
+            uint32_t count;
+            __asm__ __volatile__("rsr %0, ccount" : "=a"(count));
+            return count;
+#elif defined(LP50XX_PROFILE_TSC)
+            return (uint32_t)__rdtsc();
+#elif defined(LP50XX_PROFILE_CLOCK)
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return (uint32_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+#else
+            return micros();
+#endif
+        }
+
+    private:
+        static LP50XXProfileStats   _stats[ProfileSiteCount];
+        static uint32_t             _frequency;
+        static uint32_t             _overhead;
+
+        static uint32_t measureFrequency();
+};
+
+/**
+ * @brief Measures a site from its construction to the end of its scope, see @ref LP50XX_PROFILE_SCOPE
+ */
+class LP50XXProfileScope
+{
+    public:
+        /**
+         * @brief Starts the measurement
+         *
+         * @param site The @ref EProfileSite
+         */
+        inline LP50XXProfileScope(uint8_t site) : _site(site), _nested(0), _parent(_current) {
+            _current = this;
+            _start = LP50XXProfile::GetCounter();
+        }
+
+        /**
+         * @brief Ends the measurement and adds it to the nested time of the enclosing scope
+         */
+        inline ~LP50XXProfileScope() {
+            uint32_t elapsed = LP50XXProfile::GetCounter() - _start;
+            LP50XXProfile::Record(_site, elapsed, elapsed - _nested);
+            if (_parent != NULL) {
+                _parent->_nested += elapsed;
+            }
+            _current = _parent;
+        }
+
+    private:
+        uint8_t                 _site;
+        uint32_t                _start;
+        uint32_t                _nested;        // Time of the scopes opened inside this one
+        LP50XXProfileScope     *_parent;
+
+#ifdef ARDUINO
+        static LP50XXProfileScope *_current;
+#else
+        static thread_local LP50XXProfileScope *_current;
+#endif
+};
+
+#endif
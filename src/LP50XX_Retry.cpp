@@ -0,0 +1,165 @@
+/**
+ * @file LP50XX_Retry.cpp
+ * @brief Contains the retry policy, see @ref LP50XX_Retry.h
+ */
+#include "LP50XX_Retry.h"
+#include "LP50XX_Platform.h"
+
+/**
+ * @brief Instantiates the policy
+ *
+ * @param maxAttempts The attempts per transaction including the first one, 0 is handled like 1
+ * @param backoffUs The wait before the second attempt
+ * @param frameBudgetUs The time the repeats of a frame may take, 0 for no limit
+ */
+LP50XXRetryPolicy::LP50XXRetryPolicy(uint8_t maxAttempts, uint16_t backoffUs, uint32_t frameBudgetUs) {
+    SetMaxAttempts(maxAttempts);
+    _backoff_us = backoffUs;
+    _frame_budget_us = frameBudgetUs;
+    _budget_used_us = 0;
+    ResetCounters();
+}
+
+/*----------------------- Configuration functions ---------------------------*/
+
+/**
+ * @brief Sets the attempts per transaction
+ *
+ * @param attempts The attempts including the first one, 0 is handled like 1
+ */
+void LP50XXRetryPolicy::SetMaxAttempts(uint8_t attempts) {
+    _max_attempts = attempts != 0 ? attempts : 1;
+}
+
+/**
+ * @brief Returns the attempts per transaction
+ *
+ * @return uint8_t The attempts including the first one
+ */
+uint8_t LP50XXRetryPolicy::GetMaxAttempts() {
+    return _max_attempts;
+}
+
+/**
+ * @brief Sets the wait before the second attempt, every further attempt waits twice as long as the one before
+ *
+ * @param backoffUs The wait in us
+ */
+void LP50XXRetryPolicy::SetBackoff(uint16_t backoffUs) {
+    _backoff_us = backoffUs;
+}
+
+/**
+ * @brief Returns the wait before the second attempt
+ *
+ * @return uint16_t The wait in us
+ */
+uint16_t LP50XXRetryPolicy::GetBackoff() {
+    return _backoff_us;
+}
+
+/**
+ * @brief Sets the time the repeats of a frame may take, including their backoff
+ *
+ * @param budgetUs The budget in us, 0 for no limit
+ */
+void LP50XXRetryPolicy::SetFrameBudget(uint32_t budgetUs) {
+    _frame_budget_us = budgetUs;
+}
+
+/**
+ * @brief Returns the time the repeats of a frame may take
+ *
+ * @return uint32_t The budget in us, 0 for no limit
+ */
+uint32_t LP50XXRetryPolicy::GetFrameBudget() {
+    return _frame_budget_us;
+}
+
+/*----------------------- Retry functions -----------------------------------*/
+
+/**
+ * @brief Starts a frame, the repeats of the frame get the full budget again
+ */
+void LP50XXRetryPolicy::BeginFrame() {
+    _budget_used_us = 0;
+}
+
+/**
+ * @brief Returns the time of the repeats since @ref BeginFrame
+ *
+ * @return uint32_t The used budget in us
+ */
+uint32_t LP50XXRetryPolicy::GetBudgetUsed() {
+    return _budget_used_us;
+}
+
+/**
+ * @brief Decides whether a failed transaction is repeated and waits the backoff before the repeat.
+ * A transaction that is too long is never repeated. A repeat is charged with its backoff and the time of the
+ * failed attempt, it is only made when that still fits in the budget of the frame
+ *
+ * @param status The status of the attempt, 0 on success
+ * @param attempt The number of the attempt, 1 for the first one
+ * @param elapsedUs The time the attempt took
+ * @return true when the transaction has to be repeated, false on success or when the policy gives up
+ */
+bool LP50XXRetryPolicy::Retry(int8_t status, uint8_t attempt, uint32_t elapsedUs) {
+    if (status == 0) {
+        return false;
+    }
+
+    uint32_t backoff = (uint32_t)_backoff_us << (attempt > 16 ? 15 : attempt - 1);
+    if (status == 1 || attempt >= _max_attempts ||
+        (_frame_budget_us != 0 && _budget_used_us + backoff + elapsedUs > _frame_budget_us)) {
+        _failures++;
+        return false;
+    }
+
+    _budget_used_us += backoff + elapsedUs;
+    _retries++;
+    if (backoff >= 1000) {
+        delay(backoff / 1000);
+    }
+    if (backoff % 1000 != 0) {
+        delayMicroseconds(backoff % 1000);
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the repeated transactions since construction or @ref ResetCounters
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXRetryPolicy::GetRetries() {
+    return _retries;
+}
+
+/**
+ * @brief Returns the transactions the policy gave up on since construction or @ref ResetCounters
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXRetryPolicy::GetFailures() {
+    return _failures;
+}
+
+/**
+ * @brief Resets the counters of repeats and failures
+ */
+void LP50XXRetryPolicy::ResetCounters() {
+    _retries = 0;
+    _failures = 0;
+}
+
+/**
+ * @brief Returns the policy of the I2C functions of @ref I2C_coms.h, transports copy it when they are constructed
+ *
+ * @return LP50XXRetryPolicy& The policy, a single attempt unless it is changed
+ */
+LP50XXRetryPolicy &LP50XXRetryPolicy::Default() {
+    // Constructed on first use, transports that are static objects themselves copy it during static initialization
+    static LP50XXRetryPolicy policy;
+    return policy;
+}
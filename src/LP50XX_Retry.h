@@ -0,0 +1,63 @@
+/**
+ * @file LP50XX_Retry.h
+ * @brief Bounded retries of failed bus transactions
+ *
+ * A failed write or read of @ref LP50XX is repeated up to the maximum number of attempts of the policy of its
+ * transport, see @ref LP50XXTransport::SetRetryPolicy. Before every repeat the policy waits the backoff, doubled
+ * for each further attempt. The repeats of a frame share a time budget, so a device that keeps failing cannot
+ * delay the other devices of a chain past the frame deadline. Registers that still fail stay dirty in the shadow
+ * image and are written again by the next @ref LP50XX::Flush.
+ *
+ * A frame starts with @ref LP50XXRetryPolicy::BeginFrame. @ref LP50XXChain::Flush, @ref LP50XXMuxFlush::Flush,
+ * @ref LP50XXMultiBusFlush and lp50xx_flush_all() start it for the policies of their devices, an application that
+ * flushes single devices calls it once per frame.
+ *
+ * @code
+ * LP50XXRetryPolicy retry(3, 100, 2000); // 3 attempts, 100 us then 200 us apart, at most 2 ms of repeats per frame
+ * transport.SetRetryPolicy(&retry);
+ * @endcode
+ *
+ * Every transport has its own policy, a copy of @ref LP50XXRetryPolicy::Default made when the transport is
+ * constructed, so the buses never share a frame budget. Default itself is the policy of the devices without a
+ * transport, it makes a single attempt like the driver without a policy.
+ */
+#ifndef __LP50XX_RETRY_H
+#define __LP50XX_RETRY_H
+
+#include <stdint.h>
+
+/**
+ * @brief Retry policy of one bus
+ */
+class LP50XXRetryPolicy
+{
+    public:
+        LP50XXRetryPolicy(uint8_t maxAttempts = 1, uint16_t backoffUs = 0, uint32_t frameBudgetUs = 0);
+
+        void SetMaxAttempts(uint8_t attempts);
+        uint8_t GetMaxAttempts();
+        void SetBackoff(uint16_t backoffUs);
+        uint16_t GetBackoff();
+        void SetFrameBudget(uint32_t budgetUs);
+        uint32_t GetFrameBudget();
+
+        void BeginFrame();
+        uint32_t GetBudgetUsed();
+        bool Retry(int8_t status, uint8_t attempt, uint32_t elapsedUs);
+
+        uint32_t GetRetries();
+        uint32_t GetFailures();
+        void ResetCounters();
+
+        static LP50XXRetryPolicy &Default();
+
+    private:
+        uint8_t     _max_attempts;
+        uint16_t    _backoff_us;
+        uint32_t    _frame_budget_us;   // 0 for no limit
+        uint32_t    _budget_used_us;    // Backoff and repeated transactions since BeginFrame()
+        uint32_t    _retries;
+        uint32_t    _failures;
+};
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file LP50XX_Serial.cpp
+ * @brief Receiver for the serial protocol, see @ref LP50XX_Serial.h for the format
+ */
+#include "LP50XX_Serial.h"
+#include "LP50XX.h"
+
+enum ESerialState {
+    StateSync,
+    StateDevice,
+    StateRegister,
+    StateLength,
+    StatePayload,
+    StateCRC
+};
+
+/**
+ * @brief This function instantiates the receiver
+ *
+ * @param devices The devices to stage into, the device index of a packet selects devices[index]
+ * @param deviceCount The number of devices
+ */
+LP50XXSerialReceiver::LP50XXSerialReceiver(LP50XX **devices, uint8_t deviceCount) {
+    _devices = devices;
+    _device_count = deviceCount;
+
+    Reset();
+}
+
+/**
+ * @brief Resets the receiver, the next byte is expected to be a sync byte
+ */
+void LP50XXSerialReceiver::Reset() {
+    _state = StateSync;
+    _device = 0;
+    _register = 0;
+    _length = 0;
+    _index = 0;
+    _crc = 0;
+    _frame_error = false;
+}
+
+/**
+ * @brief Feeds the next received byte. The payload is staged with @ref LP50XX::StageRegister once the CRC of the packet matches
+ *
+ * @param data The received byte
+ * @return ESerialStatus @ref SerialFrameComplete or @ref SerialFrameError when the last packet of a frame is received
+ */
+ESerialStatus LP50XXSerialReceiver::Feed(uint8_t data) {
+    switch (_state)
+    {
+    case StateSync:
+        if (data == LP50XX_SERIAL_SYNC) {
+            _crc = 0;
+            _state = StateDevice;
+        }
+        return SerialBusy;
+    case StateDevice:
+        _device = data;
+        _state = StateRegister;
+        break;
+    case StateRegister:
+        _register = data;
+        _state = StateLength;
+        break;
+    case StateLength:
+        _length = data;
+        _index = 0;
+        _state = StatePayload;
+        if ((_device & ~LP50XX_SERIAL_END_OF_FRAME) >= _device_count || _length == 0 ||
+            _register + _length > LP50XX_SERIAL_MAX_PAYLOAD) {
+            // The header is corrupt, so the length can not be trusted. Resynchronize on the next sync byte
+            failPacket();
+            _state = StateSync;
+            return SerialBusy;
+        }
+        break;
+    case StatePayload:
+        _payload[_index] = data;
+        if (++_index == _length) {
+            _state = StateCRC;
+        }
+        break;
+    case StateCRC:
+        _state = StateSync;
+        if (data != _crc) {
+            failPacket();
+            return SerialBusy;
+        }
+        for (uint8_t i = 0; i < _length; i++) {
+            _devices[_device & ~LP50XX_SERIAL_END_OF_FRAME]->StageRegister(_register + i, _payload[i]);
+        }
+        if (!(_device & LP50XX_SERIAL_END_OF_FRAME)) {
+            return SerialPacket;
+        }
+        if (_frame_error) {
+            _frame_error = false;
+            return SerialFrameError;
+        }
+        return SerialFrameComplete;
+    }
+
+    _crc = LP50XXSerialEncoder::CRC8(_crc, data);
+    return SerialBusy;
+}
+
+/**
+ * @brief Flushes all devices
+ *
+ * @return int8_t 0 on success, otherwise the status of the last failed flush
+ */
+int8_t LP50XXSerialReceiver::FlushFrame() {
+    int8_t result = 0;
+    for (uint8_t i = 0; i < _device_count; i++) {
+        int8_t status = _devices[i]->Flush();
+        if (status != 0) {
+            result = status;
+        }
+    }
+    return result;
+}
+
+#ifdef ARDUINO
+/**
+ * @brief Processes all bytes available on the stream. Completed frames are flushed and answered with an ACK or NAK
+ *
+ * @param stream The stream to receive from and answer to, e.g. Serial
+ * @return uint8_t The number of frames that were flushed
+ */
+uint8_t LP50XXSerialReceiver::Poll(Stream &stream) {
+    uint8_t frames = 0;
+    while (stream.available() > 0) {
+        ESerialStatus status = Feed(stream.read());
+        if (status == SerialFrameComplete) {
+            stream.write(FlushFrame() == 0 ? LP50XX_SERIAL_ACK : LP50XX_SERIAL_NAK);
+            frames++;
+        } else if (status == SerialFrameError) {
+            stream.write(LP50XX_SERIAL_NAK);
+        }
+    }
+    return frames;
+}
+#endif
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Marks the frame of a corrupt packet as failed. A corrupt last packet ends the frame without an answer, the
+ * host resends it after its timeout, so the error must not carry over into the resend
+ */
+void LP50XXSerialReceiver::failPacket() {
+    _frame_error = !(_device & LP50XX_SERIAL_END_OF_FRAME);
+}
\ No newline at end of file
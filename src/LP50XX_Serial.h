@@ -0,0 +1,89 @@
+/**
+ * @file LP50XX_Serial.h
+ * @brief Framed binary protocol to stream register data from a computer over a serial port
+ *
+ * Packet layout:
+ *
+ * | Byte   | Meaning                                                                   |
+ * |--------|---------------------------------------------------------------------------|
+ * | 0      | Sync byte @ref LP50XX_SERIAL_SYNC                                         |
+ * | 1      | Device index (bit 0..6), bit 7 set on the last packet of a frame          |
+ * | 2      | First register                                                            |
+ * | 3      | Payload length, 1..@ref LP50XX_SERIAL_MAX_PAYLOAD                         |
+ * | 4..n   | Payload, written to the registers starting at the first register          |
+ * | n + 1  | CRC-8 (polynomial 0x07) over byte 1..n                                    |
+ *
+ * The receiver buffers the payload of a packet and only stages it in the shadow image of the device when the CRC
+ * matches, so a corrupt header can never stage values into another device or register.
+ * After the last packet of a frame all devices are flushed and the receiver answers with @ref LP50XX_SERIAL_ACK.
+ * The host may only send the next frame after the ACK, so the serial receive buffer can never overrun.
+ * A frame with a corrupt packet or a failed flush is answered with @ref LP50XX_SERIAL_NAK and the host resends the whole frame.
+ * When the last packet itself is lost or corrupt the receiver does not answer at all, the host resends the frame after
+ * a timeout and the resend starts without the error.
+ */
+#ifndef __LP50XX_SERIAL_H
+#define __LP50XX_SERIAL_H
+
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+#define LP50XX_SERIAL_SYNC 0xA5
+#define LP50XX_SERIAL_ACK 0x06
+#define LP50XX_SERIAL_NAK 0x15
+#define LP50XX_SERIAL_END_OF_FRAME 0x80
+#define LP50XX_SERIAL_MAX_PAYLOAD 0x17      // Equal to the size of the shadow image @ref LP50XX_REGISTER_COUNT
+#define LP50XX_SERIAL_OVERHEAD 5            // Sync, device, register, length and CRC bytes
+
+class LP50XX;
+
+enum ESerialStatus {
+    SerialBusy,             // More bytes are needed to complete the packet
+    SerialPacket,           // A packet is staged
+    SerialFrameComplete,    // The last packet of a frame is staged, the devices can be flushed
+    SerialFrameError        // The last packet of a frame is received, but the frame contained a corrupt or invalid packet
+};
+
+/**
+ * @brief Receiver for the serial protocol that stages valid packets in the shadow image of the devices
+ */
+class LP50XXSerialReceiver
+{
+    public:
+        LP50XXSerialReceiver(LP50XX **devices, uint8_t deviceCount);
+
+        void Reset();
+        ESerialStatus Feed(uint8_t data);
+        int8_t FlushFrame();
+#ifdef ARDUINO
+        uint8_t Poll(Stream &stream);
+#endif
+
+    private:
+        LP50XX    **_devices;
+        uint8_t     _device_count;
+
+        uint8_t     _state;
+        uint8_t     _device;
+        uint8_t     _register;
+        uint8_t     _length;
+        uint8_t     _index;
+        uint8_t     _crc;
+        bool        _frame_error;
+        uint8_t     _payload[LP50XX_SERIAL_MAX_PAYLOAD];
+
+        void failPacket();
+};
+
+/**
+ * @brief Encoder for the serial protocol. It has no platform dependencies so it can be used by host tools as well
+ */
+class LP50XXSerialEncoder
+{
+    public:
+        static uint8_t EncodePacket(uint8_t device, uint8_t reg, const uint8_t *pdata, uint8_t count, bool endOfFrame, uint8_t *out);
+        static uint8_t CRC8(uint8_t crc, uint8_t data);
+};
+
+#endif
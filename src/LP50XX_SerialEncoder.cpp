@@ -0,0 +1,51 @@
+/**
+ * @file LP50XX_SerialEncoder.cpp
+ * @brief Encoder for the serial protocol, see @ref LP50XX_Serial.h for the format
+ *
+ * @note This file has no platform dependencies, it is shared with the host tools in extras/tools
+ */
+#include "LP50XX_Serial.h"
+
+/**
+ * @brief Encodes a single packet
+ *
+ * @param device The device index, 0..127
+ * @param reg The first register to write
+ * @param pdata The register values
+ * @param count The number of register values, 1..@ref LP50XX_SERIAL_MAX_PAYLOAD
+ * @param endOfFrame true for the last packet of a frame
+ * @param out The buffer to write to, at least count + @ref LP50XX_SERIAL_OVERHEAD bytes
+ * @return uint8_t The number of bytes written
+ */
+uint8_t LP50XXSerialEncoder::EncodePacket(uint8_t device, uint8_t reg, const uint8_t *pdata, uint8_t count, bool endOfFrame, uint8_t *out) {
+    uint8_t length = 0;
+    out[length++] = LP50XX_SERIAL_SYNC;
+    out[length++] = (device & ~LP50XX_SERIAL_END_OF_FRAME) | (endOfFrame ? LP50XX_SERIAL_END_OF_FRAME : 0);
+    out[length++] = reg;
+    out[length++] = count;
+    while (count--) {
+        out[length++] = *pdata++;
+    }
+
+    uint8_t crc = 0;
+    for (uint8_t i = 1; i < length; i++) {
+        crc = CRC8(crc, out[i]);
+    }
+    out[length++] = crc;
+    return length;
+}
+
+/**
+ * @brief Updates a CRC-8 (polynomial 0x07) with a single byte. Calculated bitwise so no table is needed in flash
+ *
+ * @param crc The current CRC, 0 at the start of a packet
+ * @param data The next byte
+ * @return uint8_t The updated CRC
+ */
+uint8_t LP50XXSerialEncoder::CRC8(uint8_t crc, uint8_t data) {
+    crc ^= data;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+    return crc;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file LP50XX_Snapshot.cpp
+ * @brief Contains the register map snapshot, see @ref LP50XX_Snapshot.h
+ */
+#include "LP50XX_Snapshot.h"
+#include "LP50XX_Serial.h"
+
+/**
+ * @brief Instantiates a snapshot with the reset values of a device of unknown variant
+ */
+LP50XXSnapshot::LP50XXSnapshot() {
+    Clear();
+}
+
+/**
+ * @brief Sets all registers to their reset value
+ *
+ * @param variant The variant of the device
+ */
+void LP50XXSnapshot::Clear(EVariant variant) {
+    _variant = variant;
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        _registers[reg] = GetResetValue(variant, reg);
+    }
+}
+
+/**
+ * @brief Returns the variant of the device the snapshot was captured from
+ *
+ * @return EVariant
+ */
+EVariant LP50XXSnapshot::GetVariant() {
+    return _variant;
+}
+
+/**
+ * @brief Returns the value of a register
+ *
+ * @param reg The register, 0x00..0x16
+ * @return uint8_t The value, 0 for registers outside the map
+ */
+uint8_t LP50XXSnapshot::GetRegister(uint8_t reg) {
+    return reg < LP50XX_REGISTER_COUNT ? _registers[reg] : 0;
+}
+
+/**
+ * @brief Sets the value of a register
+ *
+ * @param reg The register, 0x00..0x16. Registers outside the map are ignored
+ * @param value The value
+ */
+void LP50XXSnapshot::SetRegister(uint8_t reg, uint8_t value) {
+    if (reg < LP50XX_REGISTER_COUNT) {
+        _registers[reg] = value;
+    }
+}
+
+/*----------------------- Serialization functions ---------------------------*/
+
+/**
+ * @brief Stores the snapshot, only registers that differ from their reset value take a byte
+ *
+ * @param buffer The buffer, at least @ref LP50XX_SNAPSHOT_MAX_SIZE bytes
+ * @return uint8_t The length of the stored snapshot
+ */
+uint8_t LP50XXSnapshot::Serialize(uint8_t *buffer) {
+    uint32_t mask = 0;
+    uint8_t length = LP50XX_SNAPSHOT_HEADER_SIZE;
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        if (_registers[reg] != GetResetValue(_variant, reg)) {
+            mask |= 1UL << reg;
+            buffer[length++] = _registers[reg];
+        }
+    }
+
+    buffer[0] = LP50XX_SNAPSHOT_VERSION;
+    buffer[1] = _variant;
+    buffer[2] = mask;
+    buffer[3] = mask >> 8;
+    buffer[4] = mask >> 16;
+
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        crc = LP50XXSerialEncoder::CRC8(crc, buffer[i]);
+    }
+    buffer[length++] = crc;
+    return length;
+}
+
+/**
+ * @brief Loads a snapshot stored by @ref Serialize. The snapshot is not changed when the buffer is invalid
+ *
+ * @param buffer The stored snapshot
+ * @param length The length of the stored snapshot
+ * @return true when the snapshot was loaded, false for a wrong version, length or CRC
+ */
+bool LP50XXSnapshot::Deserialize(const uint8_t *buffer, uint8_t length) {
+    if (length < LP50XX_SNAPSHOT_HEADER_SIZE + 1 || buffer[0] != LP50XX_SNAPSHOT_VERSION || buffer[1] > VariantLP5012) {
+        return false;
+    }
+
+    uint32_t mask = buffer[2] | (uint32_t)buffer[3] << 8 | (uint32_t)buffer[4] << 16;
+    uint8_t count = 0;
+    for (uint8_t reg = 0; reg < 24; reg++) {
+        count += mask >> reg & 1;
+    }
+    if (mask >> LP50XX_REGISTER_COUNT != 0 || length != LP50XX_SNAPSHOT_HEADER_SIZE + count + 1) {
+        return false;
+    }
+
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length - 1; i++) {
+        crc = LP50XXSerialEncoder::CRC8(crc, buffer[i]);
+    }
+    if (crc != buffer[length - 1]) {
+        return false;
+    }
+
+    Clear((EVariant)buffer[1]);
+    const uint8_t *pdata = &buffer[LP50XX_SNAPSHOT_HEADER_SIZE];
+    for (uint8_t reg = 0; reg < LP50XX_REGISTER_COUNT; reg++) {
+        if (mask >> reg & 1) {
+            _registers[reg] = *pdata++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the value of a register after a reset of the device, as assumed by the shadow image
+ *
+ * @param variant The variant of the device, the LP5009 has no LED3_BRIGHTNESS
+ * @param reg The register
+ * @return uint8_t The reset value
+ */
+uint8_t LP50XXSnapshot::GetResetValue(EVariant variant, uint8_t reg) {
+    if (reg == DEVICE_CONFIG1) {
+        return LOG_SCALE_ON | POWER_SAVE_ON | AUTO_INC_ON | PWM_DITHERING_ON;
+    }
+    if (reg == BANK_BRIGHTNESS || (reg >= LED0_BRIGHTNESS && reg <= LED3_BRIGHTNESS)) {
+        return variant == VariantLP5009 && reg == LED3_BRIGHTNESS ? 0 : 0xFF;
+    }
+    return 0;
+}
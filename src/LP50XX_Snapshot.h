@@ -0,0 +1,59 @@
+/**
+ * @file LP50XX_Snapshot.h
+ * @brief The register map of a device as one value that can be stored and applied to another device
+ *
+ * @ref LP50XX::CaptureSnapshot reads registers 0x00..0x16 in a single burst and seeds the shadow image with them,
+ * @ref LP50XX::RestoreSnapshot writes them back in a single burst. RESET_REGISTERS is write only and not part of
+ * the map. Capture and restore only use bursts while auto increment is enabled, otherwise they read or write
+ * register by register.
+ *
+ * @ref LP50XXSnapshot::Serialize stores a snapshot in at most @ref LP50XX_SNAPSHOT_MAX_SIZE bytes, e.g. in an
+ * EEPROM: a version, the variant, a 24 bit mask of the registers that differ from their reset value, the values of
+ * those registers and a CRC-8 (see @ref LP50XXSerialEncoder::CRC8). An enabled device that only differs from its
+ * reset state in its colors takes 7 bytes plus one per set color.
+ *
+ * @code
+ * LP50XXSnapshot snapshot;
+ * device.CaptureSnapshot(snapshot);
+ * uint8_t length = snapshot.Serialize(buffer);
+ *
+ * if (snapshot.Deserialize(buffer, length)) {
+ *     device2.RestoreSnapshot(snapshot);
+ * }
+ * @endcode
+ */
+#ifndef __LP50XX_SNAPSHOT_H
+#define __LP50XX_SNAPSHOT_H
+
+#include "LP50XX.h"
+
+#define LP50XX_SNAPSHOT_VERSION 1
+#define LP50XX_SNAPSHOT_HEADER_SIZE 5       // Version, variant and the mask of the stored registers
+#define LP50XX_SNAPSHOT_MAX_SIZE (LP50XX_SNAPSHOT_HEADER_SIZE + LP50XX_REGISTER_COUNT + 1)
+
+/**
+ * @brief Register map of a device
+ */
+class LP50XXSnapshot
+{
+    public:
+        LP50XXSnapshot();
+
+        void Clear(EVariant variant = VariantUnknown);
+        EVariant GetVariant();
+        uint8_t GetRegister(uint8_t reg);
+        void SetRegister(uint8_t reg, uint8_t value);
+
+        uint8_t Serialize(uint8_t *buffer);
+        bool Deserialize(const uint8_t *buffer, uint8_t length);
+
+        static uint8_t GetResetValue(EVariant variant, uint8_t reg);
+
+    private:
+        friend class LP50XX;
+
+        EVariant    _variant;
+        uint8_t     _registers[LP50XX_REGISTER_COUNT];
+};
+
+#endif
@@ -0,0 +1,276 @@
+/**
+ * @file LP50XX_Static.h
+ * @brief Driver with the bus, I2C address, enable pin and color order fixed at compile time
+ *
+ * @ref LP50XX resolves the address, enable pin and color order from members on every call. For a fixed build
+ * LP50XXStatic takes them as template parameters: every function is inline and ends in a direct call of the
+ * bus with a constant address and register, there is no shadow image and no state besides the bus reference.
+ *
+ * @code
+ * LP50XXI2CBus bus;
+ * LP50XXStatic<LP50XXI2CBus, 0x14, 4, GRB> device(bus);
+ *
+ * void setup() {
+ *     device.Begin();
+ *     device.SetLEDColor(0, 255, 0, 0); // One 3 byte burst to 0x14, register OUT0_COLOR, already in GRB order
+ * }
+ * @endcode
+ *
+ * The bus is a transport class, e.g. @ref LP50XXWireTransport or @ref LP50XXLinuxI2C, or @ref LP50XXI2CBus for the
+ * I2C functions of @ref I2C_coms.h. Its functions are called non-virtually, so it has to be the concrete class.
+ * Use @ref LP50XX when the configuration is only known at runtime or for the buffered functions and the classes
+ * built on them. `extras/tools/lp50xx_static_bench.cpp` compares code size and time per call of both.
+ */
+#ifndef __LP50XX_STATIC_H
+#define __LP50XX_STATIC_H
+
+#include "LP50XX.h"
+#include "LP50XX_Variant.h"
+#include "I2C_coms.h"
+
+/**
+ * @brief Bus for @ref LP50XXStatic that uses the I2C functions of @ref I2C_coms.h
+ */
+class LP50XXI2CBus
+{
+    public:
+        /**
+         * @brief Writes consecutive registers with i2c_write_multi()
+         *
+         * @return int8_t 0 on success
+         */
+        LP50XX_ALWAYS_INLINE int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+            return i2c_write_multi(deviceAddress, registerAddress, (uint8_t *)pdata, count);
+        }
+
+        /**
+         * @brief Reads consecutive registers with i2c_read_multi()
+         *
+         * @return int8_t 0 on success
+         */
+        LP50XX_ALWAYS_INLINE int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+            return i2c_read_multi(deviceAddress, registerAddress, pdata, count);
+        }
+};
+
+/**
+ * @brief Driver for one LP5009 or LP5012 with a configuration fixed at compile time
+ *
+ * @tparam Bus The concrete bus class
+ * @tparam Address The I2C address of the device
+ * @tparam EnablePin The pin connected to the EN pin of the device, 0xFF without
+ * @tparam Order The order in which the LEDs are attached to the outputs, see @ref LED_Configuration
+ */
+template <class Bus, uint8_t Address = DEFAULT_ADDRESS, uint8_t EnablePin = 0xFF, LED_Configuration Order = RGB>
+class LP50XXStatic
+{
+    public:
+        /**
+         * @brief Instantiates the driver
+         *
+         * @param bus The bus the device is connected to
+         */
+        LP50XXStatic(Bus &bus) : _bus(bus) {
+
+        }
+
+        /**
+         * @brief Initializes the I2C bus when the I2C functions are used, enables the device and sets the power-on configuration
+         *
+         * @return true when the device acknowledged
+         */
+        bool Begin() {
+            if (EnablePin != 0xFF) {
+                pinMode(EnablePin, OUTPUT);
+                digitalWrite(EnablePin, HIGH);
+            }
+            if (isI2CBus()) {
+                i2c_init();
+            }
+
+            // 500 us delay after enabling the device before I2C access is available
+            delayMicroseconds(500);
+
+            if (write(Address, DEVICE_CONFIG0, 1 << 6) != 0) {
+                return false;
+            }
+            // The power-on configuration, a device that was not power cycled may have auto increment disabled
+            write(Address, DEVICE_CONFIG1, LOG_SCALE_ON | POWER_SAVE_ON | AUTO_INC_ON | PWM_DITHERING_ON);
+            return true;
+        }
+
+        /**
+         * @brief Resets the registers to their original values
+         *
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t ResetRegisters(EAddressType addressType = EAddressType::Normal) {
+            return write(address(addressType), RESET_REGISTERS, 0xFF);
+        }
+
+        /**
+         * @brief Configures the device, see @ref LP50XX::Configure
+         *
+         * @note Auto increment is always enabled, @ref SetLEDColor and @ref SetBankColor rely on it
+         *
+         * @param configuration The configuration of the device, see @ref LP50XX_Configuration
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t Configure(uint8_t configuration, EAddressType addressType = EAddressType::Normal) {
+            return write(address(addressType), DEVICE_CONFIG1, (configuration & 0x3F) | AUTO_INC_ON);
+        }
+
+        /**
+         * @brief Enables or disables BANK control for specific LEDs, see @ref LP50XX_LEDS
+         *
+         * @param leds The LEDs to include in BANK control
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetBankControl(uint8_t leds, EAddressType addressType = EAddressType::Normal) {
+            return write(address(addressType), LED_CONFIG0, leds);
+        }
+
+        /**
+         * @brief Sets the brightness level of the whole BANK
+         *
+         * @param brightness The brightness level from 0 to 0xFF
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetBankBrightness(uint8_t brightness, EAddressType addressType = EAddressType::Normal) {
+            return write(address(addressType), BANK_BRIGHTNESS, brightness);
+        }
+
+        /**
+         * @brief Sets the BANK color in the color order of the template
+         *
+         * @param r The red color value from 0 to 0xFF
+         * @param g The green color value from 0 to 0xFF
+         * @param b The blue color value from 0 to 0xFF
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetBankColor(uint8_t r, uint8_t g, uint8_t b, EAddressType addressType = EAddressType::Normal) {
+            uint8_t buff[3];
+            orderColor(r, g, b, buff);
+            return _bus.Bus::Write(address(addressType), BANK_A_COLOR, buff, 3);
+        }
+
+        /**
+         * @brief Sets the brightness level of a single LED (3 outputs)
+         *
+         * @param led The led to set. 0..3
+         * @param brightness The brightness level from 0 to 0xFF
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetLEDBrightness(uint8_t led, uint8_t brightness, EAddressType addressType = EAddressType::Normal) {
+            LP50XX_CHECK_INDEX(led, 4);
+            return write(address(addressType), LED0_BRIGHTNESS + led, brightness);
+        }
+
+        /**
+         * @brief Sets the color level of a single output
+         *
+         * @param output The output to set. 0..11
+         * @param value The color value from 0 to 0xFF
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetOutputColor(uint8_t output, uint8_t value, EAddressType addressType = EAddressType::Normal) {
+            LP50XX_CHECK_INDEX(output, 12);
+            return write(address(addressType), OUT0_COLOR + output, value);
+        }
+
+        /**
+         * @brief Sets the LED color in the color order of the template
+         *
+         * @param led The led to set. 0..3
+         * @param r The red color value from 0 to 0xFF
+         * @param g The green color value from 0 to 0xFF
+         * @param b The blue color value from 0 to 0xFF
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b, EAddressType addressType = EAddressType::Normal) {
+            LP50XX_CHECK_INDEX(led, 4);
+            uint8_t buff[3];
+            orderColor(r, g, b, buff);
+            return _bus.Bus::Write(address(addressType), OUT0_COLOR + led * 3, buff, 3);
+        }
+
+        /**
+         * @brief Writes a value to a specified register. @warning only use if you know what you're doing
+         *
+         * @param reg The register to write to
+         * @param value The value to write to the register
+         * @param addressType the I2C address type to write to
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        LP50XX_ALWAYS_INLINE int8_t WriteRegister(uint8_t reg, uint8_t value, EAddressType addressType = EAddressType::Normal) {
+            return write(address(addressType), reg, value);
+        }
+
+        /**
+         * @brief Reads a value from a specified register
+         *
+         * @param reg The register to read from
+         * @param value The buffer for the value
+         * @return int8_t 0 on success
+         */
+        LP50XX_ALWAYS_INLINE int8_t ReadRegister(uint8_t reg, uint8_t *value) {
+            return _bus.Bus::Read(Address, reg, value, 1);
+        }
+
+        /**
+         * @brief Reads consecutive registers in a single burst, auto increment has to be enabled
+         *
+         * @param reg The first register to read from
+         * @param values The buffer for the values
+         * @param count The number of registers, at most @ref LP50XX_I2C_MAX_READ
+         * @return int8_t 0 on success
+         */
+        LP50XX_ALWAYS_INLINE int8_t ReadRegisters(uint8_t reg, uint8_t *values, uint8_t count) {
+            return _bus.Bus::Read(Address, reg, values, count);
+        }
+
+    private:
+        Bus    &_bus;
+
+        /**
+         * @brief Resolves the EAddressType into an address, constant when the address type is
+         */
+        static LP50XX_ALWAYS_INLINE uint8_t address(EAddressType addressType) {
+            return addressType == EAddressType::Broadcast ? BROADCAST_ADDRESS : Address;
+        }
+
+        /**
+         * @brief Writes a single register
+         */
+        LP50XX_ALWAYS_INLINE int8_t write(uint8_t address, uint8_t reg, uint8_t value) {
+            return _bus.Bus::Write(address, reg, &value, 1);
+        }
+
+        /**
+         * @brief Orders the r, g and b values, the order is resolved at compile time
+         */
+        static LP50XX_ALWAYS_INLINE void orderColor(uint8_t r, uint8_t g, uint8_t b, uint8_t *buff) {
+            buff[Order == RGB || Order == RBG ? 0 : (Order == GRB || Order == BRG ? 1 : 2)] = r;
+            buff[Order == GRB || Order == GBR ? 0 : (Order == RGB || Order == BGR ? 1 : 2)] = g;
+            buff[Order == BGR || Order == BRG ? 0 : (Order == RBG || Order == GBR ? 1 : 2)] = b;
+        }
+
+        /**
+         * @brief Returns whether the bus is @ref LP50XXI2CBus, which needs i2c_init()
+         */
+        static bool isI2CBus() {
+            return isI2CBus((Bus *)0);
+        }
+        static bool isI2CBus(LP50XXI2CBus *) { return true; }
+        static bool isI2CBus(void *) { return false; }
+};
+
+#endif
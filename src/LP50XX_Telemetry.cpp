@@ -0,0 +1,97 @@
+/**
+ * @file LP50XX_Telemetry.cpp
+ * @brief Contains the bus usage counters, see @ref LP50XX_Telemetry.h
+ */
+#include "LP50XX_Telemetry.h"
+
+#include <string.h>
+
+/**
+ * @brief Instantiates the counters, all zero
+ */
+LP50XXTelemetry::LP50XXTelemetry() {
+    Reset();
+}
+
+/**
+ * @brief Sets all counters to zero and forgets the addresses
+ */
+void LP50XXTelemetry::Reset() {
+    memset(this, 0, sizeof(*this));
+}
+
+/**
+ * @brief Counts a completed transaction
+ *
+ * @param operation The operation, see @ref ETelemetryOperation
+ * @param address The I2C address of the transaction
+ * @param payload The number of register values written or read
+ * @param status The status of the transaction, 0 on success, otherwise a Wire.endTransmission() compatible error
+ * @param latencyUs The time the transaction took
+ */
+void LP50XXTelemetry::Record(uint8_t operation, uint8_t address, uint32_t payload, int8_t status, uint32_t latencyUs) {
+    if (operation >= TelemetryOperationCount) {
+        return;
+    }
+
+    transactions[operation]++;
+    payloadBytes += payload;
+    // Address and register address, a read adds the address after the repeated start, a probe is the address only
+    overheadBytes += operation == TelemetryRead ? 3 : (operation == TelemetryProbe ? 1 : 2);
+
+    uint16_t *bucket = &latency[operation][GetBucket(latencyUs)];
+    if (*bucket != 0xFFFF) {
+        (*bucket)++;
+    }
+    if (latencyUs > latencyMaxUs[operation]) {
+        latencyMaxUs[operation] = latencyUs;
+    }
+
+    if (status == 0) {
+        return;
+    }
+
+    LP50XXAddressErrors *entry = NULL;
+    for (uint8_t i = 0; i < addressCount; i++) {
+        if (addresses[i].address == address) {
+            entry = &addresses[i];
+            break;
+        }
+    }
+    if (entry == NULL && addressCount < LP50XX_TELEMETRY_ADDRESSES) {
+        entry = &addresses[addressCount++];
+        entry->address = address;
+    }
+
+    if (status == 2 || status == 3) {
+        nacks++;
+        if (entry != NULL) {
+            entry->nacks++;
+        }
+    } else if (status == 5) {
+        timeouts++;
+        if (entry != NULL) {
+            entry->timeouts++;
+        }
+    } else {
+        errors++;
+        if (entry != NULL) {
+            entry->errors++;
+        }
+    }
+}
+
+/**
+ * @brief Returns the histogram bucket of a latency
+ *
+ * @param latencyUs The latency
+ * @return uint8_t 0 below 1 us, n from 2^(n-1) us up to 2^n us, limited to the last bucket
+ */
+uint8_t LP50XXTelemetry::GetBucket(uint32_t latencyUs) {
+    uint8_t bucket = 0;
+    while (latencyUs != 0 && bucket < LP50XX_TELEMETRY_BUCKETS - 1) {
+        latencyUs >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
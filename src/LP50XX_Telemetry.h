@@ -0,0 +1,77 @@
+/**
+ * @file LP50XX_Telemetry.h
+ * @brief Bus usage counters of a device or a transport
+ *
+ * With LP50XX_TELEMETRY set to 1 every @ref LP50XX counts its own bus accesses and every transport counts all
+ * accesses on its bus: transactions and latency histograms per operation, payload and overhead bytes, and the
+ * errors per address. Devices also count the repeats and final failures of their retry policy (see
+ * @ref LP50XX_Retry.h). With the default of 0 neither the counters nor the code that updates them are compiled.
+ *
+ * @code
+ * LP50XXTelemetry telemetry;
+ * device.GetTelemetry(&telemetry);
+ * if (telemetry.nacks > 0) {
+ *     // The bus is degrading
+ * }
+ * device.ResetTelemetry();
+ * @endcode
+ *
+ * The latency is taken with micros(). Bucket 0 holds transactions below 1 us, bucket n those from 2^(n-1) us
+ * up to 2^n us, the last bucket everything above.
+ */
+#ifndef __LP50XX_TELEMETRY_H
+#define __LP50XX_TELEMETRY_H
+
+#include <stdint.h>
+
+#ifndef LP50XX_TELEMETRY
+#define LP50XX_TELEMETRY 0                  // 1 to count the bus accesses of every device and transport
+#endif
+
+#ifndef LP50XX_TELEMETRY_ADDRESSES
+#define LP50XX_TELEMETRY_ADDRESSES 8        // Addresses with separate error counters, errors of further addresses are only counted in total
+#endif
+
+#define LP50XX_TELEMETRY_BUCKETS 16         // Latency buckets, the last one starts at 16.4 ms
+
+enum ETelemetryOperation {
+    TelemetryWrite,
+    TelemetryRead,
+    TelemetryProbe,
+    TelemetryOperationCount
+};
+
+/**
+ * @brief Errors of a single address
+ */
+struct LP50XXAddressErrors {
+    uint8_t     address;
+    uint16_t    nacks;      // Status 2 and 3, the address or data was not acknowledged
+    uint16_t    timeouts;   // Status 5, the bus timeout expired
+    uint16_t    errors;     // Any other failed status
+};
+
+/**
+ * @brief Bus usage counters, all counters start at construction or the last reset
+ */
+struct LP50XXTelemetry {
+    uint32_t    transactions[TelemetryOperationCount];
+    uint32_t    payloadBytes;       // Register values written or read
+    uint32_t    overheadBytes;      // Address bytes, including the repeated start of reads, and register addresses
+    uint32_t    nacks;
+    uint32_t    timeouts;
+    uint32_t    errors;
+    uint32_t    retries;            // Transactions repeated by the retry policy, only counted by devices
+    uint32_t    failures;           // Transactions that failed after the last attempt, only counted by devices
+    uint32_t    latencyMaxUs[TelemetryOperationCount];
+    uint16_t    latency[TelemetryOperationCount][LP50XX_TELEMETRY_BUCKETS];   // Histogram of the transaction time, saturates at 65535
+    LP50XXAddressErrors addresses[LP50XX_TELEMETRY_ADDRESSES];
+    uint8_t     addressCount;
+
+    LP50XXTelemetry();
+    void Reset();
+    void Record(uint8_t operation, uint8_t address, uint32_t payload, int8_t status, uint32_t latencyUs);
+    static uint8_t GetBucket(uint32_t latencyUs);
+};
+
+#endif
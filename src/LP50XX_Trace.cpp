@@ -0,0 +1,199 @@
+/**
+ * @file LP50XX_Trace.cpp
+ * @brief Contains the binary trace ring, see @ref LP50XX_Trace.h
+ */
+#include "LP50XX_Trace.h"
+
+#if LP50XX_TRACE
+
+LP50XXTraceEvent LP50XXTrace::_events[LP50XX_TRACE_SIZE];
+uint16_t LP50XXTrace::_head = 0;
+uint16_t LP50XXTrace::_tail = 0;
+uint32_t LP50XXTrace::_lost = 0;
+
+// Marks a slot that is being written, it never matches the sequence a reader expects in that slot
+#define TRACE_WRITING 0x8000
+
+#if defined(__AVR__) || (defined(ARDUINO) && defined(__arm__))
+// Single core and the bus is only used from one context, the compiler must not reorder the accesses
+#define TRACE_LOAD(value, order) (value)
+#define TRACE_STORE(value, newValue, order) ((value) = (newValue))
+#define TRACE_FENCE(order) __asm__ __volatile__("" ::: "memory")
+#else
+#define TRACE_LOAD(value, order) __atomic_load_n(&(value), order)
+#define TRACE_STORE(value, newValue, order) __atomic_store_n(&(value), newValue, order)
+#define TRACE_FENCE(order) __atomic_thread_fence(order)
+#endif
+
+/*----------------------- Producer functions --------------------------------*/
+
+/**
+ * @brief Records a transaction, called by the bus functions after the transaction completed. Safe to call from
+ * several threads or tasks, not from interrupts
+ *
+ * @param operation The operation, see @ref ETraceOperation
+ * @param address The I2C address
+ * @param reg The first register
+ * @param pdata The register values written or read, NULL for none
+ * @param count The number of register values
+ * @param status The status of the transaction, 0 on success
+ */
+void LP50XXTrace::Record(uint8_t operation, uint8_t address, uint8_t reg, const uint8_t *pdata, uint32_t count, int8_t status) {
+    uint16_t sequence;
+#if defined(__AVR__) || (defined(ARDUINO) && defined(__arm__))
+    // Single core, the bus is only used from one context
+    sequence = _head++;
+#else
+    sequence = __atomic_fetch_add(&_head, 1, __ATOMIC_RELAXED);
+#endif
+
+    LP50XXTraceEvent &event = _events[sequence & (LP50XX_TRACE_SIZE - 1)];
+    TRACE_STORE(event.sequence, (uint16_t)(sequence + TRACE_WRITING), __ATOMIC_RELAXED);
+    TRACE_FENCE(__ATOMIC_RELEASE);
+
+    event.timeUs = micros();
+    event.address = address;
+    event.reg = reg;
+    event.flags = (operation & 0x03) | (uint8_t)status << 4;
+    event.length = count > 0xFF ? 0xFF : count;
+    uint8_t stored = count > LP50XX_TRACE_PAYLOAD ? LP50XX_TRACE_PAYLOAD : count;
+    if (pdata != NULL && stored > 0) {
+        memcpy(event.payload, pdata, stored);
+    }
+
+    TRACE_STORE(event.sequence, sequence, __ATOMIC_RELEASE);
+}
+
+/*----------------------- Consumer functions --------------------------------*/
+
+/**
+ * @brief Takes the oldest unread events out of the ring. Only one context may read
+ *
+ * @param events The buffer for the events
+ * @param maxCount The size of the buffer
+ * @return uint16_t The number of events taken, 0 when no complete event is available
+ */
+uint16_t LP50XXTrace::Read(LP50XXTraceEvent *events, uint16_t maxCount) {
+    uint16_t head = TRACE_LOAD(_head, __ATOMIC_ACQUIRE);
+    if ((uint16_t)(head - _tail) > LP50XX_TRACE_SIZE) {
+        _lost += (uint16_t)(head - _tail) - LP50XX_TRACE_SIZE;
+        _tail = head - LP50XX_TRACE_SIZE;
+    }
+
+    uint16_t count = 0;
+    while (_tail != head && count < maxCount) {
+        const LP50XXTraceEvent &event = _events[_tail & (LP50XX_TRACE_SIZE - 1)];
+        uint16_t sequence = TRACE_LOAD(event.sequence, __ATOMIC_ACQUIRE);
+        if (sequence == (uint16_t)(_tail + TRACE_WRITING)) {
+            // Still being written
+            break;
+        }
+        if (sequence == _tail) {
+            events[count] = event;
+            TRACE_FENCE(__ATOMIC_ACQUIRE);
+            if (TRACE_LOAD(event.sequence, __ATOMIC_RELAXED) == _tail) {
+                count++;
+                _tail++;
+                continue;
+            }
+        }
+        // Overwritten by a newer event before or while it was copied
+        _lost++;
+        _tail++;
+    }
+    return count;
+}
+
+/**
+ * @brief Takes all unread events out of the ring and writes them in the binary dump format, see @ref LP50XX_Trace.h
+ *
+ * @param out The output, e.g. Serial
+ * @return uint16_t The number of events written
+ */
+#ifdef ARDUINO
+uint16_t LP50XXTrace::Dump(Print &out) {
+#else
+uint16_t LP50XXTrace::Dump(FILE *out) {
+#endif
+    uint8_t buff[10 + LP50XX_TRACE_PAYLOAD];
+    uint8_t length = encodeHeader(buff);
+#ifdef ARDUINO
+    out.write(buff, length);
+#else
+    fwrite(buff, 1, length, out);
+#endif
+
+    uint16_t total = 0;
+    LP50XXTraceEvent event;
+    while (Read(&event, 1) == 1) {
+        length = encode(event, buff);
+#ifdef ARDUINO
+        out.write(buff, length);
+#else
+        fwrite(buff, 1, length, out);
+#endif
+        total++;
+    }
+    return total;
+}
+
+/**
+ * @brief Discards all unread events and resets the lost counter
+ */
+void LP50XXTrace::Clear() {
+    _tail = TRACE_LOAD(_head, __ATOMIC_ACQUIRE);
+    _lost = 0;
+}
+
+/**
+ * @brief Returns the number of events that were overwritten before they were read
+ *
+ * @return uint32_t
+ */
+uint32_t LP50XXTrace::GetLost() {
+    return _lost;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Encodes an event in the dump format
+ *
+ * @param event The event
+ * @param buff The buffer of 10 + @ref LP50XX_TRACE_PAYLOAD bytes
+ * @return uint8_t The encoded length
+ */
+uint8_t LP50XXTrace::encode(const LP50XXTraceEvent &event, uint8_t *buff) {
+    buff[0] = event.timeUs;
+    buff[1] = event.timeUs >> 8;
+    buff[2] = event.timeUs >> 16;
+    buff[3] = event.timeUs >> 24;
+    buff[4] = event.sequence;
+    buff[5] = event.sequence >> 8;
+    buff[6] = event.address;
+    buff[7] = event.reg;
+    buff[8] = event.flags;
+    buff[9] = event.length;
+    memcpy(&buff[10], event.payload, LP50XX_TRACE_PAYLOAD);
+    return 10 + LP50XX_TRACE_PAYLOAD;
+}
+
+/**
+ * @brief Encodes the dump header
+ *
+ * @param buff The buffer of at least 6 bytes
+ * @return uint8_t The encoded length
+ */
+uint8_t LP50XXTrace::encodeHeader(uint8_t *buff) {
+    buff[0] = 'L';
+    buff[1] = 'P';
+    buff[2] = 'T';
+    buff[3] = 'R';
+    buff[4] = LP50XX_TRACE_VERSION;
+    buff[5] = LP50XX_TRACE_PAYLOAD;
+    return 6;
+}
+
+#endif
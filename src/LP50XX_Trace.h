@@ -0,0 +1,93 @@
+/**
+ * @file LP50XX_Trace.h
+ * @brief Binary trace of the bus transactions in a fixed-size ring
+ *
+ * With LP50XX_TRACE set to 1 the I2C functions of @ref I2C_coms.h, @ref LP50XXWireTransport and
+ * @ref LP50XXLinuxI2C record every transaction into one global ring: timestamp, address, register, length,
+ * status and the first @ref LP50XX_TRACE_PAYLOAD bytes. Recording only copies a few bytes and never blocks,
+ * when the ring is full the oldest events are overwritten. The events are taken out lazily with
+ * @ref LP50XXTrace::Read or sent in the binary format below with @ref LP50XXTrace::Dump, e.g. on a serial command.
+ * `extras/tools/lp50xx_trace_decode.cpp` turns a dump into text and summary statistics.
+ *
+ * Dump format, little endian: a header "LPTR", version (1), payload size, followed by the events, each
+ * time (4 bytes, micros()), sequence (2), address, register, flags (bits 0..1 @ref ETraceOperation, bits 4..7
+ * status), length and the payload bytes. Gaps in the sequence are events that were overwritten before they were read.
+ */
+#ifndef __LP50XX_TRACE_H
+#define __LP50XX_TRACE_H
+
+#include "LP50XX_Platform.h"
+#ifndef ARDUINO
+#include <stdio.h>
+#endif
+
+#ifndef LP50XX_TRACE
+#define LP50XX_TRACE 0                  // 1 to record every bus transaction
+#endif
+
+#ifndef LP50XX_TRACE_SIZE
+#define LP50XX_TRACE_SIZE 32            // Events in the ring, a power of two
+#endif
+
+#ifndef LP50XX_TRACE_PAYLOAD
+#define LP50XX_TRACE_PAYLOAD 4          // Payload bytes stored per event
+#endif
+
+#if (LP50XX_TRACE_SIZE & (LP50XX_TRACE_SIZE - 1)) || LP50XX_TRACE_SIZE > 32768
+#error "LP50XX_TRACE_SIZE has to be a power of two up to 32768"
+#endif
+
+#define LP50XX_TRACE_VERSION 1
+
+#if LP50XX_TRACE
+#define LP50XX_TRACE_RECORD(operation, address, reg, pdata, count, status) LP50XXTrace::Record(operation, address, reg, pdata, count, status)
+#else
+#define LP50XX_TRACE_RECORD(operation, address, reg, pdata, count, status) do { } while (0)
+#endif
+
+enum ETraceOperation {
+    TraceWrite,
+    TraceRead,
+    TraceProbe
+};
+
+/**
+ * @brief A recorded transaction
+ */
+struct LP50XXTraceEvent {
+    uint32_t    timeUs;         // micros() when the transaction completed
+    uint16_t    sequence;       // Number of the event, wraps
+    uint8_t     address;
+    uint8_t     reg;
+    uint8_t     flags;          // Bits 0..1 the @ref ETraceOperation, bits 4..7 the status
+    uint8_t     length;         // Register values written or read, limited to 255
+    uint8_t     payload[LP50XX_TRACE_PAYLOAD];
+};
+
+/**
+ * @brief The global trace ring
+ */
+class LP50XXTrace
+{
+    public:
+        static void Record(uint8_t operation, uint8_t address, uint8_t reg, const uint8_t *pdata, uint32_t count, int8_t status);
+        static uint16_t Read(LP50XXTraceEvent *events, uint16_t maxCount);
+#ifdef ARDUINO
+        static uint16_t Dump(Print &out);
+#else
+        static uint16_t Dump(FILE *out);
+#endif
+        static void Clear();
+        static uint32_t GetLost();
+
+    private:
+        static LP50XXTraceEvent     _events[LP50XX_TRACE_SIZE];
+        static uint16_t             _head;      // Next sequence to record, reserved atomically by the producers
+        static uint16_t             _tail;      // Next sequence to read
+        static uint32_t             _lost;
+
+        static uint8_t encode(const LP50XXTraceEvent &event, uint8_t *buff);
+        static uint8_t encodeHeader(uint8_t *buff);
+};
+
+#endif
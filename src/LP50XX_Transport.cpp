@@ -0,0 +1,147 @@
+/**
+ * @file LP50XX_Transport.cpp
+ * @brief Contains the Arduino TwoWire transport, see @ref LP50XX_Transport.h
+ */
+#include "LP50XX_Transport.h"
+#include "LP50XX_Trace.h"
+#include "LP50XX_Profile.h"
+
+#ifdef ARDUINO
+
+/**
+ * @brief This function instantiates the transport
+ * 
+ * @param wire The bus, e.g. Wire or Wire1. It has to be started with begin() by the application
+ */
+LP50XXWireTransport::LP50XXWireTransport(TwoWire &wire) : _wire(wire) {
+
+}
+
+/**
+ * @brief Writes consecutive registers in a single transaction
+ * 
+ * @param deviceAddress The I2C address of the device
+ * @param registerAddress The first register to write
+ * @param pdata The register values
+ * @param count The number of register values
+ * @return int8_t The result of endTransmission(), 0 on success, 4 when the bus is stuck and could not be recovered
+ */
+int8_t LP50XXWireTransport::Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+    LP50XX_PROFILE_SCOPE(ProfileI2CWrite);
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t status = checkBus();
+    if (status == 0) {
+        _wire.beginTransmission(deviceAddress);
+        _wire.write(registerAddress);
+        _wire.write(pdata, count);
+        status = _wire.endTransmission();
+        if (status != 0) {
+            // A repeat of the transaction finds a recovered bus
+            checkBus();
+        }
+    }
+#if LP50XX_TELEMETRY
+    _telemetry.Record(TelemetryWrite, deviceAddress, count, status, micros() - start);
+#endif
+    LP50XX_TRACE_RECORD(TraceWrite, deviceAddress, registerAddress, pdata, count, status);
+    return status;
+}
+
+/**
+ * @brief Reads consecutive registers with a repeated start
+ * 
+ * @param deviceAddress The I2C address of the device
+ * @param registerAddress The first register to read
+ * @param pdata The buffer for the register values
+ * @param count The number of registers to read
+ * @return int8_t 0 on success, 4 when fewer bytes were received or the bus is stuck and could not be recovered
+ */
+int8_t LP50XXWireTransport::Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    LP50XX_PROFILE_SCOPE(ProfileI2CRead);
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t status = checkBus();
+    if (status == 0) {
+        status = read(deviceAddress, registerAddress, pdata, count);
+        if (status != 0) {
+            checkBus();
+        }
+    }
+#if LP50XX_TELEMETRY
+    _telemetry.Record(TelemetryRead, deviceAddress, count, status, micros() - start);
+#endif
+    LP50XX_TRACE_RECORD(TraceRead, deviceAddress, registerAddress, pdata, count, status);
+    return status;
+}
+
+/**
+ * @brief Checks whether a device acknowledges its address with an address only write
+ * 
+ * @param deviceAddress The I2C address to probe
+ * @return int8_t The result of endTransmission(), 0 when the device acknowledged
+ */
+int8_t LP50XXWireTransport::Probe(uint8_t deviceAddress) {
+#if LP50XX_TELEMETRY
+    unsigned long start = micros();
+#endif
+    int8_t status = checkBus();
+    if (status == 0) {
+        _wire.beginTransmission(deviceAddress);
+        status = _wire.endTransmission();
+        if (status != 0) {
+            checkBus();
+        }
+    }
+#if LP50XX_TELEMETRY
+    _telemetry.Record(TelemetryProbe, deviceAddress, 0, status, micros() - start);
+#endif
+    LP50XX_TRACE_RECORD(TraceProbe, deviceAddress, 0, NULL, 0, status);
+    return status;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Reads consecutive registers with a repeated start, see @ref Read
+ * 
+ * @param deviceAddress The I2C address of the device
+ * @param registerAddress The first register to read
+ * @param pdata The buffer for the register values
+ * @param count The number of registers to read
+ * @return int8_t 0 on success, 4 when fewer bytes were received
+ */
+int8_t LP50XXWireTransport::read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    _wire.beginTransmission(deviceAddress);
+    _wire.write(registerAddress);
+    int8_t status = _wire.endTransmission(false); // Dont send a stop bit
+    if (status != 0) {
+        return status;
+    }
+
+    if (_wire.requestFrom(deviceAddress, (uint8_t)count) != count) {
+        return 4;
+    }
+    while (count--) {
+        *pdata++ = _wire.read();
+    }
+    return 0;
+}
+
+/**
+ * @brief Recovers the bus when it is stuck, see @ref LP50XX_BusRecovery.h
+ * 
+ * @return int8_t 0 when the bus is free or has no recovery, 4 when it is still stuck
+ */
+int8_t LP50XXWireTransport::checkBus() {
+    if (_recovery == NULL || !_recovery->IsStuck()) {
+        return 0;
+    }
+    return _recovery->Recover(_wire);
+}
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file LP50XX_Transport.h
+ * @brief Contains the bus interface that lets every device use its own I2C bus
+ *
+ * A device without a transport uses the I2C functions of @ref I2C_coms.h. A device with a transport
+ * (see @ref LP50XX::SetTransport) performs all its bus access through that transport instead.
+ */
+#ifndef __LP50XX_TRANSPORT_H
+#define __LP50XX_TRANSPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LP50XX_Telemetry.h"
+#include "LP50XX_BusTiming.h"
+#include "LP50XX_Retry.h"
+#include "LP50XX_BusRecovery.h"
+#ifdef ARDUINO
+#include <Wire.h>
+#endif
+
+/**
+ * @brief Interface of an I2C bus
+ */
+class LP50XXTransport
+{
+    public:
+        /**
+         * @brief Writes consecutive registers
+         * 
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        virtual int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) = 0;
+        /**
+         * @brief Reads consecutive registers
+         * 
+         * @return int8_t 0 on success, otherwise a Wire.endTransmission() compatible error
+         */
+        virtual int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) = 0;
+        /**
+         * @brief Checks whether a device acknowledges its address. The default reads register 0, transports
+         * override it with an address only write
+         * 
+         * @return int8_t 0 when the device acknowledged
+         */
+        virtual int8_t Probe(uint8_t deviceAddress) {
+            uint8_t value;
+            return Read(deviceAddress, 0x00, &value, 1);
+        }
+
+        /**
+         * @brief Starts a group of writes that the transport may combine, e.g. the flush of all devices on the bus.
+         * The writes of the group may return 0 before they are on the bus, their status is reported by @ref EndBatch
+         */
+        virtual void BeginBatch() {}
+        /**
+         * @brief Ends a group of writes started with @ref BeginBatch
+         * 
+         * @return int8_t 0 when all writes of the group succeeded, otherwise the registers they wrote have to be
+         * written again
+         */
+        virtual int8_t EndBatch() { return 0; }
+
+        /**
+         * @brief Sets the timing model of this bus, it should match the clock the bus runs at
+         *
+         * @param timing The model, NULL for @ref LP50XXBusTiming::Default
+         */
+        void SetTiming(LP50XXBusTiming *timing) { _timing = timing; }
+        /**
+         * @brief Returns the timing model of this bus
+         */
+        LP50XXBusTiming &GetTiming() { return _timing != NULL ? *_timing : LP50XXBusTiming::Default(); }
+
+        /**
+         * @brief Sets the retry policy of the devices on this bus
+         *
+         * @param retry The policy, NULL for the own policy of the transport, a copy of @ref LP50XXRetryPolicy::Default
+         * made when the transport was constructed
+         */
+        void SetRetryPolicy(LP50XXRetryPolicy *retry) { _retry = retry; }
+        /**
+         * @brief Returns the retry policy of the devices on this bus
+         */
+        LP50XXRetryPolicy &GetRetryPolicy() { return _retry != NULL ? *_retry : _own_retry; }
+
+        /**
+         * @brief Sets the stuck bus recovery of this bus, transports that control the pins check the bus with it
+         *
+         * @param recovery The recovery, NULL for none
+         */
+        void SetRecovery(LP50XXBusRecovery *recovery) { _recovery = recovery; }
+        /**
+         * @brief Returns the stuck bus recovery of this bus
+         *
+         * @return LP50XXBusRecovery* The recovery, NULL for none
+         */
+        LP50XXBusRecovery *GetRecovery() { return _recovery; }
+
+#if LP50XX_TELEMETRY
+        /**
+         * @brief Copies the counters of all accesses on this bus, see @ref LP50XX_Telemetry.h
+         */
+        void GetTelemetry(LP50XXTelemetry *telemetry) { *telemetry = _telemetry; }
+        /**
+         * @brief Resets the counters of all accesses on this bus
+         */
+        void ResetTelemetry() { _telemetry.Reset(); }
+#endif
+
+    protected:
+        ~LP50XXTransport() {}
+
+        LP50XXBusTiming *_timing = NULL;
+        LP50XXRetryPolicy *_retry = NULL;
+        LP50XXRetryPolicy _own_retry = LP50XXRetryPolicy::Default();   // Buses do not share the counters and frame budget
+        LP50XXBusRecovery *_recovery = NULL;
+
+#if LP50XX_TELEMETRY
+        LP50XXTelemetry _telemetry;
+#endif
+};
+
+#ifdef ARDUINO
+/**
+ * @brief Transport for an Arduino TwoWire bus, e.g. Wire1 on boards with multiple I2C controllers
+ */
+class LP50XXWireTransport : public LP50XXTransport
+{
+    public:
+        LP50XXWireTransport(TwoWire &wire);
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count);
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count);
+        int8_t Probe(uint8_t deviceAddress);
+
+    private:
+        TwoWire    &_wire;
+
+        int8_t read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count);
+        int8_t checkBus();
+};
+#endif
+
+#endif
@@ -0,0 +1,308 @@
+/**
+ * @file LP50XX_UDP.cpp
+ * @brief Art-Net and E1.31 ingest for Linux, see @ref LP50XX_UDP.h
+ */
+#if !defined(ARDUINO) && defined(__linux__)
+
+#include "LP50XX_UDP.h"
+#include "LP50XX.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define ARTNET_HEADER_SIZE 18
+#define ARTNET_OPCODE_DMX 0x5000
+#define E131_HEADER_SIZE 126
+#define E131_VECTOR_ROOT_DATA 0x00000004
+#define E131_VECTOR_FRAMING_DATA 0x00000002
+#define E131_OPTION_PREVIEW 0x80
+#define E131_OPTION_TERMINATED 0x40
+
+static const uint8_t artnetId[8] = { 'A', 'r', 't', '-', 'N', 'e', 't', 0 };
+static const uint8_t e131Id[12] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+
+static uint16_t readBE16(const uint8_t *pdata) {
+    return (uint16_t)pdata[0] << 8 | pdata[1];
+}
+
+static uint32_t readBE32(const uint8_t *pdata) {
+    return (uint32_t)readBE16(pdata) << 16 | readBE16(pdata + 2);
+}
+
+static bool patchOrder(const LP50XXPatch &a, const LP50XXPatch &b) {
+    return a.universe < b.universe;
+}
+
+/**
+ * @brief This function instantiates the ingest
+ *
+ * @param devices The devices to stage into, a patch refers to devices[index]
+ * @param deviceCount The number of devices
+ */
+LP50XXUDPIngest::LP50XXUDPIngest(LP50XX **devices, uint8_t deviceCount) {
+    _devices = devices;
+    _device_count = deviceCount;
+
+    ResetStats();
+}
+
+LP50XXUDPIngest::~LP50XXUDPIngest() {
+    End();
+}
+
+/**
+ * @brief Opens and binds the UDP socket
+ *
+ * @param port The UDP port to listen on, @ref LP50XX_ARTNET_PORT or @ref LP50XX_E131_PORT
+ * @param address The local IPv4 address to bind to, e.g. "127.0.0.1" for loopback only
+ * @return true when the socket is bound
+ */
+bool LP50XXUDPIngest::Begin(uint16_t port, const char *address) {
+    End();
+
+    struct sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    if (inet_pton(AF_INET, address, &local.sin_addr) != 1) {
+        return false;
+    }
+
+    _socket = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (_socket < 0) {
+        return false;
+    }
+    int enable = 1;
+    setsockopt(_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    setsockopt(_socket, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable));
+    if (bind(_socket, (struct sockaddr *)&local, sizeof(local)) != 0) {
+        End();
+        return false;
+    }
+
+    _deadline_us = micros() + _period_us;
+    _pending = false;
+    ResetStats();
+    return true;
+}
+
+/**
+ * @brief Closes the UDP socket
+ */
+void LP50XXUDPIngest::End() {
+    if (_socket >= 0) {
+        close(_socket);
+        _socket = -1;
+    }
+}
+
+/**
+ * @brief Compiles the patch table. The patches are validated and sorted by universe so a packet only visits its own patches
+ *
+ * @param patch The patches
+ * @param count The number of patches
+ * @return true when all patches are valid, otherwise the previous patch table is kept
+ */
+bool LP50XXUDPIngest::SetPatch(const LP50XXPatch *patch, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        if (patch[i].device >= _device_count || patch[i].count == 0 || patch[i].channel == 0 ||
+            patch[i].channel + patch[i].count - 1 > LP50XX_DMX_CHANNELS ||
+            patch[i].reg + patch[i].count > LP50XX_REGISTER_COUNT) {
+            return false;
+        }
+    }
+
+    _patch.assign(patch, patch + count);
+    std::stable_sort(_patch.begin(), _patch.end(), patchOrder);
+    return true;
+}
+
+/**
+ * @brief Sets the length of the frame window
+ *
+ * @param fps The number of frames per second, the devices are flushed at most once per frame
+ */
+void LP50XXUDPIngest::SetFrameRate(uint16_t fps) {
+    if (fps == 0) {
+        return;
+    }
+    _period_us = 1000000UL / fps;
+}
+
+/**
+ * @brief Receives and stages packets until the end of the current frame window, then flushes the devices
+ * if any packet arrived. Call this in a loop, it blocks for at most one frame window
+ *
+ * @return uint16_t The number of packets that were received in this frame window
+ */
+uint16_t LP50XXUDPIngest::Poll() {
+    uint8_t packet[E131_HEADER_SIZE + LP50XX_DMX_CHANNELS];
+    uint16_t packets = 0;
+
+    for (;;) {
+        long remaining = (long)(_deadline_us - micros());
+        if (remaining <= 0 || _socket < 0) {
+            break;
+        }
+
+        struct pollfd pfd = { _socket, POLLIN, 0 };
+        if (poll(&pfd, 1, (remaining + 999) / 1000) <= 0) {
+            continue;
+        }
+
+        // Drain everything that is queued, the kernel buffers packets while the bus is busy
+        ssize_t length;
+        while ((length = recv(_socket, packet, sizeof(packet), MSG_DONTWAIT)) > 0) {
+            if (ProcessPacket(packet, length)) {
+                packets++;
+            }
+        }
+    }
+
+    if (_pending) {
+        if (FlushFrame() != 0) {
+            _stats.flushErrors++;
+        }
+        unsigned long latency = micros() - _first_packet_us;
+        _stats.frames++;
+        _stats.latencySumUs += latency;
+        if (latency > _stats.latencyMaxUs) {
+            _stats.latencyMaxUs = latency;
+        }
+        _pending = false;
+    }
+
+    // Keep the frame windows on a fixed grid, unless the flush took longer than a whole window
+    _deadline_us += _period_us;
+    if ((long)(_deadline_us - micros()) < 0) {
+        _deadline_us = micros() + _period_us;
+    }
+    return packets;
+}
+
+/**
+ * @brief Parses a single Art-Net or E1.31 packet and stages its patched channels
+ *
+ * @param pdata The UDP payload
+ * @param length The length of the UDP payload
+ * @return true when the packet was valid
+ */
+bool LP50XXUDPIngest::ProcessPacket(const uint8_t *pdata, size_t length) {
+    uint16_t universe;
+    uint16_t count;
+    const uint8_t *channels;
+
+    if (length >= ARTNET_HEADER_SIZE && memcmp(pdata, artnetId, sizeof(artnetId)) == 0) {
+        if ((pdata[8] | pdata[9] << 8) != ARTNET_OPCODE_DMX) {
+            _stats.rejected++;
+            return false;
+        }
+        universe = pdata[14] | (pdata[15] & 0x7F) << 8;
+        count = readBE16(&pdata[16]);
+        channels = &pdata[ARTNET_HEADER_SIZE];
+        if (count > length - ARTNET_HEADER_SIZE) {
+            count = length - ARTNET_HEADER_SIZE;
+        }
+    } else if (length >= E131_HEADER_SIZE && memcmp(&pdata[4], e131Id, sizeof(e131Id)) == 0) {
+        if (readBE32(&pdata[18]) != E131_VECTOR_ROOT_DATA || readBE32(&pdata[40]) != E131_VECTOR_FRAMING_DATA ||
+            pdata[112] & (E131_OPTION_PREVIEW | E131_OPTION_TERMINATED) || pdata[125] != 0x00) {
+            _stats.rejected++;
+            return false;
+        }
+        universe = readBE16(&pdata[113]);
+        // The property count includes the start code
+        count = readBE16(&pdata[123]);
+        count = count ? count - 1 : 0;
+        channels = &pdata[E131_HEADER_SIZE];
+        if (count > length - E131_HEADER_SIZE) {
+            count = length - E131_HEADER_SIZE;
+        }
+    } else {
+        _stats.rejected++;
+        return false;
+    }
+
+    if (count > LP50XX_DMX_CHANNELS) {
+        count = LP50XX_DMX_CHANNELS;
+    }
+    stageUniverse(universe, channels, count);
+    _stats.packets++;
+    return true;
+}
+
+/**
+ * @brief Flushes all devices
+ *
+ * @return int8_t 0 on success, otherwise the status of the last failed flush
+ */
+int8_t LP50XXUDPIngest::FlushFrame() {
+    int8_t result = 0;
+    for (uint8_t i = 0; i < _device_count; i++) {
+        int8_t status = _devices[i]->Flush();
+        if (status != 0) {
+            result = status;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the ingest statistics
+ *
+ * @param stats The statistics to fill
+ */
+void LP50XXUDPIngest::GetStats(LP50XXUDPStats *stats) {
+    *stats = _stats;
+    stats->elapsedUs = micros() - _stats_start_us;
+}
+
+/**
+ * @brief Resets the ingest statistics
+ */
+void LP50XXUDPIngest::ResetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+    _stats_start_us = micros();
+}
+
+/**
+ * @brief Returns the UDP socket, e.g. to send packets to the bound port in a test
+ *
+ * @return int The socket, -1 when not bound
+ */
+int LP50XXUDPIngest::GetSocket() {
+    return _socket;
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Stages the channels of a universe through all patches of that universe
+ *
+ * @param universe The universe of the packet
+ * @param pdata The DMX channels, starting at channel 1
+ * @param count The number of DMX channels in the packet
+ */
+void LP50XXUDPIngest::stageUniverse(uint16_t universe, const uint8_t *pdata, uint16_t count) {
+    LP50XXPatch key = {};
+    key.universe = universe;
+    std::vector<LP50XXPatch>::const_iterator patch = std::lower_bound(_patch.begin(), _patch.end(), key, patchOrder);
+
+    for (; patch != _patch.end() && patch->universe == universe; ++patch) {
+        LP50XX *device = _devices[patch->device];
+        for (uint8_t i = 0; i < patch->count && patch->channel - 1 + i < count; i++) {
+            device->StageRegister(patch->reg + i, pdata[patch->channel - 1 + i]);
+        }
+    }
+
+    if (!_pending) {
+        _first_packet_us = micros();
+        _pending = true;
+    }
+}
+
+#endif
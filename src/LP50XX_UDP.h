@@ -0,0 +1,90 @@
+/**
+ * @file LP50XX_UDP.h
+ * @brief Art-Net and E1.31 (sACN) ingest for Linux
+ *
+ * Supported is the subset needed to receive lighting data: ArtDmx packets on port @ref LP50XX_ARTNET_PORT and
+ * E1.31 data packets with the DMX start code on port @ref LP50XX_E131_PORT, both unicast or broadcast.
+ * Universes are numbered as on the wire, Art-Net starts at universe 0 and E1.31 at universe 1.
+ *
+ * Received channels are staged in the shadow image of the devices through a patch table. All packets that
+ * arrive within one frame window are coalesced and the devices are flushed once at the end of the window.
+ */
+#ifndef __LP50XX_UDP_H
+#define __LP50XX_UDP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#define LP50XX_ARTNET_PORT 6454
+#define LP50XX_E131_PORT 5568
+#define LP50XX_DMX_CHANNELS 512
+#define LP50XX_UDP_DEFAULT_FPS 100
+
+class LP50XX;
+
+/**
+ * @brief A patch maps a range of DMX channels of a universe onto consecutive registers of a device
+ */
+struct LP50XXPatch {
+    uint16_t    universe;   // Universe as numbered by the protocol
+    uint16_t    channel;    // First DMX channel, 1..512
+    uint8_t     device;     // Index in the device list
+    uint8_t     reg;        // First register, e.g. OUT0_COLOR
+    uint8_t     count;      // Number of channels and registers
+};
+
+/**
+ * @brief Ingest statistics, all counters start at @ref LP50XXUDPIngest::Begin or @ref LP50XXUDPIngest::ResetStats
+ */
+struct LP50XXUDPStats {
+    uint32_t    packets;        // Accepted Art-Net and E1.31 packets
+    uint32_t    rejected;       // Packets that were not Art-Net or E1.31 DMX data
+    uint32_t    frames;         // Frame windows that ended with a flush
+    uint32_t    flushErrors;    // Frames where at least one device failed to flush
+    uint64_t    latencySumUs;   // Sum of the time from the first packet of a frame until its flush completed
+    uint32_t    latencyMaxUs;   // Largest time from the first packet of a frame until its flush completed
+    uint64_t    elapsedUs;      // Time since the counters started
+};
+
+/**
+ * @brief Receives Art-Net and E1.31 packets on a UDP socket and stages them into the devices
+ */
+class LP50XXUDPIngest
+{
+    public:
+        LP50XXUDPIngest(LP50XX **devices, uint8_t deviceCount);
+        ~LP50XXUDPIngest();
+
+        bool Begin(uint16_t port = LP50XX_ARTNET_PORT, const char *address = "0.0.0.0");
+        void End();
+
+        bool SetPatch(const LP50XXPatch *patch, uint16_t count);
+        void SetFrameRate(uint16_t fps);
+
+        uint16_t Poll();
+        bool ProcessPacket(const uint8_t *pdata, size_t length);
+        int8_t FlushFrame();
+
+        void GetStats(LP50XXUDPStats *stats);
+        void ResetStats();
+        int GetSocket();
+
+    private:
+        LP50XX    **_devices;
+        uint8_t     _device_count;
+        int         _socket = -1;
+
+        std::vector<LP50XXPatch> _patch;
+        unsigned long   _period_us = 1000000UL / LP50XX_UDP_DEFAULT_FPS;
+        unsigned long   _deadline_us = 0;
+        unsigned long   _first_packet_us = 0;
+        bool            _pending = false;
+
+        LP50XXUDPStats  _stats;
+        unsigned long   _stats_start_us = 0;
+
+        void stageUniverse(uint16_t universe, const uint8_t *pdata, uint16_t count);
+};
+
+#endif
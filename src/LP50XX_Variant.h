@@ -0,0 +1,131 @@
+/**
+ * @file LP50XX_Variant.h
+ * @brief Drivers with the variant fixed at compile time
+ *
+ * @ref LP5009 and @ref LP5012 are LP50XX drivers whose variant is set by their type. Their LED and output counts
+ * are constants, so loops over them are sized by the compiler. With optimization enabled (the Arduino default)
+ * an index that is constant and out of range for the variant is a compile error:
+ *
+ * @code
+ * LP5009 device;
+ * device.SetLEDColor(3, 255, 0, 0); // error: LED or output index out of range for the variant
+ * for (uint8_t led = 0; led < LP5009::LEDCount; led++) {
+ *     device.StageLEDColor(led, 0, 0, 255);
+ * }
+ * @endcode
+ *
+ * Indices that are only known at runtime are checked by @ref LP50XX, which ignores them. Both types are an LP50XX
+ * and work with the chain, frame buffer and the other classes. A plain LP50XX with @ref LP50XX::SetVariant is the
+ * fallback when the variant is only known at runtime, e.g. after @ref LP50XXDiscovery::DetectVariant.
+ */
+#ifndef __LP50XX_VARIANT_H
+#define __LP50XX_VARIANT_H
+
+#include "LP50XX.h"
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__OPTIMIZE__)
+// Never defined, a call that is not optimized away fails the build
+void lp50xx_index_out_of_range() __attribute__((error("LED or output index out of range for the variant")));
+#define LP50XX_CHECK_INDEX(index, count) do { if (__builtin_constant_p(index) && (index) >= (count)) lp50xx_index_out_of_range(); } while (0)
+#define LP50XX_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define LP50XX_CHECK_INDEX(index, count) do { } while (0)
+#define LP50XX_ALWAYS_INLINE inline
+#endif
+
+/**
+ * @brief Driver for one variant of the LP50XX
+ *
+ * @tparam Variant @ref VariantLP5009 or @ref VariantLP5012
+ */
+template <EVariant Variant>
+class LP50XXVariant : public LP50XX
+{
+    static_assert(Variant == VariantLP5009 || Variant == VariantLP5012, "LP50XXVariant needs VariantLP5009 or VariantLP5012");
+
+    public:
+        static const uint8_t LEDCount = Variant == VariantLP5009 ? 3 : 4;
+        static const uint8_t OutputCount = LEDCount * 3;
+        static const uint8_t RegisterCount = Variant == VariantLP5009 ? LP5009_REGISTER_COUNT : LP50XX_REGISTER_COUNT;
+
+        /**
+         * @brief Instantiates the driver, see @ref LP50XX::LP50XX
+         */
+        LP50XXVariant() : LP50XX() {
+            SetVariant(Variant);
+        }
+
+        /**
+         * @brief Instantiates the driver with a specific LED configuration, see @ref LP50XX::LP50XX
+         */
+        LP50XXVariant(LED_Configuration ledConfiguration) : LP50XX(ledConfiguration) {
+            SetVariant(Variant);
+        }
+
+        /**
+         * @brief Instantiates the driver with an enable pin, see @ref LP50XX::LP50XX
+         */
+        LP50XXVariant(uint8_t enablePin) : LP50XX(enablePin) {
+            SetVariant(Variant);
+        }
+
+        /**
+         * @brief Instantiates the driver with a specific LED configuration and an enable pin, see @ref LP50XX::LP50XX
+         */
+        LP50XXVariant(LED_Configuration ledConfiguration, uint8_t enablePin) : LP50XX(ledConfiguration, enablePin) {
+            SetVariant(Variant);
+        }
+
+        /**
+         * @brief See @ref LP50XX::SetLEDBrightness, the LED is checked against @ref LEDCount
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetLEDBrightness(uint8_t led, uint8_t brightness, EAddressType addressType = EAddressType::Normal) {
+            LP50XX_CHECK_INDEX(led, LEDCount);
+            return LP50XX::SetLEDBrightness(led, brightness, addressType);
+        }
+
+        /**
+         * @brief See @ref LP50XX::SetOutputColor, the output is checked against @ref OutputCount
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetOutputColor(uint8_t output, uint8_t value, EAddressType addressType = EAddressType::Normal) {
+            LP50XX_CHECK_INDEX(output, OutputCount);
+            return LP50XX::SetOutputColor(output, value, addressType);
+        }
+
+        /**
+         * @brief See @ref LP50XX::SetLEDColor, the LED is checked against @ref LEDCount
+         */
+        LP50XX_ALWAYS_INLINE int8_t SetLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b, EAddressType addressType = EAddressType::Normal) {
+            LP50XX_CHECK_INDEX(led, LEDCount);
+            return LP50XX::SetLEDColor(led, r, g, b, addressType);
+        }
+
+        /**
+         * @brief See @ref LP50XX::StageLEDBrightness, the LED is checked against @ref LEDCount
+         */
+        LP50XX_ALWAYS_INLINE void StageLEDBrightness(uint8_t led, uint8_t brightness) {
+            LP50XX_CHECK_INDEX(led, LEDCount);
+            LP50XX::StageLEDBrightness(led, brightness);
+        }
+
+        /**
+         * @brief See @ref LP50XX::StageOutputColor, the output is checked against @ref OutputCount
+         */
+        LP50XX_ALWAYS_INLINE void StageOutputColor(uint8_t output, uint8_t value) {
+            LP50XX_CHECK_INDEX(output, OutputCount);
+            LP50XX::StageOutputColor(output, value);
+        }
+
+        /**
+         * @brief See @ref LP50XX::StageLEDColor, the LED is checked against @ref LEDCount
+         */
+        LP50XX_ALWAYS_INLINE void StageLEDColor(uint8_t led, uint8_t r, uint8_t g, uint8_t b) {
+            LP50XX_CHECK_INDEX(led, LEDCount);
+            LP50XX::StageLEDColor(led, r, g, b);
+        }
+};
+
+typedef LP50XXVariant<VariantLP5009> LP5009;
+typedef LP50XXVariant<VariantLP5012> LP5012;
+
+#endif
@@ -0,0 +1,335 @@
+/**
+ * @file LP50XX_Vcd.cpp
+ * @brief Contains the VCD recording transport, see @ref LP50XX_Vcd.h
+ */
+#ifndef ARDUINO
+
+#include "LP50XX_Vcd.h"
+#include "LP50XX_Platform.h"
+
+// VCD identifiers of the signals
+#define VCD_SCL '!'
+#define VCD_SDA '"'
+#define VCD_DATA '#'
+
+/**
+ * @brief Instantiates the transport, nothing is recorded until a file is opened or attached
+ *
+ * @param inner The transport that performs the transactions
+ */
+LP50XXVcdTransport::LP50XXVcdTransport(LP50XXTransport &inner) : _inner(inner) {
+
+}
+
+LP50XXVcdTransport::~LP50XXVcdTransport() {
+    Close();
+}
+
+/*----------------------- File functions ------------------------------------*/
+
+/**
+ * @brief Creates a dump file and starts recording
+ *
+ * @param path The path of the file, an existing file is overwritten
+ * @return true The file is open
+ * @return false The file could not be created
+ */
+bool LP50XXVcdTransport::Open(const char *path) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        return false;
+    }
+    Attach(out);
+    _owned = true;
+    return true;
+}
+
+/**
+ * @brief Starts recording to an open file, e.g. stdout. The file stays open on @ref Close
+ *
+ * @param out The file
+ */
+void LP50XXVcdTransport::Attach(FILE *out) {
+    Close();
+    _out = out;
+    _owned = false;
+    _origin_us = micros();
+    _now = 0;
+    _written = 0;
+    _scl = 1;
+    _sda = 1;
+
+    fprintf(_out, "$comment LP50XX bus at %lu Hz $end\n", (unsigned long)GetTiming().GetClock());
+    fprintf(_out, "$timescale 1ns $end\n$scope module i2c $end\n");
+    fprintf(_out, "$var wire 1 %c SCL $end\n$var wire 1 %c SDA $end\n$var wire 8 %c data $end\n", VCD_SCL, VCD_SDA, VCD_DATA);
+    fprintf(_out, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n1%c\n1%c\nbxxxxxxxx %c\n$end\n", VCD_SCL, VCD_SDA, VCD_DATA);
+}
+
+/**
+ * @brief Ends the dump with the end of the last transaction and stops recording
+ */
+void LP50XXVcdTransport::Close() {
+    if (_out == NULL) {
+        return;
+    }
+    timestamp(_now);
+    if (_owned) {
+        fclose(_out);
+    } else {
+        fflush(_out);
+    }
+    _out = NULL;
+}
+
+/**
+ * @brief Selects whether the idle time between the transactions follows the application
+ *
+ * @param enabled true to start every transaction at the time it is called, false to start it right after the previous one
+ */
+void LP50XXVcdTransport::SetRealTime(bool enabled) {
+    _real_time = enabled;
+}
+
+/**
+ * @brief Returns the end of the last transaction
+ *
+ * @return uint64_t The time in ns since the dump was started
+ */
+uint64_t LP50XXVcdTransport::GetTime() {
+    return _now;
+}
+
+/*----------------------- Transport functions -------------------------------*/
+
+/**
+ * @brief Writes consecutive registers through the inner transport and records the transaction
+ *
+ * @param deviceAddress The I2C address of the device
+ * @param registerAddress The first register to write
+ * @param pdata The register values
+ * @param count The number of register values
+ * @return int8_t The status of the inner transport
+ */
+int8_t LP50XXVcdTransport::Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count) {
+    uint64_t t = begin();
+    int8_t status = _inner.Write(deviceAddress, registerAddress, pdata, count);
+    if (_out == NULL) {
+        return status;
+    }
+
+    start(t);
+    byte(t, deviceAddress << 1, status == 2);
+    if (status == 0 || status == 3) {
+        byte(t, registerAddress, status == 3);
+    }
+    for (uint32_t i = 0; status == 0 && i < count; i++) {
+        byte(t, pdata[i], 0);
+    }
+    stop(t);
+    _now = t;
+    return status;
+}
+
+/**
+ * @brief Reads consecutive registers through the inner transport and records the transaction with its repeated start
+ *
+ * @param deviceAddress The I2C address of the device
+ * @param registerAddress The first register to read
+ * @param pdata The buffer for the register values
+ * @param count The number of registers to read
+ * @return int8_t The status of the inner transport
+ */
+int8_t LP50XXVcdTransport::Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    uint64_t t = begin();
+    int8_t status = _inner.Read(deviceAddress, registerAddress, pdata, count);
+    if (_out == NULL) {
+        return status;
+    }
+
+    start(t);
+    byte(t, deviceAddress << 1, status == 2);
+    if (status == 0) {
+        byte(t, registerAddress, 0);
+        restart(t);
+        byte(t, deviceAddress << 1 | 1, 0);
+        // The master acknowledges every byte but the last
+        for (uint32_t i = 0; i < count; i++) {
+            byte(t, pdata[i], i + 1 == count);
+        }
+    }
+    stop(t);
+    _now = t;
+    return status;
+}
+
+/**
+ * @brief Probes an address through the inner transport and records the address only write
+ *
+ * @param deviceAddress The I2C address to probe
+ * @return int8_t The status of the inner transport
+ */
+int8_t LP50XXVcdTransport::Probe(uint8_t deviceAddress) {
+    uint64_t t = begin();
+    int8_t status = _inner.Probe(deviceAddress);
+    if (_out == NULL) {
+        return status;
+    }
+
+    start(t);
+    byte(t, deviceAddress << 1, status != 0);
+    stop(t);
+    _now = t;
+    return status;
+}
+
+/**
+ * @brief Starts a batch on the inner transport
+ */
+void LP50XXVcdTransport::BeginBatch() {
+    _inner.BeginBatch();
+}
+
+/**
+ * @brief Ends a batch on the inner transport
+ *
+ * @return int8_t The status of the inner transport
+ */
+int8_t LP50XXVcdTransport::EndBatch() {
+    return _inner.EndBatch();
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Returns the start of the next transaction
+ *
+ * @return uint64_t The time in ns, not before the end of the previous transaction
+ */
+uint64_t LP50XXVcdTransport::begin() {
+    if (_real_time) {
+        uint64_t now = (uint64_t)(unsigned long)(micros() - _origin_us) * 1000;
+        if (now > _now) {
+            return now;
+        }
+    }
+    return _now;
+}
+
+/**
+ * @brief Draws a START, SDA falls while SCL is high
+ *
+ * @param t The start, advanced to the end of the condition
+ */
+void LP50XXVcdTransport::start(uint64_t &t) {
+    setLine(t, VCD_SDA, _sda, 0);
+    t += GetTiming().GetStartHoldTime();
+}
+
+/**
+ * @brief Draws a repeated START, half a clock low to release SDA, then SDA falls while SCL is high
+ *
+ * @param t The start, advanced to the end of the condition
+ */
+void LP50XXVcdTransport::restart(uint64_t &t) {
+    LP50XXBusTiming &timing = GetTiming();
+    uint32_t bit = timing.GetBitTime();
+
+    setLine(t, VCD_SCL, _scl, 0);
+    setLine(t + bit / 4, VCD_SDA, _sda, 1);
+    setLine(t + bit / 2, VCD_SCL, _scl, 1);
+    t += bit / 2 + timing.GetStartSetupTime();
+    setLine(t, VCD_SDA, _sda, 0);
+    t += timing.GetStartHoldTime();
+}
+
+/**
+ * @brief Draws a STOP, half a clock low to pull SDA low, then SDA rises while SCL is high, followed by the bus free time
+ *
+ * @param t The start, advanced to the end of the bus free time
+ */
+void LP50XXVcdTransport::stop(uint64_t &t) {
+    LP50XXBusTiming &timing = GetTiming();
+    uint32_t bit = timing.GetBitTime();
+
+    setLine(t, VCD_SCL, _scl, 0);
+    setData(t, -1);
+    setLine(t + bit / 4, VCD_SDA, _sda, 0);
+    setLine(t + bit / 2, VCD_SCL, _scl, 1);
+    t += bit / 2 + timing.GetStopSetupTime();
+    setLine(t, VCD_SDA, _sda, 1);
+    t += timing.GetBusFreeTime();
+}
+
+/**
+ * @brief Draws a byte and its acknowledge, every clock is low for the first and high for the second half.
+ * SDA changes in the middle of the low half
+ *
+ * @param t The start, advanced to the end of the byte
+ * @param value The byte
+ * @param ack The level of the acknowledge clock, 1 for a NACK
+ */
+void LP50XXVcdTransport::byte(uint64_t &t, uint8_t value, uint8_t ack) {
+    uint32_t bit = GetTiming().GetBitTime();
+
+    setData(t, value);
+    for (uint8_t i = 0; i < 9; i++) {
+        setLine(t, VCD_SCL, _scl, 0);
+        setLine(t + bit / 4, VCD_SDA, _sda, i < 8 ? value >> (7 - i) & 1 : ack);
+        setLine(t + bit / 2, VCD_SCL, _scl, 1);
+        t += bit;
+    }
+}
+
+/**
+ * @brief Writes a level change of SCL or SDA
+ *
+ * @param t The time of the change
+ * @param id The VCD identifier of the line
+ * @param line The current level, updated
+ * @param value The new level
+ */
+void LP50XXVcdTransport::setLine(uint64_t t, char id, uint8_t &line, uint8_t value) {
+    if (line == value) {
+        return;
+    }
+    line = value;
+    timestamp(t);
+    fprintf(_out, "%u%c\n", value, id);
+}
+
+/**
+ * @brief Writes the byte being transferred
+ *
+ * @param t The time of the change
+ * @param value The byte, -1 for none
+ */
+void LP50XXVcdTransport::setData(uint64_t t, int16_t value) {
+    timestamp(t);
+    if (value < 0) {
+        fprintf(_out, "bxxxxxxxx %c\n", VCD_DATA);
+        return;
+    }
+    char bits[9];
+    for (uint8_t i = 0; i < 8; i++) {
+        bits[i] = value >> (7 - i) & 1 ? '1' : '0';
+    }
+    bits[8] = 0;
+    fprintf(_out, "b%s %c\n", bits, VCD_DATA);
+}
+
+/**
+ * @brief Writes a timestamp when it differs from the last one
+ *
+ * @param t The time in ns
+ */
+void LP50XXVcdTransport::timestamp(uint64_t t) {
+    if (t == _written) {
+        return;
+    }
+    _written = t;
+    fprintf(_out, "#%llu\n", (unsigned long long)t);
+}
+
+#endif
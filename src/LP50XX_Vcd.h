@@ -0,0 +1,75 @@
+/**
+ * @file LP50XX_Vcd.h
+ * @brief Transport that records the bus traffic as a Value Change Dump of SDA and SCL for waveform viewers
+ *
+ * @ref LP50XXVcdTransport forwards every transaction to another transport, e.g. a simulated bus or an
+ * @ref LP50XXLinuxI2C, and synthesizes the SDA and SCL levels it would take on the wire from the bytes, the
+ * status and the @ref LP50XXBusTiming of the transport (see @ref LP50XXTransport::SetTiming). The dump is written
+ * while the application runs, so long benchmark runs only need disk space. Open it in e.g. GTKWave or PulseView:
+ * next to SCL and SDA it has the byte being transferred.
+ *
+ * @code
+ * LP50XXVcdTransport vcd(bus);
+ * vcd.Open("bus.vcd");
+ * device.SetTransport(&vcd);
+ * @endcode
+ *
+ * By default the transactions follow each other with only the bus free time in between, the dump shows the
+ * shortest possible frame. With @ref LP50XXVcdTransport::SetRealTime the idle time between the calls of the
+ * application is kept, which shows the gaps between bursts. An address that is not acknowledged ends the
+ * transaction with a STOP, a write with status 3 ends after the register address. Writes queued in a batch
+ * are drawn when they are queued, as acknowledged.
+ */
+#ifndef __LP50XX_VCD_H
+#define __LP50XX_VCD_H
+
+#include <stdint.h>
+#include "LP50XX_Transport.h"
+
+#ifndef ARDUINO
+#include <stdio.h>
+
+/**
+ * @brief Transport that forwards to another transport and writes the wire levels to a VCD file
+ */
+class LP50XXVcdTransport : public LP50XXTransport
+{
+    public:
+        LP50XXVcdTransport(LP50XXTransport &inner);
+        ~LP50XXVcdTransport();
+
+        bool Open(const char *path);
+        void Attach(FILE *out);
+        void Close();
+        void SetRealTime(bool enabled);
+        uint64_t GetTime();
+
+        int8_t Write(uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pdata, uint32_t count);
+        int8_t Read(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count);
+        int8_t Probe(uint8_t deviceAddress);
+        void BeginBatch();
+        int8_t EndBatch();
+
+    private:
+        LP50XXTransport    &_inner;
+        FILE               *_out = NULL;
+        bool                _owned = false;     // The file was opened by Open() and is closed by Close()
+        bool                _real_time = false;
+        unsigned long       _origin_us = 0;
+        uint64_t            _now = 0;           // End of the last transaction in ns since the start of the dump
+        uint64_t            _written = 0;       // Last timestamp in the file
+        uint8_t             _scl = 1;
+        uint8_t             _sda = 1;
+
+        uint64_t begin();
+        void start(uint64_t &t);
+        void restart(uint64_t &t);
+        void stop(uint64_t &t);
+        void byte(uint64_t &t, uint8_t value, uint8_t ack);
+        void setLine(uint64_t t, char id, uint8_t &line, uint8_t value);
+        void setData(uint64_t t, int16_t value);
+        void timestamp(uint64_t t);
+};
+
+#endif
+#endif
@@ -0,0 +1,244 @@
+/**
+ * @file LP50XX_Verifier.cpp
+ * @brief Sampled read-back of the devices, see @ref LP50XX_Verifier.h
+ */
+#include "LP50XX_Verifier.h"
+#include <string.h>
+
+/**
+ * @brief Instantiates a verifier without devices
+ *
+ * @param burst The registers per read, 1..@ref LP50XX_VERIFIER_BURST
+ * @param period The frames per read, 0 is handled like 1
+ * @param share The share of the bus time the reads may take in percent, 0 for no limit
+ */
+LP50XXVerifier::LP50XXVerifier(uint8_t burst, uint16_t period, uint8_t share) {
+    SetBurst(burst);
+    SetPeriod(period);
+    SetShare(share);
+    ResetStats();
+}
+
+/**
+ * @brief Adds a device, its registers are read after the registers of the devices added before
+ *
+ * @param device The device, its transport has to be set already
+ * @return true when the device was added, false when the verifier is full
+ */
+bool LP50XXVerifier::Add(LP50XX &device) {
+    if (_device_count == LP50XX_VERIFIER_MAX_DEVICES) {
+        return false;
+    }
+    _devices[_device_count] = &device;
+    _mismatches[_device_count] = 0;
+    _device_count++;
+    return true;
+}
+
+/*----------------------- Configuration functions ---------------------------*/
+
+/**
+ * @brief Sets the registers per read. Devices without auto increment are read one register at a time
+ *
+ * @param registers The registers, limited to 1..@ref LP50XX_VERIFIER_BURST
+ */
+void LP50XXVerifier::SetBurst(uint8_t registers) {
+    if (registers == 0) {
+        registers = 1;
+    }
+    _burst = registers < LP50XX_VERIFIER_BURST ? registers : LP50XX_VERIFIER_BURST;
+}
+
+/**
+ * @brief Returns the registers per read
+ *
+ * @return uint8_t
+ */
+uint8_t LP50XXVerifier::GetBurst() {
+    return _burst;
+}
+
+/**
+ * @brief Sets the frames per read
+ *
+ * @param frames The calls of @ref Verify per read, 0 is handled like 1
+ */
+void LP50XXVerifier::SetPeriod(uint16_t frames) {
+    _period = frames != 0 ? frames : 1;
+}
+
+/**
+ * @brief Returns the frames per read
+ *
+ * @return uint16_t
+ */
+uint16_t LP50XXVerifier::GetPeriod() {
+    return _period;
+}
+
+/**
+ * @brief Sets the share of the bus time the reads may take
+ *
+ * @param percent The share in percent, 0 for no limit
+ */
+void LP50XXVerifier::SetShare(uint8_t percent) {
+    _share = percent < 100 ? percent : 100;
+}
+
+/**
+ * @brief Returns the share of the bus time the reads may take
+ *
+ * @return uint8_t The share in percent, 0 for no limit
+ */
+uint8_t LP50XXVerifier::GetShare() {
+    return _share;
+}
+
+/*----------------------- Verification functions ----------------------------*/
+
+/**
+ * @brief Counts a frame and reads the next registers when the period is over and the share of the bus covers
+ * the read. Registers that differ from the clean shadow image are marked dirty for the next @ref LP50XX::Flush.
+ * Call it once per frame, after the flush
+ *
+ * @return int8_t 0 when nothing was read or the read succeeded, otherwise the status of the read
+ */
+int8_t LP50XXVerifier::Verify() {
+    if (_device_count == 0) {
+        return 0;
+    }
+    accrue();
+    if (_frames < _period) {
+        _frames++;
+    }
+    if (_frames < _period) {
+        return 0;
+    }
+
+    LP50XX &device = *_devices[_device];
+    uint8_t end = device.registerEnd();
+    if (_reg >= end) {
+        _reg = 0;
+    }
+
+    // Without auto increment a burst would read the same register again
+    uint8_t count = end - _reg < _burst ? end - _reg : _burst;
+    if (!device.autoIncrement()) {
+        count = 1;
+    }
+
+    LP50XXTransport *transport = device.GetTransport();
+    uint32_t timeNs = (transport != NULL ? transport->GetTiming() : LP50XXBusTiming::Default()).GetReadTime(count);
+    if (_share != 0 && _credit_ns < timeNs) {
+        _stats.deferred++;
+        return 0;
+    }
+    _credit_ns = _share != 0 ? _credit_ns - timeNs : 0;
+    _frames = 0;
+
+    uint8_t values[LP50XX_VERIFIER_BURST];
+    int8_t status = device.busRead(device._i2c_address, _reg, values, count);
+    _stats.reads++;
+    _stats.busTimeUs += timeNs / 1000;
+    if (status == 0) {
+        _mismatches[_device] += compare(device, _reg, values, count);
+    } else {
+        _stats.failures++;
+    }
+
+    _reg += count;
+    if (_reg >= end) {
+        _reg = 0;
+        _device = _device + 1 < _device_count ? _device + 1 : 0;
+    }
+    return status;
+}
+
+/*----------------------- Statistic functions -------------------------------*/
+
+/**
+ * @brief Copies the counters of all devices
+ *
+ * @param stats The buffer for the counters
+ */
+void LP50XXVerifier::GetStats(LP50XXVerifierStats *stats) {
+    *stats = _stats;
+}
+
+/**
+ * @brief Returns the registers of a device that differed from its shadow image
+ *
+ * @param index The index of the device in the order it was added
+ * @return uint32_t The mismatches since construction or @ref ResetStats, 0 for an unknown index
+ */
+uint32_t LP50XXVerifier::GetMismatches(uint8_t index) {
+    return index < _device_count ? _mismatches[index] : 0;
+}
+
+/**
+ * @brief Resets the counters of all devices
+ */
+void LP50XXVerifier::ResetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+    memset(_mismatches, 0, sizeof(_mismatches));
+}
+
+/*
+ *  PRIVATE
+ */
+
+/**
+ * @brief Adds the share of the time since the last call to the credit of the reads. The credit is limited to
+ * one read, so reads cannot pile up while the verifier is not called
+ */
+void LP50XXVerifier::accrue() {
+    unsigned long now = micros();
+    uint32_t elapsedUs = now - _last_us;
+    _last_us = now;
+    if (elapsedUs > 1000000UL) {
+        elapsedUs = 1000000UL;
+    }
+
+    LP50XXTransport *transport = _devices[0]->GetTransport();
+    uint32_t limitNs = (transport != NULL ? transport->GetTiming() : LP50XXBusTiming::Default()).GetReadTime(_burst);
+    _credit_ns += elapsedUs * _share * 10;
+    if (_credit_ns > limitNs) {
+        _credit_ns = limitNs;
+    }
+}
+
+/**
+ * @brief Compares read registers with the shadow image of a device and marks the differing ones dirty.
+ * Dirty registers are skipped, their new value is not written yet
+ *
+ * @param device The device
+ * @param reg The first read register
+ * @param values The read values
+ * @param count The number of read registers
+ * @return uint8_t The number of differing registers
+ */
+uint8_t LP50XXVerifier::compare(LP50XX &device, uint8_t reg, const uint8_t *values, uint8_t count) {
+    uint32_t clean = device.registerMask() & ~device._dirty;
+    uint8_t mismatches = 0;
+    bool resync = false;
+
+    for (uint8_t i = 0; i < count; i++, reg++) {
+        if (!(clean >> reg & 1)) {
+            continue;
+        }
+        _stats.registers++;
+        if (values[i] != device._registers[reg]) {
+            device._dirty |= 1UL << reg;
+            mismatches++;
+            // A reset device or one without auto increment has lost the other registers as well
+            resync |= reg == DEVICE_CONFIG0 || reg == DEVICE_CONFIG1;
+        }
+    }
+
+    if (resync) {
+        device._dirty = device.registerMask();
+        _stats.resyncs++;
+    }
+    _stats.mismatches += mismatches;
+    return mismatches;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file LP50XX_Verifier.h
+ * @brief Sampled read-back of the devices to detect registers that diverged from the shadow image
+ *
+ * A brownout or EMI can change the registers of a device without the driver noticing. Reading every register
+ * back every frame costs more bus time than the frame itself, so @ref LP50XXVerifier::Verify reads one burst of
+ * registers every N frames instead, rotating through the register map of every device. Registers that differ
+ * from the clean shadow image are marked dirty and written again by the next @ref LP50XX::Flush. A diverged
+ * DEVICE_CONFIG0 or DEVICE_CONFIG1 means the device was reset or no longer auto increments, so its whole shadow
+ * image is written again.
+ *
+ * Besides the period the reads are limited to a share of the bus time: every read is charged with its wire time
+ * (see @ref LP50XXBusTiming) and only made when the share of the time since the last read covers it. A read
+ * that does not fit is postponed to a later frame, the verifier never takes more than its share of the bus.
+ *
+ * @code
+ * LP50XXVerifier verifier(16, 10, 2);   // 16 registers every 10 frames, at most 2 % of the bus time
+ * verifier.Add(device);
+ * verifier.Add(device2);
+ *
+ * void loop() {
+ *     ...
+ *     device.Flush();
+ *     device2.Flush();
+ *     verifier.Verify();
+ * }
+ * @endcode
+ *
+ * @note The share is accounted for the bus of the first device. With devices on several buses every bus uses
+ * at most that share.
+ */
+#ifndef __LP50XX_VERIFIER_H
+#define __LP50XX_VERIFIER_H
+
+#include "LP50XX.h"
+
+#ifndef LP50XX_VERIFIER_MAX_DEVICES
+#define LP50XX_VERIFIER_MAX_DEVICES 8
+#endif
+#define LP50XX_VERIFIER_BURST 16            // Registers per read, the Wire buffer of AVR holds 32 bytes
+#define LP50XX_VERIFIER_PERIOD 10           // Frames per read
+#define LP50XX_VERIFIER_SHARE 2             // Percent of the bus time
+
+/**
+ * @brief Counters of the verifier
+ */
+struct LP50XXVerifierStats {
+    uint32_t reads;             // Burst reads made
+    uint32_t registers;         // Registers compared with the shadow image
+    uint32_t mismatches;        // Registers that differed from the shadow image and were scheduled again
+    uint32_t resyncs;           // Devices whose whole shadow image was scheduled again
+    uint32_t failures;          // Reads that failed
+    uint32_t deferred;          // Frames a due read was postponed because the share of the bus was used up
+    uint32_t busTimeUs;         // Estimated wire time of all reads
+};
+
+/**
+ * @brief Sampled verifier of the shadow images of several devices
+ */
+class LP50XXVerifier
+{
+    public:
+        LP50XXVerifier(uint8_t burst = LP50XX_VERIFIER_BURST, uint16_t period = LP50XX_VERIFIER_PERIOD, uint8_t share = LP50XX_VERIFIER_SHARE);
+
+        bool Add(LP50XX &device);
+
+        void SetBurst(uint8_t registers);
+        uint8_t GetBurst();
+        void SetPeriod(uint16_t frames);
+        uint16_t GetPeriod();
+        void SetShare(uint8_t percent);
+        uint8_t GetShare();
+
+        int8_t Verify();
+
+        void GetStats(LP50XXVerifierStats *stats);
+        uint32_t GetMismatches(uint8_t index);
+        void ResetStats();
+
+    private:
+        LP50XX     *_devices[LP50XX_VERIFIER_MAX_DEVICES];
+        uint32_t    _mismatches[LP50XX_VERIFIER_MAX_DEVICES];
+        uint8_t     _device_count = 0;
+
+        uint8_t     _burst;
+        uint16_t    _period;
+        uint8_t     _share;             // Percent, 0 for no limit
+
+        uint8_t     _device = 0;        // Device of the next read
+        uint8_t     _reg = 0;           // First register of the next read
+        uint16_t    _frames = 0;        // Frames since the last read
+        uint32_t    _credit_ns = 0;     // Share of the bus time since the last read
+        unsigned long _last_us = 0;
+
+        LP50XXVerifierStats _stats;
+
+        void accrue();
+        uint8_t compare(LP50XX &device, uint8_t reg, const uint8_t *values, uint8_t count);
+};
+
+#endif